@@ -0,0 +1,205 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "sd-journal.h"
+#include "sd-messages.h"
+
+#include "alloc-util.h"
+#include "analyze.h"
+#include "analyze-critical-flame.h"
+#include "analyze-time-data.h"
+#include "bus-error.h"
+#include "hashmap.h"
+#include "parse-util.h"
+#include "string-util.h"
+
+/* Per-unit sums of the spawn timing records the service manager logs when $SYSTEMD_EXEC_TIMING is set */
+typedef struct SpawnTimes {
+        usec_t cgroup;
+        usec_t namespc;
+        usec_t seccomp;
+        usec_t total;
+} SpawnTimes;
+
+DEFINE_PRIVATE_HASH_OPS_FULL(spawn_times_hash_ops, char, string_hash_func, string_compare_func, free, SpawnTimes, free);
+
+static int get_string_field(sd_journal *j, const char *field, char **ret) {
+        const void *data;
+        size_t size, fl;
+        char *v;
+        int r;
+
+        assert(j);
+        assert(field);
+        assert(ret);
+
+        r = sd_journal_get_data(j, field, &data, &size);
+        if (r < 0)
+                return r;
+
+        fl = strlen(field) + 1; /* Also skip over the "=" */
+        if (size < fl)
+                return -EINVAL;
+
+        v = strndup((const char*) data + fl, size - fl);
+        if (!v)
+                return -ENOMEM;
+
+        *ret = v;
+        return 0;
+}
+
+static int get_usec_field(sd_journal *j, const char *field, usec_t *ret) {
+        _cleanup_free_ char *v = NULL;
+        int r;
+
+        r = get_string_field(j, field, &v);
+        if (r < 0)
+                return r;
+
+        return safe_atou64(v, ret);
+}
+
+static int acquire_spawn_times(Hashmap **ret) {
+        _cleanup_(sd_journal_closep) sd_journal *j = NULL;
+        _cleanup_hashmap_free_ Hashmap *h = NULL;
+        int r;
+
+        assert(ret);
+
+        r = sd_journal_open(&j, SD_JOURNAL_LOCAL_ONLY);
+        if (r < 0)
+                return r;
+
+        r = sd_journal_add_match(j, "MESSAGE_ID=" SD_MESSAGE_UNIT_EXEC_TIMING_STR, 0);
+        if (r < 0)
+                return r;
+
+        SD_JOURNAL_FOREACH(j) {
+                _cleanup_free_ char *unit = NULL;
+                usec_t cgroup = 0, namespc = 0, seccomp = 0, total = 0;
+                SpawnTimes *st;
+
+                (void) get_string_field(j, "_SYSTEMD_UNIT", &unit);
+                if (!unit)
+                        (void) get_string_field(j, "UNIT", &unit);
+                if (!unit)
+                        continue;
+
+                if (get_usec_field(j, "EXEC_TIMING_TOTAL_USEC", &total) < 0)
+                        continue;
+
+                (void) get_usec_field(j, "EXEC_TIMING_CGROUP_USEC", &cgroup);
+                (void) get_usec_field(j, "EXEC_TIMING_NAMESPACE_USEC", &namespc);
+                (void) get_usec_field(j, "EXEC_TIMING_SECCOMP_USEC", &seccomp);
+
+                st = hashmap_get(h, unit);
+                if (!st) {
+                        st = new0(SpawnTimes, 1);
+                        if (!st)
+                                return -ENOMEM;
+
+                        r = hashmap_ensure_put(&h, &spawn_times_hash_ops, unit, st);
+                        if (r < 0) {
+                                free(st);
+                                return r;
+                        }
+                        TAKE_PTR(unit);
+                }
+
+                st->cgroup += cgroup;
+                st->namespc += namespc;
+                st->seccomp += seccomp;
+                st->total += total;
+        }
+
+        *ret = TAKE_PTR(h);
+        return 0;
+}
+
+static void print_folded(const char *stack, usec_t v) {
+        if (v > 0)
+                printf("%s " USEC_FMT "\n", stack, v);
+}
+
+static void print_folded2(const char *stack, const char *frame, usec_t v) {
+        if (v > 0)
+                printf("%s;%s " USEC_FMT "\n", stack, frame, v);
+}
+
+int verb_critical_flame(int argc, char *argv[], void *userdata) {
+        _cleanup_(sd_bus_flush_close_unrefp) sd_bus *bus = NULL;
+        _cleanup_(unit_times_free_arrayp) UnitTimes *times = NULL;
+        _cleanup_hashmap_free_ Hashmap *spawn = NULL;
+        BootTimes *boot;
+        int n, r;
+
+        /* Emits the boot timeline as folded stacks, one semicolon-separated stack with its width in
+         * microseconds per line, ready to be piped into flamegraph.pl and friends. Units activate
+         * concurrently, so their frames are siblings below "userspace" and may add up to more than the
+         * wall-clock width of the boot — same as the output of "systemd-analyze blame". */
+
+        r = acquire_bus(&bus, NULL);
+        if (r < 0)
+                return bus_log_connect_error(r, arg_transport);
+
+        r = acquire_boot_times(bus, &boot);
+        if (r < 0)
+                return r;
+
+        n = acquire_time_data(bus, &times);
+        if (n <= 0)
+                return n;
+
+        r = acquire_spawn_times(&spawn);
+        if (r < 0)
+                log_debug_errno(r, "No spawn timing records available, ignoring: %m");
+
+        pager_open(arg_pager_flags);
+
+        if (boot->firmware_time > boot->loader_time)
+                print_folded("firmware", boot->firmware_time - boot->loader_time);
+        print_folded("loader", boot->loader_time);
+        print_folded("kernel", boot->kernel_done_time);
+
+        if (boot->initrd_time > 0) {
+                print_folded("initrd", LESS_BY(boot->userspace_time, boot->initrd_time));
+                print_folded("initrd;security-module-setup",
+                             LESS_BY(boot->initrd_security_finish_time, boot->initrd_security_start_time));
+                print_folded("initrd;generators",
+                             LESS_BY(boot->initrd_generators_finish_time, boot->initrd_generators_start_time));
+                print_folded("initrd;loading-units",
+                             LESS_BY(boot->initrd_unitsload_finish_time, boot->initrd_unitsload_start_time));
+        }
+
+        print_folded("userspace;security-module-setup",
+                     LESS_BY(boot->security_finish_time, boot->security_start_time));
+        print_folded("userspace;generators",
+                     LESS_BY(boot->generators_finish_time, boot->generators_start_time));
+        print_folded("userspace;loading-units",
+                     LESS_BY(boot->unitsload_finish_time, boot->unitsload_start_time));
+
+        for (UnitTimes *u = times; u->has_data; u++) {
+                _cleanup_free_ char *stack = NULL;
+                SpawnTimes *st;
+
+                /* Leave out units that only became active after boot was finished */
+                if (u->activating == 0 || u->activating > boot->finish_time)
+                        continue;
+
+                st = hashmap_get(spawn, u->name);
+
+                stack = strjoin("userspace;", u->name);
+                if (!stack)
+                        return log_oom();
+
+                print_folded(stack, LESS_BY(u->time, st ? st->total : 0));
+                if (st) {
+                        print_folded2(stack, "spawn", LESS_BY(st->total, st->cgroup + st->namespc + st->seccomp));
+                        print_folded2(stack, "spawn;cgroup", st->cgroup);
+                        print_folded2(stack, "spawn;namespace", st->namespc);
+                        print_folded2(stack, "spawn;seccomp", st->seccomp);
+                }
+        }
+
+        return 0;
+}
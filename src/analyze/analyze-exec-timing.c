@@ -0,0 +1,134 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "sd-journal.h"
+#include "sd-messages.h"
+
+#include "analyze.h"
+#include "analyze-exec-timing.h"
+#include "format-table.h"
+#include "logs-show.h"
+#include "parse-util.h"
+#include "string-util.h"
+#include "strv.h"
+
+static int get_string_field(sd_journal *j, const char *field, char **ret) {
+        const void *data;
+        size_t size, fl;
+        char *v;
+        int r;
+
+        assert(j);
+        assert(field);
+        assert(ret);
+
+        r = sd_journal_get_data(j, field, &data, &size);
+        if (r < 0)
+                return r;
+
+        fl = strlen(field) + 1; /* Also skip over the "=" */
+        if (size < fl)
+                return -EINVAL;
+
+        v = strndup((const char*) data + fl, size - fl);
+        if (!v)
+                return -ENOMEM;
+
+        *ret = v;
+        return 0;
+}
+
+static int get_usec_field(sd_journal *j, const char *field, usec_t *ret) {
+        _cleanup_free_ char *v = NULL;
+        int r;
+
+        assert(j);
+        assert(field);
+        assert(ret);
+
+        r = get_string_field(j, field, &v);
+        if (r < 0)
+                return r;
+
+        return safe_atou64(v, ret);
+}
+
+int verb_exec_timing(int argc, char *argv[], void *userdata) {
+        _cleanup_(sd_journal_closep) sd_journal *j = NULL;
+        _cleanup_(table_unrefp) Table *table = NULL;
+        char **units = strv_skip(argv, 1), **u;
+        int r;
+
+        /* Collects the spawn timing records the service manager logs when $SYSTEMD_EXEC_TIMING is
+         * set, and presents the per-phase breakdown of the time spent between fork() and execve(). */
+
+        r = sd_journal_open(&j, SD_JOURNAL_LOCAL_ONLY);
+        if (r < 0)
+                return log_error_errno(r, "Failed to open journal: %m");
+
+        STRV_FOREACH(u, units) {
+                if (arg_scope == UNIT_FILE_USER)
+                        r = add_matches_for_user_unit(j, *u, getuid());
+                else
+                        r = add_matches_for_unit(j, *u);
+                if (r < 0)
+                        return log_error_errno(r, "Failed to add unit match for %s: %m", *u);
+        }
+
+        if (!strv_isempty(units)) {
+                r = sd_journal_add_conjunction(j);
+                if (r < 0)
+                        return log_error_errno(r, "Failed to add conjunction to journal matches: %m");
+        }
+
+        r = sd_journal_add_match(j, "MESSAGE_ID=" SD_MESSAGE_UNIT_EXEC_TIMING_STR, 0);
+        if (r < 0)
+                return log_error_errno(r, "Failed to add journal match: %m");
+
+        table = table_new("time", "unit", "executable", "cgroup", "namespace", "seccomp", "total");
+        if (!table)
+                return log_oom();
+
+        SD_JOURNAL_FOREACH(j) {
+                _cleanup_free_ char *unit = NULL, *executable = NULL;
+                usec_t realtime, cgroup = 0, namespc = 0, seccomp = 0, total = 0;
+
+                r = sd_journal_get_realtime_usec(j, &realtime);
+                if (r < 0)
+                        return log_error_errno(r, "Failed to acquire journal entry timestamp: %m");
+
+                (void) get_string_field(j, "_SYSTEMD_UNIT", &unit);
+                if (!unit) /* If the child died before it could move into its cgroup, fall back to
+                            * the field the service manager attaches explicitly */
+                        (void) get_string_field(j, "UNIT", &unit);
+                (void) get_string_field(j, "EXECUTABLE", &executable);
+
+                (void) get_usec_field(j, "EXEC_TIMING_CGROUP_USEC", &cgroup);
+                (void) get_usec_field(j, "EXEC_TIMING_NAMESPACE_USEC", &namespc);
+                (void) get_usec_field(j, "EXEC_TIMING_SECCOMP_USEC", &seccomp);
+                r = get_usec_field(j, "EXEC_TIMING_TOTAL_USEC", &total);
+                if (r < 0) {
+                        log_debug_errno(r, "Journal entry lacks timing data, skipping: %m");
+                        continue;
+                }
+
+                r = table_add_many(table,
+                                   TABLE_TIMESTAMP, realtime,
+                                   TABLE_STRING, strna(unit),
+                                   TABLE_STRING, strna(executable),
+                                   TABLE_TIMESPAN_MSEC, cgroup,
+                                   TABLE_TIMESPAN_MSEC, namespc,
+                                   TABLE_TIMESPAN_MSEC, seccomp,
+                                   TABLE_TIMESPAN_MSEC, total);
+                if (r < 0)
+                        return table_log_add_error(r);
+        }
+
+        if (table_get_rows(table) <= 1)
+                return log_error_errno(SYNTHETIC_ERRNO(ENODATA),
+                                       "No spawn timing records found in the journal. Set $SYSTEMD_EXEC_TIMING=1 "
+                                       "in the environment of the service manager to collect them.");
+
+        pager_open(arg_pager_flags);
+
+        return table_print(table, NULL);
+}
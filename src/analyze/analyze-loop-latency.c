@@ -0,0 +1,77 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "analyze.h"
+#include "analyze-loop-latency.h"
+#include "bus-error.h"
+#include "bus-locator.h"
+#include "format-table.h"
+#include "time-util.h"
+
+int verb_loop_latency(int argc, char *argv[], void *userdata) {
+        _cleanup_(sd_bus_flush_close_unrefp) sd_bus *bus = NULL;
+        _cleanup_(sd_bus_error_free) sd_bus_error error = SD_BUS_ERROR_NULL;
+        _cleanup_(sd_bus_message_unrefp) sd_bus_message *reply = NULL;
+        _cleanup_(table_unrefp) Table *table = NULL;
+        const uint64_t *histogram;
+        uint64_t max_usec = 0;
+        size_t sz, n_buckets, n;
+        int r;
+
+        r = acquire_bus(&bus, NULL);
+        if (r < 0)
+                return bus_log_connect_error(r, arg_transport);
+
+        r = bus_get_property(bus, bus_systemd_mgr, "DispatchLatencyHistogram", &error, &reply, "at");
+        if (r < 0)
+                return log_error_errno(r, "Failed to get dispatch latency histogram: %s",
+                                       bus_error_message(&error, r));
+
+        r = sd_bus_message_read_array(reply, 't', (const void**) &histogram, &sz);
+        if (r < 0)
+                return bus_log_parse_error(r);
+
+        r = bus_get_property_trivial(bus, bus_systemd_mgr, "DispatchLatencyMaxUSec", &error, 't', &max_usec);
+        if (r < 0)
+                return log_error_errno(r, "Failed to get maximum dispatch latency: %s",
+                                       bus_error_message(&error, r));
+
+        n_buckets = sz / sizeof(uint64_t);
+        if (n_buckets == 0)
+                return log_error_errno(SYNTHETIC_ERRNO(EBADMSG), "Got empty dispatch latency histogram.");
+
+        /* Buckets are powers of two of µs, bucket i counting dispatches that took [2^i, 2^(i+1)) µs, the
+         * last bucket also everything above. Drop trailing empty buckets, they carry no information. */
+        n = n_buckets;
+        while (n > 1 && histogram[n-1] == 0)
+                n--;
+
+        table = table_new("latency", "dispatches");
+        if (!table)
+                return log_oom();
+
+        for (size_t i = 0; i < n; i++) {
+                _cleanup_free_ char *label = NULL;
+
+                if (i >= n_buckets - 1) /* the overflow bucket is unbounded above */
+                        label = strjoin(">= ", FORMAT_TIMESPAN(UINT64_C(1) << i, 0));
+                else
+                        label = strjoin("< ", FORMAT_TIMESPAN(UINT64_C(1) << (i + 1), 0));
+                if (!label)
+                        return log_oom();
+
+                r = table_add_many(table,
+                                   TABLE_STRING, label,
+                                   TABLE_UINT64, histogram[i]);
+                if (r < 0)
+                        return table_log_add_error(r);
+        }
+
+        pager_open(arg_pager_flags);
+
+        r = table_print(table, NULL);
+        if (r < 0)
+                return r;
+
+        printf("\nMaximum dispatch latency: %s\n", FORMAT_TIMESPAN(max_usec, USEC_PER_MSEC));
+        return 0;
+}
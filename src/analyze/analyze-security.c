@@ -2287,84 +2287,60 @@ static int property_read_device_allow(
         return sd_bus_message_exit_container(m);
 }
 
-static int acquire_security_info(sd_bus *bus, const char *name, SecurityInfo *info, AnalyzeSecurityFlags flags) {
-
-        static const struct bus_properties_map security_map[] = {
-                { "AmbientCapabilities",     "t",       NULL,                                    offsetof(SecurityInfo, ambient_capabilities)      },
-                { "CapabilityBoundingSet",   "t",       NULL,                                    offsetof(SecurityInfo, capability_bounding_set)   },
-                { "DefaultDependencies",     "b",       NULL,                                    offsetof(SecurityInfo, default_dependencies)      },
-                { "Delegate",                "b",       NULL,                                    offsetof(SecurityInfo, delegate)                  },
-                { "DeviceAllow",             "a(ss)",   property_read_device_allow,              0                                                 },
-                { "DevicePolicy",            "s",       NULL,                                    offsetof(SecurityInfo, device_policy)             },
-                { "DynamicUser",             "b",       NULL,                                    offsetof(SecurityInfo, dynamic_user)              },
-                { "FragmentPath",            "s",       NULL,                                    offsetof(SecurityInfo, fragment_path)             },
-                { "IPAddressAllow",          "a(iayu)", property_read_ip_address_allow,          0                                                 },
-                { "IPAddressDeny",           "a(iayu)", property_read_ip_address_allow,          0                                                 },
-                { "IPIngressFilterPath",     "as",      property_read_ip_filters,                0                                                 },
-                { "IPEgressFilterPath",      "as",      property_read_ip_filters,                0                                                 },
-                { "Id",                      "s",       NULL,                                    offsetof(SecurityInfo, id)                        },
-                { "KeyringMode",             "s",       NULL,                                    offsetof(SecurityInfo, keyring_mode)              },
-                { "ProtectProc",             "s",       NULL,                                    offsetof(SecurityInfo, protect_proc)              },
-                { "ProcSubset",              "s",       NULL,                                    offsetof(SecurityInfo, proc_subset)               },
-                { "LoadState",               "s",       NULL,                                    offsetof(SecurityInfo, load_state)                },
-                { "LockPersonality",         "b",       NULL,                                    offsetof(SecurityInfo, lock_personality)          },
-                { "MemoryDenyWriteExecute",  "b",       NULL,                                    offsetof(SecurityInfo, memory_deny_write_execute) },
-                { "NoNewPrivileges",         "b",       NULL,                                    offsetof(SecurityInfo, no_new_privileges)         },
-                { "NotifyAccess",            "s",       NULL,                                    offsetof(SecurityInfo, notify_access)             },
-                { "PrivateDevices",          "b",       NULL,                                    offsetof(SecurityInfo, private_devices)           },
-                { "PrivateMounts",           "b",       NULL,                                    offsetof(SecurityInfo, private_mounts)            },
-                { "PrivateNetwork",          "b",       NULL,                                    offsetof(SecurityInfo, private_network)           },
-                { "PrivateTmp",              "b",       NULL,                                    offsetof(SecurityInfo, private_tmp)               },
-                { "PrivateUsers",            "b",       NULL,                                    offsetof(SecurityInfo, private_users)             },
-                { "ProtectControlGroups",    "b",       NULL,                                    offsetof(SecurityInfo, protect_control_groups)    },
-                { "ProtectHome",             "s",       NULL,                                    offsetof(SecurityInfo, protect_home)              },
-                { "ProtectHostname",         "b",       NULL,                                    offsetof(SecurityInfo, protect_hostname)          },
-                { "ProtectKernelModules",    "b",       NULL,                                    offsetof(SecurityInfo, protect_kernel_modules)    },
-                { "ProtectKernelTunables",   "b",       NULL,                                    offsetof(SecurityInfo, protect_kernel_tunables)   },
-                { "ProtectKernelLogs",       "b",       NULL,                                    offsetof(SecurityInfo, protect_kernel_logs)       },
-                { "ProtectClock",            "b",       NULL,                                    offsetof(SecurityInfo, protect_clock)             },
-                { "ProtectSystem",           "s",       NULL,                                    offsetof(SecurityInfo, protect_system)            },
-                { "RemoveIPC",               "b",       NULL,                                    offsetof(SecurityInfo, remove_ipc)                },
-                { "RestrictAddressFamilies", "(bas)",   property_read_restrict_address_families, 0                                                 },
-                { "RestrictNamespaces",      "t",       property_read_restrict_namespaces,       0                                                 },
-                { "RestrictRealtime",        "b",       NULL,                                    offsetof(SecurityInfo, restrict_realtime)         },
-                { "RestrictSUIDSGID",        "b",       NULL,                                    offsetof(SecurityInfo, restrict_suid_sgid)        },
-                { "RootDirectory",           "s",       NULL,                                    offsetof(SecurityInfo, root_directory)            },
-                { "RootImage",               "s",       NULL,                                    offsetof(SecurityInfo, root_image)                },
-                { "SupplementaryGroups",     "as",      NULL,                                    offsetof(SecurityInfo, supplementary_groups)      },
-                { "SystemCallArchitectures", "as",      property_read_syscall_archs,             0                                                 },
-                { "SystemCallFilter",        "(as)",    property_read_system_call_filter,        0                                                 },
-                { "Type",                    "s",       NULL,                                    offsetof(SecurityInfo, type)                      },
-                { "UMask",                   "u",       property_read_umask,                     0                                                 },
-                { "User",                    "s",       NULL,                                    offsetof(SecurityInfo, user)                      },
-                {}
-        };
-
-        _cleanup_(sd_bus_error_free) sd_bus_error error = SD_BUS_ERROR_NULL;
-        _cleanup_free_ char *path = NULL;
-        int r;
-
-        /* Note: this mangles *info on failure! */
+static const struct bus_properties_map security_map[] = {
+        { "AmbientCapabilities",     "t",       NULL,                                    offsetof(SecurityInfo, ambient_capabilities)      },
+        { "CapabilityBoundingSet",   "t",       NULL,                                    offsetof(SecurityInfo, capability_bounding_set)   },
+        { "DefaultDependencies",     "b",       NULL,                                    offsetof(SecurityInfo, default_dependencies)      },
+        { "Delegate",                "b",       NULL,                                    offsetof(SecurityInfo, delegate)                  },
+        { "DeviceAllow",             "a(ss)",   property_read_device_allow,              0                                                 },
+        { "DevicePolicy",            "s",       NULL,                                    offsetof(SecurityInfo, device_policy)             },
+        { "DynamicUser",             "b",       NULL,                                    offsetof(SecurityInfo, dynamic_user)              },
+        { "FragmentPath",            "s",       NULL,                                    offsetof(SecurityInfo, fragment_path)             },
+        { "IPAddressAllow",          "a(iayu)", property_read_ip_address_allow,          0                                                 },
+        { "IPAddressDeny",           "a(iayu)", property_read_ip_address_allow,          0                                                 },
+        { "IPIngressFilterPath",     "as",      property_read_ip_filters,                0                                                 },
+        { "IPEgressFilterPath",      "as",      property_read_ip_filters,                0                                                 },
+        { "Id",                      "s",       NULL,                                    offsetof(SecurityInfo, id)                        },
+        { "KeyringMode",             "s",       NULL,                                    offsetof(SecurityInfo, keyring_mode)              },
+        { "ProtectProc",             "s",       NULL,                                    offsetof(SecurityInfo, protect_proc)              },
+        { "ProcSubset",              "s",       NULL,                                    offsetof(SecurityInfo, proc_subset)               },
+        { "LoadState",               "s",       NULL,                                    offsetof(SecurityInfo, load_state)                },
+        { "LockPersonality",         "b",       NULL,                                    offsetof(SecurityInfo, lock_personality)          },
+        { "MemoryDenyWriteExecute",  "b",       NULL,                                    offsetof(SecurityInfo, memory_deny_write_execute) },
+        { "NoNewPrivileges",         "b",       NULL,                                    offsetof(SecurityInfo, no_new_privileges)         },
+        { "NotifyAccess",            "s",       NULL,                                    offsetof(SecurityInfo, notify_access)             },
+        { "PrivateDevices",          "b",       NULL,                                    offsetof(SecurityInfo, private_devices)           },
+        { "PrivateMounts",           "b",       NULL,                                    offsetof(SecurityInfo, private_mounts)            },
+        { "PrivateNetwork",          "b",       NULL,                                    offsetof(SecurityInfo, private_network)           },
+        { "PrivateTmp",              "b",       NULL,                                    offsetof(SecurityInfo, private_tmp)               },
+        { "PrivateUsers",            "b",       NULL,                                    offsetof(SecurityInfo, private_users)             },
+        { "ProtectControlGroups",    "b",       NULL,                                    offsetof(SecurityInfo, protect_control_groups)    },
+        { "ProtectHome",             "s",       NULL,                                    offsetof(SecurityInfo, protect_home)              },
+        { "ProtectHostname",         "b",       NULL,                                    offsetof(SecurityInfo, protect_hostname)          },
+        { "ProtectKernelModules",    "b",       NULL,                                    offsetof(SecurityInfo, protect_kernel_modules)    },
+        { "ProtectKernelTunables",   "b",       NULL,                                    offsetof(SecurityInfo, protect_kernel_tunables)   },
+        { "ProtectKernelLogs",       "b",       NULL,                                    offsetof(SecurityInfo, protect_kernel_logs)       },
+        { "ProtectClock",            "b",       NULL,                                    offsetof(SecurityInfo, protect_clock)             },
+        { "ProtectSystem",           "s",       NULL,                                    offsetof(SecurityInfo, protect_system)            },
+        { "RemoveIPC",               "b",       NULL,                                    offsetof(SecurityInfo, remove_ipc)                },
+        { "RestrictAddressFamilies", "(bas)",   property_read_restrict_address_families, 0                                                 },
+        { "RestrictNamespaces",      "t",       property_read_restrict_namespaces,       0                                                 },
+        { "RestrictRealtime",        "b",       NULL,                                    offsetof(SecurityInfo, restrict_realtime)         },
+        { "RestrictSUIDSGID",        "b",       NULL,                                    offsetof(SecurityInfo, restrict_suid_sgid)        },
+        { "RootDirectory",           "s",       NULL,                                    offsetof(SecurityInfo, root_directory)            },
+        { "RootImage",               "s",       NULL,                                    offsetof(SecurityInfo, root_image)                },
+        { "SupplementaryGroups",     "as",      NULL,                                    offsetof(SecurityInfo, supplementary_groups)      },
+        { "SystemCallArchitectures", "as",      property_read_syscall_archs,             0                                                 },
+        { "SystemCallFilter",        "(as)",    property_read_system_call_filter,        0                                                 },
+        { "Type",                    "s",       NULL,                                    offsetof(SecurityInfo, type)                      },
+        { "UMask",                   "u",       property_read_umask,                     0                                                 },
+        { "User",                    "s",       NULL,                                    offsetof(SecurityInfo, user)                      },
+        {}
+};
 
-        assert(bus);
-        assert(name);
+static int process_security_info(SecurityInfo *info, const char *name, AnalyzeSecurityFlags flags) {
         assert(info);
-
-        path = unit_dbus_path_from_name(name);
-        if (!path)
-                return log_oom();
-
-        r = bus_map_all_properties(
-                        bus,
-                        "org.freedesktop.systemd1",
-                        path,
-                        security_map,
-                        BUS_MAP_STRDUP | BUS_MAP_BOOLEAN_AS_BOOL,
-                        &error,
-                        NULL,
-                        info);
-        if (r < 0)
-                return log_error_errno(r, "Failed to get unit properties: %s", bus_error_message(&error, r));
+        assert(name);
 
         if (!streq_ptr(info->load_state, "loaded")) {
 
@@ -2411,6 +2387,36 @@ static int acquire_security_info(sd_bus *bus, const char *name, SecurityInfo *in
         return 0;
 }
 
+static int acquire_security_info(sd_bus *bus, const char *name, SecurityInfo *info, AnalyzeSecurityFlags flags) {
+        _cleanup_(sd_bus_error_free) sd_bus_error error = SD_BUS_ERROR_NULL;
+        _cleanup_free_ char *path = NULL;
+        int r;
+
+        /* Note: this mangles *info on failure! */
+
+        assert(bus);
+        assert(name);
+        assert(info);
+
+        path = unit_dbus_path_from_name(name);
+        if (!path)
+                return log_oom();
+
+        r = bus_map_all_properties(
+                        bus,
+                        "org.freedesktop.systemd1",
+                        path,
+                        security_map,
+                        BUS_MAP_STRDUP | BUS_MAP_BOOLEAN_AS_BOOL,
+                        &error,
+                        NULL,
+                        info);
+        if (r < 0)
+                return log_error_errno(r, "Failed to get unit properties: %s", bus_error_message(&error, r));
+
+        return process_security_info(info, name, flags);
+}
+
 static int analyze_security_one(sd_bus *bus,
                                 const char *name,
                                 Table *overview_table,
@@ -2756,6 +2762,123 @@ static int offline_security_checks(char **filenames,
         return r;
 }
 
+typedef struct AsyncSecurityContext {
+        Table *overview_table;
+        AnalyzeSecurityFlags flags;
+        unsigned threshold;
+        JsonVariant *policy;
+        PagerFlags pager_flags;
+        JsonFormatFlags json_format_flags;
+        unsigned n_pending;
+        int ret;
+} AsyncSecurityContext;
+
+typedef struct AsyncSecurityQuery {
+        char *name;
+        AsyncSecurityContext *context;
+} AsyncSecurityQuery;
+
+static AsyncSecurityQuery* async_security_query_free(AsyncSecurityQuery *q) {
+        if (!q)
+                return NULL;
+
+        free(q->name);
+        return mfree(q);
+}
+
+DEFINE_TRIVIAL_CLEANUP_FUNC(AsyncSecurityQuery*, async_security_query_free);
+
+static int on_security_info(sd_bus_message *m, void *userdata, sd_bus_error *ret_error) {
+        _cleanup_(async_security_query_freep) AsyncSecurityQuery *q = userdata;
+        _cleanup_(security_info_freep) SecurityInfo *info = NULL;
+        _cleanup_(sd_bus_error_free) sd_bus_error error = SD_BUS_ERROR_NULL;
+        AsyncSecurityContext *c = ASSERT_PTR(q)->context;
+        const sd_bus_error *e;
+        int r;
+
+        assert(c->n_pending > 0);
+        c->n_pending--;
+
+        e = sd_bus_message_get_error(m);
+        if (e) {
+                r = log_error_errno(sd_bus_error_get_errno(e),
+                                    "Failed to get unit properties of %s: %s", q->name, e->message);
+                goto finish;
+        }
+
+        info = security_info_new();
+        if (!info) {
+                r = log_oom();
+                goto finish;
+        }
+
+        r = bus_message_map_all_properties(m, security_map, BUS_MAP_STRDUP | BUS_MAP_BOOLEAN_AS_BOOL, &error, info);
+        if (r < 0) {
+                r = log_error_errno(r, "Failed to parse unit properties of %s: %s",
+                                    q->name, bus_error_message(&error, r));
+                goto finish;
+        }
+
+        r = process_security_info(info, q->name, c->flags);
+        if (r == -EMEDIUMTYPE) { /* Ignore this one because not loaded or Type is oneshot */
+                r = 0;
+                goto finish;
+        }
+        if (r < 0)
+                goto finish;
+
+        r = assess(info, c->overview_table, c->flags, c->threshold, c->policy, c->pager_flags, c->json_format_flags);
+
+finish:
+        if (r < 0 && c->ret >= 0)
+                c->ret = r;
+
+        return 0;
+}
+
+static int analyze_security_queue(sd_bus *bus, const char *name, AsyncSecurityContext *c) {
+        _cleanup_(async_security_query_freep) AsyncSecurityQuery *q = NULL;
+        _cleanup_free_ char *path = NULL;
+        int r;
+
+        assert(bus);
+        assert(name);
+        assert(c);
+
+        path = unit_dbus_path_from_name(name);
+        if (!path)
+                return log_oom();
+
+        q = new(AsyncSecurityQuery, 1);
+        if (!q)
+                return log_oom();
+
+        *q = (AsyncSecurityQuery) {
+                .context = c,
+        };
+
+        q->name = strdup(name);
+        if (!q->name)
+                return log_oom();
+
+        r = sd_bus_call_method_async(
+                        bus,
+                        NULL,
+                        "org.freedesktop.systemd1",
+                        path,
+                        "org.freedesktop.DBus.Properties",
+                        "GetAll",
+                        on_security_info,
+                        q,
+                        "s", "");
+        if (r < 0)
+                return log_error_errno(r, "Failed to query unit properties of %s: %m", name);
+
+        TAKE_PTR(q);
+        c->n_pending++;
+        return 0;
+}
+
 static int analyze_security(sd_bus *bus,
                      char **units,
                      JsonVariant *policy,
@@ -2835,12 +2958,38 @@ static int analyze_security(sd_bus *bus,
 
                 flags |= ANALYZE_SECURITY_SHORT|ANALYZE_SECURITY_ONLY_LOADED|ANALYZE_SECURITY_ONLY_LONG_RUNNING;
 
+                AsyncSecurityContext context = {
+                        .overview_table = overview_table,
+                        .flags = flags,
+                        .threshold = threshold,
+                        .policy = policy,
+                        .pager_flags = pager_flags,
+                        .json_format_flags = json_format_flags,
+                };
+
+                /* Issue all property queries at once and process the replies as they come in, so that we
+                 * don't pay one synchronous bus round trip per unit. The service manager answers the calls
+                 * in order, hence the replies (and thus the output) stay sorted. */
                 STRV_FOREACH(i, list) {
-                        r = analyze_security_one(bus, *i, overview_table, flags, threshold, policy, pager_flags, json_format_flags);
+                        r = analyze_security_queue(bus, *i, &context);
                         if (r < 0 && ret >= 0)
                                 ret = r;
                 }
 
+                while (context.n_pending > 0) {
+                        r = sd_bus_process(bus, NULL);
+                        if (r < 0)
+                                return log_error_errno(r, "Failed to process bus: %m");
+                        if (r == 0) {
+                                r = sd_bus_wait(bus, UINT64_MAX);
+                                if (r < 0)
+                                        return log_error_errno(r, "Failed to wait on bus: %m");
+                        }
+                }
+
+                if (context.ret < 0 && ret >= 0)
+                        ret = context.ret;
+
         } else {
                 char **i;
 
@@ -19,12 +19,15 @@
 #include "analyze-cat-config.h"
 #include "analyze-condition.h"
 #include "analyze-critical-chain.h"
+#include "analyze-critical-flame.h"
 #include "analyze-dot.h"
 #include "analyze-dump.h"
+#include "analyze-exec-timing.h"
 #include "analyze-exit-status.h"
 #include "analyze-filesystems.h"
 #include "analyze-inspect-elf.h"
 #include "analyze-log-control.h"
+#include "analyze-loop-latency.h"
 #include "analyze-plot.h"
 #include "analyze-security.h"
 #include "analyze-service-watchdogs.h"
@@ -186,6 +189,8 @@ static int help(int argc, char *argv[], void *userdata) {
                "                             time to init\n"
                "  critical-chain [UNIT...]   Print a tree of the time critical chain\n"
                "                             of units\n"
+               "  critical-flame             Output boot timeline as folded stacks\n"
+               "                             for flamegraph tooling\n"
                "  plot                       Output SVG graphic showing service\n"
                "                             initialization\n"
                "  dot [UNIT...]              Output dependency graph in %s format\n"
@@ -194,6 +199,10 @@ static int help(int argc, char *argv[], void *userdata) {
                "  cat-config                 Show configuration file and drop-ins\n"
                "  unit-files                 List files and symlinks for units\n"
                "  unit-paths                 List load directories for units\n"
+               "  exec-timing [UNIT...]      Show service spawn timing records from\n"
+               "                             the journal\n"
+               "  loop-latency               Show service manager event loop dispatch\n"
+               "                             latency histogram\n"
                "  exit-status [STATUS...]    List exit status definitions\n"
                "  capability [CAP...]        List capability definitions\n"
                "  syscall-filter [NAME...]   List syscalls in seccomp filters\n"
@@ -544,6 +553,7 @@ static int run(int argc, char *argv[]) {
                 { "time",              VERB_ANY, 1,        VERB_DEFAULT, verb_time              },
                 { "blame",             VERB_ANY, 1,        0,            verb_blame             },
                 { "critical-chain",    VERB_ANY, VERB_ANY, 0,            verb_critical_chain    },
+                { "critical-flame",    VERB_ANY, 1,        0,            verb_critical_flame    },
                 { "plot",              VERB_ANY, 1,        0,            verb_plot              },
                 { "dot",               VERB_ANY, VERB_ANY, 0,            verb_dot               },
                 /* ↓ The following seven verbs are deprecated, from here … ↓ */
@@ -559,6 +569,8 @@ static int run(int argc, char *argv[]) {
                 { "cat-config",        2,        VERB_ANY, 0,            verb_cat_config        },
                 { "unit-files",        VERB_ANY, VERB_ANY, 0,            verb_unit_files        },
                 { "unit-paths",        1,        1,        0,            verb_unit_paths        },
+                { "exec-timing",       VERB_ANY, VERB_ANY, 0,            verb_exec_timing       },
+                { "loop-latency",      VERB_ANY, 1,        0,            verb_loop_latency      },
                 { "exit-status",       VERB_ANY, VERB_ANY, 0,            verb_exit_status       },
                 { "syscall-filter",    VERB_ANY, VERB_ANY, 0,            verb_syscall_filters   },
                 { "capability",        VERB_ANY, VERB_ANY, 0,            verb_capabilities      },
@@ -1799,34 +1799,18 @@ int cg_get_owner(const char *controller, const char *path, uid_t *ret_uid) {
         return 0;
 }
 
-int cg_get_keyed_attribute_full(
-                const char *controller,
-                const char *path,
-                const char *attribute,
+static int cg_parse_keyed_attribute(
+                const char *contents,
                 char **keys,
                 char **ret_values,
                 CGroupKeyMode mode) {
 
-        _cleanup_free_ char *filename = NULL, *contents = NULL;
         const char *p;
         size_t n, i, n_done = 0;
         char **v;
         int r;
 
-        /* Reads one or more fields of a cgroup v2 keyed attribute file. The 'keys' parameter should be an strv with
-         * all keys to retrieve. The 'ret_values' parameter should be passed as string size with the same number of
-         * entries as 'keys'. On success each entry will be set to the value of the matching key.
-         *
-         * If the attribute file doesn't exist at all returns ENOENT, if any key is not found returns ENXIO. If mode
-         * is set to GG_KEY_MODE_GRACEFUL we ignore missing keys and return those that were parsed successfully. */
-
-        r = cg_get_path(controller, path, attribute, &filename);
-        if (r < 0)
-                return r;
-
-        r = read_full_file(filename, &contents, NULL);
-        if (r < 0)
-                return r;
+        assert(contents);
 
         n = strv_length(keys);
         if (n == 0) /* No keys to retrieve? That's easy, we are done then */
@@ -1885,6 +1869,57 @@ done:
         return 0;
 }
 
+int cg_get_keyed_attribute_full(
+                const char *controller,
+                const char *path,
+                const char *attribute,
+                char **keys,
+                char **ret_values,
+                CGroupKeyMode mode) {
+
+        _cleanup_free_ char *filename = NULL, *contents = NULL;
+        int r;
+
+        /* Reads one or more fields of a cgroup v2 keyed attribute file. The 'keys' parameter should be an strv with
+         * all keys to retrieve. The 'ret_values' parameter should be passed as string size with the same number of
+         * entries as 'keys'. On success each entry will be set to the value of the matching key.
+         *
+         * If the attribute file doesn't exist at all returns ENOENT, if any key is not found returns ENXIO. If mode
+         * is set to GG_KEY_MODE_GRACEFUL we ignore missing keys and return those that were parsed successfully. */
+
+        r = cg_get_path(controller, path, attribute, &filename);
+        if (r < 0)
+                return r;
+
+        r = read_full_file(filename, &contents, NULL);
+        if (r < 0)
+                return r;
+
+        return cg_parse_keyed_attribute(contents, keys, ret_values, mode);
+}
+
+int cg_get_keyed_attribute_at(
+                int dir_fd,
+                const char *attribute,
+                char **keys,
+                char **ret_values) {
+
+        _cleanup_free_ char *contents = NULL;
+        int r;
+
+        /* Like cg_get_keyed_attribute(), but reads the attribute file relative to an already open fd of the
+         * cgroup directory, hence skipping the path resolution. */
+
+        assert(dir_fd >= 0 || dir_fd == AT_FDCWD);
+        assert(attribute);
+
+        r = read_virtual_file_at(dir_fd, attribute, SIZE_MAX, &contents, NULL);
+        if (r < 0)
+                return r;
+
+        return cg_parse_keyed_attribute(contents, keys, ret_values, 0);
+}
+
 int cg_mask_to_string(CGroupMask mask, char **ret) {
         _cleanup_free_ char *s = NULL;
         bool space = false;
@@ -214,6 +214,7 @@ typedef enum  {
 int cg_set_attribute(const char *controller, const char *path, const char *attribute, const char *value);
 int cg_get_attribute(const char *controller, const char *path, const char *attribute, char **ret);
 int cg_get_keyed_attribute_full(const char *controller, const char *path, const char *attribute, char **keys, char **values, CGroupKeyMode mode);
+int cg_get_keyed_attribute_at(int dir_fd, const char *attribute, char **keys, char **ret_values);
 
 static inline int cg_get_keyed_attribute(
                 const char *controller,
@@ -48,6 +48,7 @@ static int files_add(
 
         FOREACH_DIRENT(de, dir, return -errno) {
                 struct stat st;
+                bool need_stat;
                 char *p, *key;
 
                 /* Does this match the suffix? */
@@ -66,8 +67,14 @@ static int files_add(
                         continue;
                 }
 
-                /* Read file metadata if we shall validate the check for file masks, for node types or whether the node is marked executable. */
-                if (flags & (CONF_FILES_FILTER_MASKED|CONF_FILES_REGULAR|CONF_FILES_DIRECTORY|CONF_FILES_EXECUTABLE))
+                /* Read file metadata if we shall validate the check for file masks or whether the node is
+                 * marked executable, which d_type can't answer. For the plain node type checks the d_type
+                 * that readdir() already handed us suffices, except for symlinks which the stat() below
+                 * would follow, and for DT_UNKNOWN. */
+                need_stat = (flags & (CONF_FILES_FILTER_MASKED|CONF_FILES_EXECUTABLE)) ||
+                        ((flags & (CONF_FILES_REGULAR|CONF_FILES_DIRECTORY)) && IN_SET(de->d_type, DT_LNK, DT_UNKNOWN));
+
+                if (need_stat)
                         if (fstatat(dirfd(dir), de->d_name, &st, 0) < 0) {
                                 log_debug_errno(errno, "Failed to stat '%s/%s', ignoring: %m", dirpath, de->d_name);
                                 continue;
@@ -88,12 +95,15 @@ static int files_add(
                         }
 
                 /* Does this node have the right type? */
-                if (flags & (CONF_FILES_REGULAR|CONF_FILES_DIRECTORY))
-                        if (!((flags & CONF_FILES_DIRECTORY) && S_ISDIR(st.st_mode)) &&
-                            !((flags & CONF_FILES_REGULAR) && S_ISREG(st.st_mode))) {
+                if (flags & (CONF_FILES_REGULAR|CONF_FILES_DIRECTORY)) {
+                        mode_t m = need_stat ? st.st_mode : DTTOIF(de->d_type);
+
+                        if (!((flags & CONF_FILES_DIRECTORY) && S_ISDIR(m)) &&
+                            !((flags & CONF_FILES_REGULAR) && S_ISREG(m))) {
                                 log_debug("Ignoring '%s/%s', as it does not have the right type.", dirpath, de->d_name);
                                 continue;
                         }
+                }
 
                 /* Does this node have the executable bit set? */
                 if (flags & CONF_FILES_EXECUTABLE)
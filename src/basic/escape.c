@@ -89,8 +89,21 @@ char* cescape_length(const char *s, size_t n) {
         if (!r)
                 return NULL;
 
-        for (f = s, t = r; f < s + n; f++)
+        for (f = s, t = r; f < s + n; f++) {
+                /* Copy runs of characters that need no escaping in one go, which is the vast bulk of
+                 * typical input. The per-character escaping logic only runs for the rest. */
+                const char *start = f;
+
+                while (f < s + n && (uint8_t) *f >= ' ' && (uint8_t) *f < 127 && !IN_SET(*f, '\\', '"', '\''))
+                        f++;
+
+                t = mempcpy(t, start, f - start);
+
+                if (f >= s + n)
+                        break;
+
                 t += cescape_char(*f, t);
+        }
 
         *t = 0;
 
@@ -32,11 +32,50 @@ int extract_first_word(const char **p, char **ret, const char *separators, Extra
         /* Bail early if called after last value or with no input */
         if (!*p)
                 goto finish;
-        c = **p;
 
         if (!separators)
                 separators = WHITESPACE;
 
+        /* Fast path: in the vast majority of cases the next word contains neither quotes nor
+         * backslashes, and is hence simply the run of characters up to the next separator. Detect that
+         * with a single scan and take one exact-sized copy, bypassing the incremental unescaping
+         * machinery below. All flags except the separator handling ones only affect quote and
+         * backslash processing, hence don't matter here. */
+        if (!(flags & EXTRACT_DONT_COALESCE_SEPARATORS)) {
+                const char *start, *end;
+
+                start = *p + strspn(*p, separators);
+                if (*start == 0)
+                        goto finish_force_terminate;
+
+                end = start + strcspn(start, separators);
+                if (!memchr(start, '\'', end - start) &&
+                    !memchr(start, '"', end - start) &&
+                    !memchr(start, '\\', end - start)) {
+
+                        s = strndup(start, end - start);
+                        if (!s)
+                                return -ENOMEM;
+
+                        if (*end == 0)
+                                *p = NULL;
+                        else if (flags & EXTRACT_RETAIN_SEPARATORS)
+                                *p = end;
+                        else {
+                                end += strspn(end, separators);
+                                *p = *end == 0 ? NULL : end;
+                        }
+
+                        *ret = TAKE_PTR(s);
+                        return 1;
+                }
+
+                /* Quotes or backslashes involved, take the generic path below. */
+                *p = start;
+        }
+
+        c = **p;
+
         /* Parses the first word of a string, and returns it in
          * *ret. Removes all quotes in the process. When parsing fails
          * (because of an uneven number of quotes or similar), leaves
@@ -1280,7 +1280,6 @@ DEFINE_TRIVIAL_CLEANUP_FUNC_FULL(FILE*, funlockfile, NULL);
 int read_line_full(FILE *f, size_t limit, ReadLineFlags flags, char **ret) {
         _cleanup_free_ char *buffer = NULL;
         size_t n = 0, count = 0;
-        int r;
 
         assert(f);
 
@@ -1321,6 +1320,7 @@ int read_line_full(FILE *f, size_t limit, ReadLineFlags flags, char **ret) {
                 for (;;) {
                         EndOfLineMarker eol;
                         char c;
+                        int k;
 
                         if (n >= limit)
                                 return -ENOBUFS;
@@ -1328,11 +1328,19 @@ int read_line_full(FILE *f, size_t limit, ReadLineFlags flags, char **ret) {
                         if (count >= INT_MAX) /* We couldn't return the counter anymore as "int", hence refuse this */
                                 return -ENOBUFS;
 
-                        r = safe_fgetc(f, &c);
-                        if (r < 0)
-                                return r;
-                        if (r == 0) /* EOF is definitely EOL */
-                                break;
+                        /* We read one byte at a time, since we have to find the EOL marker. We hold the
+                         * stream lock for the whole loop (see above), hence use the _unlocked() API to spare
+                         * the recursive lock acquisition plain fgetc() would do per byte — on large inputs
+                         * (think: PID 1 deserializing its state on reexec) that lock is the hot spot. The
+                         * EOF/error untangling mirrors safe_fgetc(). */
+                        k = fgetc_unlocked(f);
+                        if (k == EOF) {
+                                if (ferror_unlocked(f))
+                                        return errno > 0 ? -errno : -EIO;
+
+                                break; /* EOF is definitely EOL */
+                        }
+                        c = (char) k;
 
                         eol = categorize_eol(c, flags);
 
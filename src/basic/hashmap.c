@@ -336,7 +336,9 @@ static unsigned base_bucket_hash(HashmapBase *h, const void *p) {
         struct siphash state;
         uint64_t hash;
 
-        siphash24_init(&state, hash_key(h));
+        /* Bucket placement is purely in-process and the key is random per table, so the reduced-round
+         * SipHash-1-3 variant suffices here; hash values never hit the disk or the wire. */
+        siphash13_init(&state, hash_key(h));
 
         h->hash_ops->hash(p, &state);
 
@@ -1595,12 +1597,21 @@ unsigned _hashmap_buckets(HashmapBase *h) {
 int _hashmap_merge(Hashmap *h, Hashmap *other) {
         Iterator i;
         unsigned idx;
+        int r;
 
         assert(h);
 
+        if (!other)
+                return 0;
+
+        /* Size the bucket array for the worst case right away, so that the insertion loop below doesn't
+         * need to grow (and rehash) it repeatedly. */
+        r = resize_buckets(HASHMAP_BASE(h), n_entries(HASHMAP_BASE(other)));
+        if (r < 0)
+                return r;
+
         HASHMAP_FOREACH_IDX(idx, HASHMAP_BASE(other), i) {
                 struct plain_hashmap_entry *pe = plain_bucket_at(other, idx);
-                int r;
 
                 r = hashmap_put(h, pe->b.key, pe->value);
                 if (r < 0 && r != -EEXIST)
@@ -1613,12 +1624,20 @@ int _hashmap_merge(Hashmap *h, Hashmap *other) {
 int set_merge(Set *s, Set *other) {
         Iterator i;
         unsigned idx;
+        int r;
 
         assert(s);
 
+        if (!other)
+                return 0;
+
+        /* As above, reserve the buckets for the worst case upfront */
+        r = resize_buckets(HASHMAP_BASE(s), n_entries(HASHMAP_BASE(other)));
+        if (r < 0)
+                return r;
+
         HASHMAP_FOREACH_IDX(idx, HASHMAP_BASE(other), i) {
                 struct set_entry *se = set_bucket_at(other, idx);
-                int r;
 
                 r = set_put(s, se->b.key);
                 if (r < 0)
@@ -398,7 +398,7 @@ static int write_to_console(
         }
 
         if (show_tid) {
-                xsprintf(tid_string, "(" PID_FMT ") ", gettid());
+                xsprintf(tid_string, "(" PID_FMT ") ", gettid_cached());
                 iovec[n++] = IOVEC_MAKE_STRING(tid_string);
         }
 
@@ -573,7 +573,7 @@ static int log_do_header(
                      "SYSLOG_IDENTIFIER=%.256s\n",
                      LOG_PRI(level),
                      LOG_FAC(level),
-                     gettid(),
+                     gettid_cached(),
                      isempty(file) ? "" : "CODE_FILE=",
                      isempty(file) ? "" : file,
                      isempty(file) ? "" : "\n",
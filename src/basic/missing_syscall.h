@@ -563,6 +563,38 @@ static inline int missing_open_tree(
 
 /* ======================================================================= */
 
+#if !HAVE_OPENAT2
+
+#if HAVE_LINUX_OPENAT2_H
+#include <linux/openat2.h>
+#else
+struct open_how {
+        uint64_t flags;
+        uint64_t mode;
+        uint64_t resolve;
+};
+
+#define RESOLVE_NO_XDEV       0x01 /* Block mount-point crossings (includes bind-mounts). */
+#define RESOLVE_NO_MAGICLINKS 0x02 /* Block traversal through procfs-style "magic-links". */
+#define RESOLVE_NO_SYMLINKS   0x04 /* Block traversal through all symlinks (implies RESOLVE_NO_MAGICLINKS) */
+#define RESOLVE_BENEATH       0x08 /* Block "lexical" trickery like "..", symlinks, and absolute paths which escape the dirfd. */
+#define RESOLVE_IN_ROOT       0x10 /* Make all jumps to "/" and ".." be scoped inside the dirfd (similar to chroot(2)). */
+#endif
+
+static inline int missing_openat2(int dfd, const char *path, const struct open_how *how, size_t size) {
+#  if defined __NR_openat2 && __NR_openat2 >= 0
+        return syscall(__NR_openat2, dfd, path, how, size);
+#  else
+        errno = ENOSYS;
+        return -1;
+#  endif
+}
+
+#  define openat2 missing_openat2
+#endif
+
+/* ======================================================================= */
+
 #if !HAVE_MOVE_MOUNT
 
 #ifndef MOVE_MOUNT_F_EMPTY_PATH
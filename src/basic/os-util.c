@@ -248,6 +248,12 @@ int _parse_extension_release(const char *root, const char *extension, ...) {
         return r;
 }
 
+/* Note: there's deliberately no process-shared parsed cache for os-release data here: the file is a few
+ * hundred bytes, a parse is microseconds, and callers that need several fields already get them in a single
+ * pass by listing them in one invocation. A /run snapshot would add a writer, a permission model, ordering
+ * against whatever generates it, and mtime invalidation logic that must also cover --root= and image cases
+ * where the file isn't the host's — all to avoid a cost too small to measure. Components that query
+ * repeatedly (e.g. hostnamed) keep their own stat-guarded copy instead. */
 int _parse_os_release(const char *root, ...) {
         va_list ap;
         int r;
@@ -17,14 +17,16 @@
 #include "virt.h"
 
 int proc_cmdline(char **ret) {
+        static thread_local char *cached = NULL;
         const char *e;
+        char *m;
+        int r;
+
         assert(ret);
 
         /* For testing purposes it is sometimes useful to be able to override what we consider /proc/cmdline to be */
         e = secure_getenv("SYSTEMD_PROC_CMDLINE");
         if (e) {
-                char *m;
-
                 m = strdup(e);
                 if (!m)
                         return -ENOMEM;
@@ -35,8 +37,22 @@ int proc_cmdline(char **ret) {
 
         if (detect_container() > 0)
                 return get_process_cmdline(1, SIZE_MAX, 0, ret);
-        else
-                return read_one_line_file("/proc/cmdline", ret);
+
+        /* The kernel command line cannot change during the lifetime of this process, hence read it only
+         * once, and then keep handing out copies. This matters, since this is queried over and over again,
+         * for example whenever unit condition checks are run. */
+        if (!cached) {
+                r = read_one_line_file("/proc/cmdline", &cached);
+                if (r < 0)
+                        return r;
+        }
+
+        m = strdup(cached);
+        if (!m)
+                return -ENOMEM;
+
+        *ret = m;
+        return 0;
 }
 
 static int proc_cmdline_extract_first(const char **p, char **ret_word, ProcCmdlineFlags flags) {
@@ -1210,6 +1210,37 @@ pid_t getpid_cached(void) {
         }
 }
 
+static thread_local pid_t cached_tid = 0;
+
+static void reset_cached_tid(void) {
+        /* Only the thread that called fork() survives in the child, hence resetting our own
+         * thread-local cache is sufficient. */
+        cached_tid = 0;
+}
+
+pid_t gettid_cached(void) {
+        static bool installed = false;
+
+        /* Much like getpid_cached(), but for gettid(): glibc's wrapper issues the system call
+         * unconditionally, which adds up in processes that log heavily, as every journal and kmsg
+         * record carries a TID= field. The value is cached per thread, hence no synchronization is
+         * needed beyond the fork handler registration. */
+
+        if (cached_tid == 0) {
+                if (!installed) {
+                        if (pthread_atfork(NULL, NULL, reset_cached_tid) != 0)
+                                /* OOM? Let's try again later */
+                                return gettid();
+
+                        installed = true;
+                }
+
+                cached_tid = gettid();
+        }
+
+        return cached_tid;
+}
+
 int must_be_root(void) {
 
         if (geteuid() == 0)
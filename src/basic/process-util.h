@@ -132,6 +132,7 @@ static inline bool pid_is_valid(pid_t p) {
 
 pid_t getpid_cached(void);
 void reset_cached_pid(void);
+pid_t gettid_cached(void);
 
 int must_be_root(void);
 
@@ -50,7 +50,12 @@ static void sipround(struct siphash *state) {
         state->v2 = rotate_left(state->v2, 32);
 }
 
-void siphash24_init(struct siphash *state, const uint8_t k[static 16]) {
+static void siphash_rounds(struct siphash *state, unsigned n) {
+        for (unsigned i = 0; i < n; i++)
+                sipround(state);
+}
+
+static void siphash_init(struct siphash *state, const uint8_t k[static 16], uint8_t c_rounds, uint8_t d_rounds) {
         uint64_t k0, k1;
 
         assert(state);
@@ -67,9 +72,19 @@ void siphash24_init(struct siphash *state, const uint8_t k[static 16]) {
                 .v3 = 0x7465646279746573ULL ^ k1,
                 .padding = 0,
                 .inlen = 0,
+                .c_rounds = c_rounds,
+                .d_rounds = d_rounds,
         };
 }
 
+void siphash24_init(struct siphash *state, const uint8_t k[static 16]) {
+        siphash_init(state, k, 2, 4);
+}
+
+void siphash13_init(struct siphash *state, const uint8_t k[static 16]) {
+        siphash_init(state, k, 1, 3);
+}
+
 void siphash24_compress(const void *_in, size_t inlen, struct siphash *state) {
 
         const uint8_t *in = _in;
@@ -101,8 +116,7 @@ void siphash24_compress(const void *_in, size_t inlen, struct siphash *state) {
 #endif
 
                 state->v3 ^= state->padding;
-                sipround(state);
-                sipround(state);
+                siphash_rounds(state, state->c_rounds);
                 state->v0 ^= state->padding;
 
                 state->padding = 0;
@@ -120,8 +134,7 @@ void siphash24_compress(const void *_in, size_t inlen, struct siphash *state) {
                 printf("(%3zu) compress %08x %08x\n", state->inlen, (uint32_t) (m >> 32), (uint32_t) m);
 #endif
                 state->v3 ^= m;
-                sipround(state);
-                sipround(state);
+                siphash_rounds(state, state->c_rounds);
                 state->v0 ^= m;
         }
 
@@ -169,8 +182,7 @@ uint64_t siphash24_finalize(struct siphash *state) {
 #endif
 
         state->v3 ^= b;
-        sipround(state);
-        sipround(state);
+        siphash_rounds(state, state->c_rounds);
         state->v0 ^= b;
 
 #if ENABLE_DEBUG_SIPHASH
@@ -181,10 +193,7 @@ uint64_t siphash24_finalize(struct siphash *state) {
 #endif
         state->v2 ^= 0xff;
 
-        sipround(state);
-        sipround(state);
-        sipround(state);
-        sipround(state);
+        siphash_rounds(state, state->d_rounds);
 
         return state->v0 ^ state->v1 ^ state->v2  ^ state->v3;
 }
@@ -17,9 +17,18 @@ struct siphash {
         uint64_t v3;
         uint64_t padding;
         size_t inlen;
+        uint8_t c_rounds; /* compression rounds per message block */
+        uint8_t d_rounds; /* finalization rounds */
 };
 
 void siphash24_init(struct siphash *state, const uint8_t k[static 16]);
+
+/* Initializes the state for SipHash-1-3 instead of the default SipHash-2-4, i.e. with half the rounds. The
+ * result is a different (and weaker) PRF, hence this must never be used for anything whose hash values are
+ * persisted to disk or exchanged with other processes — it's strictly for in-process hash tables keyed with
+ * a random per-table key, where the reduced rounds still provide keyed flooding protection. The subsequent
+ * siphash24_compress()/siphash24_finalize() calls pick up the round count from the state. */
+void siphash13_init(struct siphash *state, const uint8_t k[static 16]);
 void siphash24_compress(const void *in, size_t inlen, struct siphash *state);
 #define siphash24_compress_byte(byte, state) siphash24_compress((const uint8_t[]) { (byte) }, 1, (state))
 
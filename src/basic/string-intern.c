@@ -0,0 +1,117 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hashmap.h"
+#include "macro.h"
+#include "string-intern.h"
+#include "string-util.h"
+
+/* A simple refcounted string interning pool: equal strings are stored once and shared. This is useful for
+ * strings that are duplicated many times over by nature, such as unit names or cgroup paths attached to
+ * per-client state. Note that the pool is process-wide but not locked, hence this may only be used from the
+ * main thread. */
+
+typedef struct InternedString {
+        size_t n_ref;
+        char string[];
+} InternedString;
+
+static Hashmap *intern_pool = NULL;
+
+const char* string_intern(const char *s) {
+        InternedString *is;
+        size_t l;
+        int r;
+
+        /* Returns an interned (and referenced) copy of the specified string, or NULL on OOM. Release via
+         * string_intern_unref(), never via free(). */
+
+        if (!s)
+                return NULL;
+
+        is = hashmap_get(intern_pool, s);
+        if (is) {
+                is->n_ref++;
+                return is->string;
+        }
+
+        l = strlen(s);
+
+        is = malloc(offsetof(InternedString, string) + l + 1);
+        if (!is)
+                return NULL;
+
+        is->n_ref = 1;
+        memcpy(is->string, s, l + 1);
+
+        r = hashmap_ensure_put(&intern_pool, &string_hash_ops, is->string, is);
+        if (r < 0) {
+                free(is);
+                return NULL;
+        }
+
+        return is->string;
+}
+
+const char* string_intern_ref(const char *s) {
+        InternedString *is;
+
+        if (!s)
+                return NULL;
+
+        assert_se(is = hashmap_get(intern_pool, s));
+        assert(is->string == s);
+
+        is->n_ref++;
+        return is->string;
+}
+
+const char* string_intern_unref(const char *s) {
+        InternedString *is;
+
+        if (!s)
+                return NULL;
+
+        assert_se(is = hashmap_get(intern_pool, s));
+        assert(is->string == s);
+        assert(is->n_ref > 0);
+
+        if (--is->n_ref == 0) {
+                assert_se(hashmap_remove(intern_pool, s) == is);
+                free(is);
+        }
+
+        return NULL;
+}
+
+int string_intern_update(const char **p, const char *s) {
+        const char *t;
+
+        assert(p);
+
+        /* Replaces an interned string with an interned copy of the specified one, much like
+         * free_and_strdup() does for plain strings. Returns 0 if the strings were equal already, 1 if the
+         * target was updated. */
+
+        if (streq_ptr(*p, s))
+                return 0;
+
+        if (s) {
+                t = string_intern(s);
+                if (!t)
+                        return -ENOMEM;
+        } else
+                t = NULL;
+
+        string_intern_unref(*p);
+        *p = t;
+
+        return 1;
+}
+
+unsigned string_intern_pool_size(void) {
+        return hashmap_size(intern_pool);
+}
@@ -0,0 +1,10 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+#pragma once
+
+const char* string_intern(const char *s);
+const char* string_intern_ref(const char *s);
+const char* string_intern_unref(const char *s);
+
+int string_intern_update(const char **p, const char *s);
+
+unsigned string_intern_pool_size(void);
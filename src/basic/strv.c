@@ -419,30 +419,39 @@ char* strv_join_full(char * const *l, const char *separator, const char *prefix,
         return r;
 }
 
-int strv_push(char ***l, char *value) {
+int strv_push_with_size(char ***l, size_t *n, char *value) {
         char **c;
-        size_t n;
+        size_t m;
+
+        /* If 'n' is specified, it is used and updated in place of counting the array on each call, turning
+         * a loop of appends from quadratic into linear. The caller must keep it in sync with the array. */
 
         if (!value)
                 return 0;
 
-        n = strv_length(*l);
+        m = n ? *n : strv_length(*l);
 
         /* Check for overflow */
-        if (n > SIZE_MAX-2)
+        if (m > SIZE_MAX-2)
                 return -ENOMEM;
 
-        c = reallocarray(*l, GREEDY_ALLOC_ROUND_UP(n + 2), sizeof(char*));
+        c = reallocarray(*l, GREEDY_ALLOC_ROUND_UP(m + 2), sizeof(char*));
         if (!c)
                 return -ENOMEM;
 
-        c[n] = value;
-        c[n+1] = NULL;
+        c[m] = value;
+        c[m+1] = NULL;
 
         *l = c;
+        if (n)
+                *n = m + 1;
         return 0;
 }
 
+int strv_push(char ***l, char *value) {
+        return strv_push_with_size(l, NULL, value);
+}
+
 int strv_push_pair(char ***l, char *a, char *b) {
         char **c;
         size_t n;
@@ -500,16 +509,20 @@ int strv_insert(char ***l, size_t position, char *value) {
         return free_and_replace(*l, c);
 }
 
-int strv_consume(char ***l, char *value) {
+int strv_consume_with_size(char ***l, size_t *n, char *value) {
         int r;
 
-        r = strv_push(l, value);
+        r = strv_push_with_size(l, n, value);
         if (r < 0)
                 free(value);
 
         return r;
 }
 
+int strv_consume(char ***l, char *value) {
+        return strv_consume_with_size(l, NULL, value);
+}
+
 int strv_consume_pair(char ***l, char *a, char *b) {
         int r;
 
@@ -545,7 +558,7 @@ int strv_prepend(char ***l, const char *value) {
         return strv_consume_prepend(l, v);
 }
 
-int strv_extend(char ***l, const char *value) {
+int strv_extend_with_size(char ***l, size_t *n, const char *value) {
         char *v;
 
         if (!value)
@@ -555,7 +568,11 @@ int strv_extend(char ***l, const char *value) {
         if (!v)
                 return -ENOMEM;
 
-        return strv_consume(l, v);
+        return strv_consume_with_size(l, n, v);
+}
+
+int strv_extend(char ***l, const char *value) {
+        return strv_extend_with_size(l, NULL, value);
 }
 
 int strv_extend_front(char ***l, const char *value) {
@@ -695,9 +712,10 @@ char** strv_parse_nulstr(const char *s, size_t l) {
 char** strv_split_nulstr(const char *s) {
         const char *i;
         char **r = NULL;
+        size_t n = 0;
 
         NULSTR_FOREACH(i, s)
-                if (strv_extend(&r, i) < 0) {
+                if (strv_extend_with_size(&r, &n, i) < 0) {
                         strv_free(r);
                         return NULL;
                 }
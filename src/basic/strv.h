@@ -35,9 +35,15 @@ size_t strv_length(char * const *l) _pure_;
 int strv_extend_strv(char ***a, char * const *b, bool filter_duplicates);
 int strv_extend_strv_concat(char ***a, char * const *b, const char *suffix);
 int strv_prepend(char ***l, const char *value);
+
+/* _with_size() variants take a pointer to the size of the array, so that when appending in a loop the array
+ * doesn't need to be recounted on each iteration. If 'n' is NULL the size is determined with strv_length(). */
+int strv_extend_with_size(char ***l, size_t *n, const char *value);
 int strv_extend(char ***l, const char *value);
+
 int strv_extendf(char ***l, const char *format, ...) _printf_(2,0);
 int strv_extend_front(char ***l, const char *value);
+int strv_push_with_size(char ***l, size_t *n, char *value);
 int strv_push(char ***l, char *value);
 int strv_push_pair(char ***l, char *a, char *b);
 int strv_insert(char ***l, size_t position, char *value);
@@ -46,6 +52,7 @@ static inline int strv_push_prepend(char ***l, char *value) {
         return strv_insert(l, 0, value);
 }
 
+int strv_consume_with_size(char ***l, size_t *n, char *value);
 int strv_consume(char ***l, char *value);
 int strv_consume_pair(char ***l, char *a, char *b);
 int strv_consume_prepend(char ***l, char *value);
@@ -61,6 +61,67 @@ int sysctl_write(const char *property, const char *value) {
         return write_string_file(p, value, WRITE_STRING_FILE_VERIFY_ON_FAILURE | WRITE_STRING_FILE_DISABLE_BUFFER | WRITE_STRING_FILE_SUPPRESS_REDUNDANT_VIRTUAL);
 }
 
+int sysctl_write_at(int dir_fd, const char *property, const char *value) {
+        _cleanup_fclose_ FILE *f = NULL;
+        _cleanup_free_ char *p = NULL, *t = NULL;
+        _cleanup_close_ int verify_fd = -1;
+        int r, fd;
+
+        assert(dir_fd >= 0);
+        assert(property);
+        assert(value);
+
+        /* Like sysctl_write(), but resolves the (relative, normalized) property against an already open
+         * directory fd of /proc/sys. Batched appliers that set many sysctls in a row use this to avoid
+         * paying for a full path walk from the root on every single write. */
+
+        p = strdup(property);
+        if (!p)
+                return -ENOMEM;
+
+        path_simplify(p);
+        if (path_is_absolute(p) || !path_is_normalized(p))
+                return -EINVAL;
+
+        log_debug("Setting '/proc/sys/%s' to '%s'", p, value);
+
+        /* Open O_RDWR, so that the redundant write suppression below can read the current value from the
+         * very same fd, matching what write_string_file() does with
+         * WRITE_STRING_FILE_SUPPRESS_REDUNDANT_VIRTUAL. */
+        fd = openat(dir_fd, p, O_RDWR|O_CLOEXEC|O_NOCTTY);
+        if (fd < 0)
+                r = -errno;
+        else {
+                r = fdopen_unlocked(fd, "w", &f);
+                if (r < 0)
+                        safe_close(fd);
+                else {
+                        setvbuf(f, NULL, _IONBF, 0);
+                        r = write_string_stream(f, value,
+                                                WRITE_STRING_FILE_DISABLE_BUFFER |
+                                                WRITE_STRING_FILE_SUPPRESS_REDUNDANT_VIRTUAL);
+                }
+        }
+        if (r >= 0)
+                return 0;
+
+        /* The write failed, but mirror WRITE_STRING_FILE_VERIFY_ON_FAILURE: if the requested value is in
+         * place already, let's eat up the error. */
+        f = safe_fclose(f);
+
+        verify_fd = openat(dir_fd, p, O_RDONLY|O_CLOEXEC|O_NOCTTY);
+        if (verify_fd < 0)
+                return r;
+
+        if (read_virtual_file_fd(verify_fd, strlen(value)+1, &t, NULL) <= 0)
+                return r;
+
+        if (!streq_skip_trailing_chars(value, t, NEWLINE))
+                return r;
+
+        return 0;
+}
+
 int sysctl_writef(const char *property, const char *format, ...) {
         _cleanup_free_ char *v = NULL;
         va_list ap;
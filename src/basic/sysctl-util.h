@@ -11,6 +11,7 @@
 char *sysctl_normalize(char *s);
 int sysctl_read(const char *property, char **value);
 int sysctl_write(const char *property, const char *value);
+int sysctl_write_at(int dir_fd, const char *property, const char *value);
 int sysctl_writef(const char *property, const char *format, ...) _printf_(2, 3);
 
 int sysctl_read_ip_property(int af, const char *ifname, const char *property, char **ret);
@@ -0,0 +1,16 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+#pragma once
+
+#if HAVE_SYS_SDT_H
+#define SDT_USE_VARIADIC
+#include <sys/sdt.h>
+
+/* Static user-space trace points (USDT), compiled to a single NOP unless a tracer (bpftrace, perf, SystemTap,
+ * …) attaches to them. This generalizes the DEVICE_TRACE_POINT() macro udev has carried for a while to the
+ * other daemons. Probes are grouped by provider (e.g. "systemd", "journald", "resolved"), and all of them are
+ * listed in docs/USDT_PROBES.md — when adding or changing a probe, update that file too. */
+#define TRACE_POINT(provider, name, ...)                                \
+        STAP_PROBEV(provider, name __VA_OPT__(,) __VA_ARGS__)
+#else
+#define TRACE_POINT(provider, name, ...) ((void) 0)
+#endif
@@ -1,5 +1,7 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
+#include <fcntl.h>
+
 #include "sd-id128.h"
 
 #include "chase-symlinks.h"
@@ -297,6 +299,24 @@ int unit_file_build_name_map(
                 paths = set_new(&path_hash_ops_free);
                 if (!paths)
                         return log_oom();
+
+                /* Presize the set a bit, on rebuilds the old cache gives a good estimate */
+                r = set_reserve(paths, set_size(*path_cache));
+                if (r < 0)
+                        return log_oom();
+        }
+
+        /* When rebuilding an existing map the new one will typically end up with about as many entries as
+         * the old one had, so size the hash table for that right away instead of growing it through
+         * repeated rehashing while we insert the ids one by one. */
+        if (!hashmap_isempty(*unit_ids_map)) {
+                ids = hashmap_new(&string_hash_ops_free_free);
+                if (!ids)
+                        return log_oom();
+
+                r = hashmap_reserve(ids, hashmap_size(*unit_ids_map));
+                if (r < 0)
+                        return log_oom();
         }
 
         STRV_FOREACH(dir, (char**) lp->search_path) {
@@ -320,11 +340,20 @@ int unit_file_build_name_map(
                          * rest. */
 
                         if (de->d_type == DT_REG) {
+                                _cleanup_close_ int fd = -1;
 
                                 /* Accept a regular file whose name is a valid unit file name. */
                                 if (!unit_name_is_valid(de->d_name, UNIT_NAME_ANY))
                                         continue;
 
+                                /* Most of these files will be parsed shortly, one by one. Ask the kernel to
+                                 * start loading them into the page cache now, while we are still
+                                 * enumerating, so that the later reads don't block on disk I/O. This is a
+                                 * hint only, hence failures are ignored. */
+                                fd = openat(dirfd(d), de->d_name, O_RDONLY|O_CLOEXEC|O_NOCTTY|O_NONBLOCK);
+                                if (fd >= 0)
+                                        (void) posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+
                         } else if (de->d_type == DT_DIR) {
 
                                 if (!paths) /* Skip directories early unless path_cache is requested */
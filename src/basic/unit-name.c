@@ -1,6 +1,7 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
 #include <errno.h>
+#include <limits.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -323,6 +324,41 @@ static char *do_escape(const char *f, char *t) {
         return t;
 }
 
+static char *do_escape_n(const char *f, char *t, size_t n) {
+        const char *end;
+
+        assert(f);
+        assert(t);
+
+        /* Like do_escape(), but writes at most n bytes, returning NULL if the escaped form doesn't fit */
+
+        end = t + n;
+
+        if (*f == '.') {
+                if (end - t < 4)
+                        return NULL;
+                t = do_escape_char(*f, t);
+                f++;
+        }
+
+        for (; *f; f++)
+                if (*f == '/') {
+                        if (t >= end)
+                                return NULL;
+                        *(t++) = '-';
+                } else if (IN_SET(*f, '-', '\\') || !strchr(VALID_CHARS, *f)) {
+                        if (end - t < 4)
+                                return NULL;
+                        t = do_escape_char(*f, t);
+                } else {
+                        if (t >= end)
+                                return NULL;
+                        *(t++) = *f;
+                }
+
+        return t;
+}
+
 char *unit_name_escape(const char *f) {
         char *r, *t;
 
@@ -507,33 +543,81 @@ int unit_name_template(const char *f, char **ret) {
         return 0;
 }
 
-int unit_name_from_path(const char *path, const char *suffix, char **ret) {
-        _cleanup_free_ char *p = NULL, *s = NULL;
-        int r;
+int unit_name_from_path_buf(const char *path, const char *suffix, char *buf, size_t buflen) {
+        char p[PATH_MAX];
+        const char *f;
+        size_t sl;
+        char *t;
 
         assert(path);
         assert(suffix);
-        assert(ret);
+        assert(buf);
+
+        /* Like unit_name_from_path(), but escapes into a caller supplied buffer, without allocating any
+         * memory. Useful on hot paths, such as the per-line processing of /proc/self/mountinfo. */
 
         if (!unit_suffix_is_valid(suffix))
                 return -EINVAL;
 
-        r = unit_name_path_escape(path, &p);
-        if (r < 0)
-                return r;
+        /* We need a mutable copy for path_simplify(). A path that doesn't fit into PATH_MAX can't be
+         * operated on by the kernel anyway, and couldn't result in a valid unit name either, as escaping
+         * only ever makes strings longer. */
+        if (strlen(path) >= sizeof(p))
+                return -ENAMETOOLONG;
 
-        s = strjoin(p, suffix);
-        if (!s)
-                return -ENOMEM;
+        strcpy(p, path);
+        path_simplify(p);
 
-        if (strlen(s) >= UNIT_NAME_MAX) /* Return a slightly more descriptive error for this specific condition */
+        sl = strlen(suffix);
+        if (buflen < sl + 2) /* Space for at least one escaped character, the suffix and NUL */
+                return -ENAMETOOLONG;
+
+        if (empty_or_root(p)) {
+                buf[0] = '-';
+                t = buf + 1;
+        } else {
+                if (!path_is_normalized(p))
+                        return -EINVAL;
+
+                /* Truncate trailing slashes and skip leading slashes */
+                delete_trailing_chars(p, "/");
+                f = skip_leading_chars(p, "/");
+
+                t = do_escape_n(f, buf, buflen - sl - 1);
+                if (!t)
+                        return -ENAMETOOLONG;
+        }
+
+        strcpy(t, suffix);
+
+        if ((size_t) (t - buf) + sl >= UNIT_NAME_MAX) /* Return a slightly more descriptive error for this specific condition */
                 return -ENAMETOOLONG;
 
         /* Refuse if this for some other reason didn't result in a valid name */
-        if (!unit_name_is_valid(s, UNIT_NAME_PLAIN))
+        if (!unit_name_is_valid(buf, UNIT_NAME_PLAIN))
                 return -EINVAL;
 
-        *ret = TAKE_PTR(s);
+        return 0;
+}
+
+int unit_name_from_path(const char *path, const char *suffix, char **ret) {
+        char buf[UNIT_NAME_MAX];
+        char *s;
+        int r;
+
+        assert(path);
+        assert(suffix);
+        assert(ret);
+
+        r = unit_name_from_path_buf(path, suffix, buf, sizeof(buf));
+        if (r < 0)
+                return r;
+
+        s = strdup(buf);
+        if (!s)
+                return -ENOMEM;
+
+        *ret = s;
         return 0;
 }
 
@@ -45,6 +45,7 @@ int unit_name_replace_instance(const char *f, const char *i, char **ret);
 int unit_name_template(const char *f, char **ret);
 
 int unit_name_from_path(const char *path, const char *suffix, char **ret);
+int unit_name_from_path_buf(const char *path, const char *suffix, char *buf, size_t buflen);
 int unit_name_from_path_instance(const char *prefix, const char *path, const char *suffix, char **ret);
 int unit_name_to_path(const char *name, char **ret);
 
@@ -157,8 +157,16 @@ char *utf8_is_valid_n(const char *str, size_t len_bytes) {
         for (const char *p = str; len_bytes != SIZE_MAX ? (size_t) (p - str) < len_bytes : *p != '\0'; ) {
                 int len;
 
-                if (_unlikely_(*p == '\0') && len_bytes != SIZE_MAX)
-                        return NULL; /* embedded NUL */
+                /* ASCII is by far the common case in the strings we validate (unit names, journal
+                 * fields, …), so skip over it with a tight loop before bothering with the full
+                 * multi-byte decoding. This loop is trivial enough for compilers to vectorize. */
+                if ((uint8_t) *p < 0x80) {
+                        if (_unlikely_(*p == '\0') && len_bytes != SIZE_MAX)
+                                return NULL; /* embedded NUL */
+
+                        p++;
+                        continue;
+                }
 
                 len = utf8_encoded_valid_unichar(p,
                                                  len_bytes != SIZE_MAX ? len_bytes - (p - str) : SIZE_MAX);
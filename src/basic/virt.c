@@ -424,12 +424,29 @@ static int detect_vm_zvm(void) {
 /* Returns a short identifier for the various VM implementations */
 int detect_vm(void) {
         static thread_local int cached_found = _VIRTUALIZATION_INVALID;
+        _cleanup_free_ char *m = NULL;
         bool other = false;
         int r, dmi, xen_dom0 = 0;
 
         if (cached_found >= 0)
                 return cached_found;
 
+        /* PID 1 drops the result of its own detection in a file in /run, so that the CPUID/DMI/sysfs
+         * probing below doesn't have to be repeated in every process that asks. Only root can create files
+         * in /run/systemd/, hence this is as trustworthy as probing ourselves. If the file doesn't exist
+         * (e.g. very early boot, or PID 1 isn't systemd) we fall back to the full detection. */
+        r = read_one_line_file("/run/systemd/virtualization", &m);
+        if (r > 0) {
+                r = virtualization_from_string(m);
+                if (r >= 0 && (r == VIRTUALIZATION_NONE || VIRTUALIZATION_IS_VM(r))) {
+                        cached_found = r;
+                        return r;
+                }
+
+                log_debug("Unexpected virtualization identifier '%s' in /run/systemd/virtualization, ignoring.", m);
+        } else if (!IN_SET(r, -ENOENT, 0))
+                log_debug_errno(r, "Failed to read /run/systemd/virtualization, ignoring: %m");
+
         /* We have to use the correct order here:
          *
          * → First, try to detect Oracle Virtualbox and Amazon EC2 Nitro, even if they use KVM, as well as Xen even if
@@ -579,14 +579,34 @@ static EFI_STATUS reboot_into_firmware(void) {
         return log_error_status_stall(err, L"Error calling ResetSystem: %r", err);
 }
 
+static EFI_STATUS image_load(
+                EFI_HANDLE parent_image,
+                const ConfigEntry *entry,
+                EFI_HANDLE *ret_image) {
+
+        _cleanup_freepool_ EFI_DEVICE_PATH *path = NULL;
+
+        assert(entry);
+        assert(ret_image);
+
+        path = FileDevicePath(entry->device, entry->loader);
+        if (!path)
+                return EFI_INVALID_PARAMETER;
+
+        return BS->LoadImage(FALSE, parent_image, path, NULL, 0, ret_image);
+}
+
 static BOOLEAN menu_run(
                 Config *config,
                 ConfigEntry **chosen_entry,
-                CHAR16 *loaded_image_path) {
+                CHAR16 *loaded_image_path,
+                EFI_HANDLE parent_image,
+                EFI_HANDLE *ret_preloaded_image) {
 
         assert(config);
         assert(chosen_entry);
         assert(loaded_image_path);
+        assert(ret_preloaded_image);
 
         EFI_STATUS err;
         UINTN visible_max = 0;
@@ -604,6 +624,9 @@ static BOOLEAN menu_run(
         BOOLEAN exit = FALSE, run = TRUE, firmware_setup = FALSE;
         INT64 console_mode_initial = ST->ConOut->Mode->Mode, console_mode_efivar_saved = config->console_mode_efivar;
         UINTN default_efivar_saved = config->idx_default_efivar;
+        EFI_HANDLE preloaded_image = NULL;
+        UINTN idx_preloaded = IDX_INVALID;
+        BOOLEAN preload_attempted = FALSE;
 
         graphics_mode(FALSE);
         ST->ConIn->Reset(ST->ConIn, FALSE);
@@ -749,6 +772,19 @@ static BOOLEAN menu_run(
                         continue;
                 if (err == EFI_TIMEOUT) {
                         assert(timeout_remain > 0);
+
+                        /* The user is letting the countdown run. Preload the highlighted entry now so
+                         * that it starts instantly once the timeout expires. Keys pressed during the
+                         * (possibly slow) load are buffered by the firmware and processed right after. */
+                        if (!preload_attempted) {
+                                ConfigEntry *e = config->entries[idx_highlight];
+
+                                preload_attempted = TRUE;
+                                if (e->loader && !e->call &&
+                                    !EFI_ERROR(image_load(parent_image, e, &preloaded_image)))
+                                        idx_preloaded = idx_highlight;
+                        }
+
                         timeout_remain--;
                         if (timeout_remain == 0) {
                                 exit = TRUE;
@@ -977,6 +1013,14 @@ static BOOLEAN menu_run(
 
         *chosen_entry = config->entries[idx_highlight];
 
+        /* Hand the preloaded image over if it is the one that was chosen, otherwise discard it. */
+        if (preloaded_image) {
+                if (run && idx_preloaded == idx_highlight)
+                        *ret_preloaded_image = preloaded_image;
+                else
+                        (void) BS->UnloadImage(preloaded_image);
+        }
+
         /* Update EFI vars after we left the menu to reduce NVRAM writes. */
 
         if (default_efivar_saved != config->idx_default_efivar)
@@ -1352,6 +1396,15 @@ static void config_entry_bump_counters(ConfigEntry *entry, EFI_FILE *root_dir) {
         assert(entry);
         assert(root_dir);
 
+        /* The tries-left/tries-done counters are part of the file name on purpose: a boot attempt must be
+         * recorded durably *before* control is handed to the kernel, or a crash would not be counted, and
+         * on FAT a rename is a single directory entry rewrite — the cheapest durable update there is. Any
+         * scheme with a separate counter file would pay the same directory entry write (for the mtime)
+         * plus a data cluster write, and EFI variables would shift the wear to NVRAM, which tolerates far
+         * fewer write cycles than any eMMC. Also note that this runs only while an entry is being
+         * assessed; once systemd-bless-boot(8) has removed the counters from the name, boots are
+         * rename-free. */
+
         if (entry->tries_left == UINTN_MAX)
                 return;
 
@@ -2265,11 +2318,11 @@ static EFI_STATUS image_start(
                 EFI_FILE *root_dir,
                 EFI_HANDLE parent_image,
                 const Config *config,
-                const ConfigEntry *entry) {
+                const ConfigEntry *entry,
+                EFI_HANDLE preloaded_image) {
 
         _cleanup_(devicetree_cleanup) struct devicetree_state dtstate = {};
         EFI_HANDLE image;
-        _cleanup_freepool_ EFI_DEVICE_PATH *path = NULL;
         CHAR16 *options;
         EFI_STATUS err;
 
@@ -2280,13 +2333,14 @@ static EFI_STATUS image_start(
         if (entry->call)
                 (void) entry->call();
 
-        path = FileDevicePath(entry->device, entry->loader);
-        if (!path)
-                return log_error_status_stall(EFI_INVALID_PARAMETER, L"Error getting device path.");
-
-        err = BS->LoadImage(FALSE, parent_image, path, NULL, 0, &image);
-        if (EFI_ERROR(err))
-                return log_error_status_stall(err, L"Error loading %s: %r", entry->loader, err);
+        if (preloaded_image)
+                /* The menu already loaded this entry while its timeout was running. */
+                image = preloaded_image;
+        else {
+                err = image_load(parent_image, entry, &image);
+                if (EFI_ERROR(err))
+                        return log_error_status_stall(err, L"Error loading %s: %r", entry->loader, err);
+        }
 
         if (entry->devicetree) {
                 err = devicetree_install(&dtstate, root_dir, entry->devicetree);
@@ -2545,11 +2599,12 @@ EFI_STATUS efi_main(EFI_HANDLE image, EFI_SYSTEM_TABLE *sys_table) {
 
         for (;;) {
                 ConfigEntry *entry;
+                EFI_HANDLE preloaded_image = NULL;
 
                 entry = config.entries[config.idx_default];
                 if (menu) {
                         efivar_set_time_usec(LOADER_GUID, L"LoaderTimeMenuUSec", 0);
-                        if (!menu_run(&config, &entry, loaded_image_path))
+                        if (!menu_run(&config, &entry, loaded_image_path, image, &preloaded_image))
                                 break;
                 }
 
@@ -2566,7 +2621,7 @@ EFI_STATUS efi_main(EFI_HANDLE image, EFI_SYSTEM_TABLE *sys_table) {
                 /* Optionally, read a random seed off the ESP and pass it to the OS */
                 (void) process_random_seed(root_dir, config.random_seed_mode);
 
-                err = image_start(root_dir, image, &config, entry);
+                err = image_start(root_dir, image, &config, entry, preloaded_image);
                 if (EFI_ERROR(err)) {
                         graphics_mode(FALSE);
                         log_error_stall(L"Failed to execute %s (%s): %r", entry->title_show, entry->loader, err);
@@ -34,6 +34,8 @@
 #include "verbs.h"
 #include "version.h"
 
+#define CAPTURE_BUFFER_SIZE (1024U*1024U)
+
 static JsonFormatFlags arg_json_format_flags = JSON_FORMAT_OFF;
 static PagerFlags arg_pager_flags = 0;
 static bool arg_legend = true;
@@ -1204,7 +1206,7 @@ static int message_json(sd_bus_message *m, FILE *f) {
         return 0;
 }
 
-static int monitor(int argc, char **argv, int (*dump)(sd_bus_message *m, FILE *f)) {
+static int monitor(int argc, char **argv, int (*dump)(sd_bus_message *m, FILE *f), bool buffered) {
         _cleanup_(sd_bus_flush_close_unrefp) sd_bus *bus = NULL;
         _cleanup_(sd_bus_message_unrefp) sd_bus_message *message = NULL;
         _cleanup_(sd_bus_error_free) sd_bus_error error = SD_BUS_ERROR_NULL;
@@ -1307,7 +1309,11 @@ static int monitor(int argc, char **argv, int (*dump)(sd_bus_message *m, FILE *f
 
                 if (m) {
                         dump(m, stdout);
-                        fflush(stdout);
+
+                        /* In buffered mode delay flushing until the bus goes idle, so that we spend our
+                         * time dequeuing messages rather than on write() during bursts. */
+                        if (!buffered)
+                                fflush(stdout);
 
                         if (sd_bus_message_is_signal(m, "org.freedesktop.DBus.Local", "Disconnected") > 0) {
                                 log_info("Connection terminated, exiting.");
@@ -1320,6 +1326,9 @@ static int monitor(int argc, char **argv, int (*dump)(sd_bus_message *m, FILE *f
                 if (r > 0)
                         continue;
 
+                if (buffered)
+                        fflush(stdout);
+
                 r = sd_bus_wait(bus, UINT64_MAX);
                 if (r < 0)
                         return log_error_errno(r, "Failed to wait for bus: %m");
@@ -1327,7 +1336,7 @@ static int monitor(int argc, char **argv, int (*dump)(sd_bus_message *m, FILE *f
 }
 
 static int verb_monitor(int argc, char **argv, void *userdata) {
-        return monitor(argc, argv, (arg_json_format_flags & JSON_FORMAT_OFF) ? message_dump : message_json);
+        return monitor(argc, argv, (arg_json_format_flags & JSON_FORMAT_OFF) ? message_dump : message_json, /* buffered= */ false);
 }
 
 static int verb_capture(int argc, char **argv, void *userdata) {
@@ -1344,9 +1353,13 @@ static int verb_capture(int argc, char **argv, void *userdata) {
         if (r < 0)
                 log_full_errno(r == -ENOENT ? LOG_DEBUG : LOG_INFO, r,
                                "Failed to read os-release file, ignoring: %m");
+        /* Use a generous stdio buffer and flush only when the bus goes idle, so that we can keep up with
+         * message storms without losing frames to blocking small write()s. */
+        (void) setvbuf(stdout, NULL, _IOFBF, CAPTURE_BUFFER_SIZE);
+
         bus_pcap_header(arg_snaplen, osname, info, stdout);
 
-        r = monitor(argc, argv, message_pcap);
+        r = monitor(argc, argv, message_pcap, /* buffered= */ true);
         if (r < 0)
                 return r;
 
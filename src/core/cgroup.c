@@ -108,10 +108,28 @@ bool unit_has_host_root_cgroup(Unit *u) {
 static int set_attribute_and_warn(Unit *u, const char *controller, const char *attribute, const char *value) {
         int r;
 
+        /* Skip the write if this is the very value we wrote last time. Slice-wide configuration changes
+         * invalidate whole controller masks on a lot of units at once, but typically most attribute values
+         * are unmodified, and each write is an open/write/close cycle. The cache is flushed whenever the
+         * cgroup is created anew, since the kernel reverted all attributes to their defaults then. */
+        if (streq_ptr(hashmap_get(u->cgroup_attribute_cache, attribute), value))
+                return 0;
+
         r = cg_set_attribute(controller, u->cgroup_path, attribute, value);
         if (r < 0)
                 log_unit_full_errno(u, LOG_LEVEL_CGROUP_WRITE(r), r, "Failed to set '%s' attribute on '%s' to '%.*s': %m",
                                     strna(attribute), empty_to_root(u->cgroup_path), (int) strcspn(value, NEWLINE), value);
+        else {
+                _cleanup_free_ char *a = strdup(attribute), *v = strdup(value), *old_key = NULL, *old_value = NULL;
+
+                old_value = hashmap_remove2(u->cgroup_attribute_cache, attribute, (void**) &old_key);
+
+                /* If caching fails we'll simply write the attribute again next time */
+                if (a && v && hashmap_ensure_put(&u->cgroup_attribute_cache, &string_hash_ops_free_free, a, v) >= 0) {
+                        TAKE_PTR(a);
+                        TAKE_PTR(v);
+                }
+        }
 
         return r;
 }
@@ -281,13 +299,91 @@ void cgroup_context_done(CGroupContext *c) {
         cpu_set_reset(&c->startup_cpuset_mems);
 }
 
+static int unit_open_cgroup_dir(Unit *u) {
+        _cleanup_free_ char *p = NULL;
+        int r;
+
+        assert(u);
+
+        /* Opens (and caches) an O_PATH fd of the unit's cgroup directory on the unified hierarchy, so
+         * that repeated attribute reads need neither path construction nor a full path lookup each
+         * time. The fd is invalidated whenever the cgroup is released or pruned. */
+
+        if (u->cgroup_dir_fd >= 0)
+                return u->cgroup_dir_fd;
+
+        if (!u->cgroup_path)
+                return -ENODATA;
+
+        r = cg_get_path(SYSTEMD_CGROUP_CONTROLLER, u->cgroup_path, NULL, &p);
+        if (r < 0)
+                return r;
+
+        u->cgroup_dir_fd = open(p, O_DIRECTORY|O_PATH|O_CLOEXEC);
+        if (u->cgroup_dir_fd < 0)
+                return -errno;
+
+        return u->cgroup_dir_fd;
+}
+
+static int unit_get_cgroup_attribute_as_uint64(Unit *u, const char *controller, const char *attribute, uint64_t *ret) {
+        _cleanup_free_ char *value = NULL;
+        int fd, r;
+
+        assert(u);
+        assert(attribute);
+        assert(ret);
+
+        /* Like cg_get_attribute_as_uint64(), but on the unified hierarchy reads through the cached
+         * directory fd of the unit's cgroup, so that bulk property queries touching many attributes (or
+         * many units) don't pay for a path resolution per read. */
+
+        r = cg_all_unified();
+        if (r < 0)
+                return r;
+        if (r == 0)
+                return cg_get_attribute_as_uint64(controller, u->cgroup_path, attribute, ret);
+
+        fd = unit_open_cgroup_dir(u);
+        if (fd < 0)
+                return fd == -ENOENT ? -ENODATA : fd;
+
+        r = read_virtual_file_at(fd, attribute, SIZE_MAX, &value, NULL);
+        if (r == -ENOENT)
+                return -ENODATA;
+        if (r < 0)
+                return r;
+
+        truncate_nl(value);
+
+        if (streq(value, "max")) {
+                *ret = CGROUP_LIMIT_MAX;
+                return 0;
+        }
+
+        return safe_atou64(value, ret);
+}
+
+static int unit_get_unified_keyed_attribute(Unit *u, const char *attribute, char **keys, char **ret_values) {
+        int fd;
+
+        assert(u);
+        assert(attribute);
+
+        fd = unit_open_cgroup_dir(u);
+        if (fd < 0)
+                return fd;
+
+        return cg_get_keyed_attribute_at(fd, attribute, keys, ret_values);
+}
+
 static int unit_get_kernel_memory_limit(Unit *u, const char *file, uint64_t *ret) {
         assert(u);
 
         if (!u->cgroup_realized)
                 return -EOWNERDEAD;
 
-        return cg_get_attribute_as_uint64("memory", u->cgroup_path, file, ret);
+        return unit_get_cgroup_attribute_as_uint64(u, "memory", file, ret);
 }
 
 static int unit_compare_memory_limit(Unit *u, const char *property_name, uint64_t *ret_unit_value, uint64_t *ret_kernel_value) {
@@ -2152,6 +2248,11 @@ static int unit_update_cgroup(
                 return log_unit_error_errno(u, r, "Failed to create cgroup %s: %m", empty_to_root(u->cgroup_path));
         created = r;
 
+        /* A freshly created cgroup carries the kernel's default attribute values, hence forget what we wrote
+         * into a previous incarnation of it */
+        if (created)
+                u->cgroup_attribute_cache = hashmap_free(u->cgroup_attribute_cache);
+
         if (cg_unified_controller(SYSTEMD_CGROUP_CONTROLLER) > 0) {
                 uint64_t cgroup_id = 0;
 
@@ -2719,6 +2820,9 @@ void unit_release_cgroup(Unit *u) {
                 u->cgroup_path = mfree(u->cgroup_path);
         }
 
+        u->cgroup_dir_fd = safe_close(u->cgroup_dir_fd);
+        u->cgroup_attribute_cache = hashmap_free(u->cgroup_attribute_cache);
+
         if (u->cgroup_control_inotify_wd >= 0) {
                 if (inotify_rm_watch(u->manager->cgroup_inotify_fd, u->cgroup_control_inotify_wd) < 0)
                         log_unit_debug_errno(u, errno, "Failed to remove cgroup control inotify watch %i for %s, ignoring: %m", u->cgroup_control_inotify_wd, u->id);
@@ -2787,6 +2891,9 @@ void unit_prune_cgroup(Unit *u) {
                  * on error, continue cleanup. */
                 log_unit_full_errno(u, r == -EBUSY ? LOG_DEBUG : LOG_WARNING, r, "Failed to destroy cgroup %s, ignoring: %m", empty_to_root(u->cgroup_path));
 
+        /* The cgroup directory is gone (or at least scheduled for removal), don't keep an fd of it around */
+        u->cgroup_dir_fd = safe_close(u->cgroup_dir_fd);
+
         if (is_root_slice)
                 return;
 
@@ -3072,7 +3179,7 @@ int unit_check_oom(Unit *u) {
         if (!u->cgroup_path)
                 return 0;
 
-        r = cg_get_keyed_attribute("memory", u->cgroup_path, "memory.events", STRV_MAKE("oom_kill"), &oom_kill);
+        r = unit_get_unified_keyed_attribute(u, "memory.events", STRV_MAKE("oom_kill"), &oom_kill);
         if (IN_SET(r, -ENOENT, -ENXIO)) /* Handle gracefully if cgroup or oom_kill attribute don't exist */
                 c = 0;
         else if (r < 0)
@@ -3590,7 +3697,7 @@ int unit_get_memory_available(Unit *u, uint64_t *ret) {
                 return r;
         memory_file = r > 0 ? "memory.current" : "memory.usage_in_bytes";
 
-        r = cg_get_attribute_as_uint64("memory", u->cgroup_path, memory_file, &unit_current);
+        r = unit_get_cgroup_attribute_as_uint64(u, "memory", memory_file, &unit_current);
         if (r < 0)
                 return r;
 
@@ -3617,7 +3724,7 @@ int unit_get_memory_available(Unit *u, uint64_t *ret) {
                 if (slice_context->memory_max == UINT64_MAX && slice_context->memory_high == UINT64_MAX)
                         continue;
 
-                r = cg_get_attribute_as_uint64("memory", slice->cgroup_path, memory_file, &slice_current);
+                r = unit_get_cgroup_attribute_as_uint64(slice, "memory", memory_file, &slice_current);
                 if (r < 0)
                         continue;
 
@@ -3653,7 +3760,7 @@ int unit_get_memory_current(Unit *u, uint64_t *ret) {
         if (r < 0)
                 return r;
 
-        return cg_get_attribute_as_uint64("memory", u->cgroup_path, r > 0 ? "memory.current" : "memory.usage_in_bytes", ret);
+        return unit_get_cgroup_attribute_as_uint64(u, "memory", r > 0 ? "memory.current" : "memory.usage_in_bytes", ret);
 }
 
 int unit_get_tasks_current(Unit *u, uint64_t *ret) {
@@ -3673,7 +3780,7 @@ int unit_get_tasks_current(Unit *u, uint64_t *ret) {
         if ((u->cgroup_realized_mask & CGROUP_MASK_PIDS) == 0)
                 return -ENODATA;
 
-        return cg_get_attribute_as_uint64("pids", u->cgroup_path, "pids.current", ret);
+        return unit_get_cgroup_attribute_as_uint64(u, "pids", "pids.current", ret);
 }
 
 static int unit_get_cpu_usage_raw(Unit *u, nsec_t *ret) {
@@ -3701,7 +3808,7 @@ static int unit_get_cpu_usage_raw(Unit *u, nsec_t *ret) {
                 _cleanup_free_ char *val = NULL;
                 uint64_t us;
 
-                r = cg_get_keyed_attribute("cpu", u->cgroup_path, "cpu.stat", STRV_MAKE("usage_usec"), &val);
+                r = unit_get_unified_keyed_attribute(u, "cpu.stat", STRV_MAKE("usage_usec"), &val);
                 if (IN_SET(r, -ENOENT, -ENXIO))
                         return -ENODATA;
                 if (r < 0)
@@ -3802,9 +3909,8 @@ static int unit_get_io_accounting_raw(Unit *u, uint64_t ret[static _CGROUP_IO_AC
                 [CGROUP_IO_WRITE_OPERATIONS] = "wios=",
         };
         uint64_t acc[_CGROUP_IO_ACCOUNTING_METRIC_MAX] = {};
-        _cleanup_free_ char *path = NULL;
         _cleanup_fclose_ FILE *f = NULL;
-        int r;
+        int fd, r;
 
         assert(u);
 
@@ -3823,11 +3929,15 @@ static int unit_get_io_accounting_raw(Unit *u, uint64_t ret[static _CGROUP_IO_AC
         if (!FLAGS_SET(u->cgroup_realized_mask, CGROUP_MASK_IO))
                 return -ENODATA;
 
-        r = cg_get_path("io", u->cgroup_path, "io.stat", &path);
-        if (r < 0)
-                return r;
+        fd = unit_open_cgroup_dir(u);
+        if (fd < 0)
+                return fd;
+
+        fd = openat(fd, "io.stat", O_RDONLY|O_CLOEXEC|O_NOCTTY);
+        if (fd < 0)
+                return -errno;
 
-        f = fopen(path, "re");
+        f = take_fdopen(&fd, "r");
         if (!f)
                 return -errno;
 
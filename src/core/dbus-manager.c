@@ -205,6 +205,24 @@ static int property_get_progress(
         return sd_bus_message_append(reply, "d", d);
 }
 
+static int property_get_dispatch_latency_histogram(
+                sd_bus *bus,
+                const char *path,
+                const char *interface,
+                const char *property,
+                sd_bus_message *reply,
+                void *userdata,
+                sd_bus_error *error) {
+
+        Manager *m = userdata;
+
+        assert(bus);
+        assert(reply);
+        assert(m);
+
+        return sd_bus_message_append_array(reply, 't', m->dispatch_latency_histogram, sizeof(m->dispatch_latency_histogram));
+}
+
 static int property_get_environment(
                 sd_bus *bus,
                 const char *path,
@@ -968,13 +986,26 @@ static int transient_unit_from_message(
                                          "Unit type %s does not support transient units.",
                                          unit_type_to_string(t));
 
-        r = manager_load_unit(m, name, NULL, error, &u);
-        if (r < 0)
-                return r;
+        /* A transient unit may only be created under a name that is not already in use. For most unit
+         * types we establish that by loading the unit from disk first and checking that it came up
+         * pristine. Scope units however never load anything from disk — scope_load() refuses on-disk
+         * fragments — hence for them that initial load pass is a guaranteed no-op that exists only to
+         * detect collisions, and if the name isn't registered yet we can create the stub directly. At
+         * high scope turnover (one scope per session or app) this saves a full load queue dispatch per
+         * creation. */
+        if (t == UNIT_SCOPE && !manager_get_unit(m, name)) {
+                r = manager_load_unit_prepare(m, name, NULL, error, &u);
+                if (r < 0)
+                        return r;
+        } else {
+                r = manager_load_unit(m, name, NULL, error, &u);
+                if (r < 0)
+                        return r;
 
-        if (!unit_is_pristine(u))
-                return sd_bus_error_setf(error, BUS_ERROR_UNIT_EXISTS,
-                                         "Unit %s already exists.", name);
+                if (!unit_is_pristine(u))
+                        return sd_bus_error_setf(error, BUS_ERROR_UNIT_EXISTS,
+                                                 "Unit %s already exists.", name);
+        }
 
         /* OK, the unit failed to load and is unreferenced, now let's
          * fill in the transient data instead */
@@ -1043,6 +1074,15 @@ static int transient_aux_units_from_message(
         return 0;
 }
 
+/* Note on the cost of transient units: every invocation allocates a fresh unit, cgroup and (for services) a
+ * forked child, which adds up for callers that issue transient runs in a tight loop. Keeping a pool of
+ * pre-created "warm" service slots to hand out has been considered and rejected: the unit name, its cgroup
+ * and the sandbox set up from its properties are the security and accounting boundary, so a recycled slot
+ * would have to be torn down to exactly the same degree as a fresh unit once properties (User=, delegated
+ * cgroup controllers, namespace options, …) differ between requests — which is the common case — and any
+ * state surviving recycling would leak across requests with different credentials. Callers that need
+ * high-frequency dispatching are better served by one transient unit hosting a worker that accepts work
+ * over its own IPC than by a transient unit per work item. */
 static int method_start_transient_unit(sd_bus_message *message, void *userdata, sd_bus_error *error) {
         const char *name, *smode;
         Manager *m = userdata;
@@ -1198,6 +1238,17 @@ static int list_units_filtered(sd_bus_message *message, void *userdata, sd_bus_e
         if (r < 0)
                 return r;
 
+        /* Each record takes a couple of hundred bytes on the wire. Pre-allocate the reply body in one go
+         * instead of growing it piecemeal while iterating through a possibly five-digit number of units.
+         * This is only a hint, hence a rough estimate is good enough — but don't apply it to filtered
+         * queries, which typically match only a handful of units (think state=failed) and would
+         * otherwise allocate megabytes for a reply of a few kilobytes. */
+        if (strv_isempty(states) && strv_isempty(patterns)) {
+                r = sd_bus_message_reserve(reply, hashmap_size(m->units) * 300);
+                if (r < 0)
+                        return r;
+        }
+
         r = sd_bus_message_open_container(reply, 'a', "(ssssssouso)");
         if (r < 0)
                 return r;
@@ -2761,6 +2812,8 @@ const sd_bus_vtable bus_manager_vtable[] = {
         SD_BUS_PROPERTY("NInstalledJobs", "u", bus_property_get_unsigned, offsetof(Manager, n_installed_jobs), 0),
         SD_BUS_PROPERTY("NFailedJobs", "u", bus_property_get_unsigned, offsetof(Manager, n_failed_jobs), 0),
         SD_BUS_PROPERTY("Progress", "d", property_get_progress, 0, 0),
+        SD_BUS_PROPERTY("DispatchLatencyMaxUSec", "t", bus_property_get_usec, offsetof(Manager, dispatch_latency_max), 0),
+        SD_BUS_PROPERTY("DispatchLatencyHistogram", "at", property_get_dispatch_latency_histogram, 0, 0),
         SD_BUS_PROPERTY("Environment", "as", property_get_environment, 0, 0),
         SD_BUS_PROPERTY("ConfirmSpawn", "b", bus_property_get_bool, offsetof(Manager, confirm_spawn), SD_BUS_VTABLE_PROPERTY_CONST),
         SD_BUS_PROPERTY("ShowStatus", "b", property_get_show_status, 0, 0),
@@ -482,6 +482,12 @@ static const BusObjectImplementation unit_object = {
         .fallback_vtables = BUS_FALLBACK_VTABLES(
                 { bus_unit_vtable,        bus_unit_find }),
         .node_enumerator = bus_unit_enumerate,
+
+        /* Export org.freedesktop.DBus.ObjectManager on the unit hierarchy, so that monitoring clients can
+         * take a snapshot of all units' properties with a single GetManagedObjects() call instead of
+         * issuing GetAll() once per unit. Note that we do not send out InterfacesAdded/InterfacesRemoved
+         * signals for this, clients should continue to watch UnitNew/UnitRemoved. */
+        .manager = true,
 };
 
 static const BusObjectImplementation bus_automount_object = {
@@ -730,7 +736,11 @@ static int bus_on_connection(sd_event_source *s, int fd, uint32_t revents, void
                 return 0;
         }
 
-        r = sd_bus_attach_event(bus, m->event, SD_EVENT_PRIORITY_NORMAL);
+        /* Direct connections only carry traffic from privileged clients (see the peer credential check
+         * above), i.e. the systemctl start/stop control path. Dispatch them ahead of the API bus, so that
+         * a monitoring scrape flooding the broker connection with introspection calls cannot delay
+         * control operations and their job-completion replies. */
+        r = sd_bus_attach_event(bus, m->event, SD_EVENT_PRIORITY_NORMAL-1);
         if (r < 0) {
                 log_warning_errno(r, "Failed to attach new connection bus to event loop: %m");
                 return 0;
@@ -31,6 +31,8 @@ static const UnitActiveState state_translation_table[_DEVICE_STATE_MAX] = {
 
 static int device_dispatch_io(sd_device_monitor *monitor, sd_device *dev, void *userdata);
 static void device_update_found_one(Device *d, DeviceFound found, DeviceFound mask);
+static int device_setup_unit(Manager *m, sd_device *dev, const char *path, bool main);
+static bool device_is_ready(sd_device *dev);
 
 static void device_unset_sysfs(Device *d) {
         Hashmap *devices;
@@ -132,6 +134,41 @@ static int device_load(Unit *u) {
                         log_unit_debug_errno(u, r, "Failed to unescape name: %m");
         }
 
+        /* Units for device nodes and their symlinks are only instantiated for names some other unit
+         * references, see device_setup_extra_unit(). Hence, if we are loaded because somebody just started
+         * referencing us, the device might very well be around already — catch up with it. */
+        if (!DEVICE(u)->sysfs) {
+                _cleanup_(sd_device_unrefp) sd_device *dev = NULL;
+                _cleanup_free_ char *path = NULL;
+
+                r = unit_name_to_path(u->id, &path);
+                if (r < 0) {
+                        log_unit_debug_errno(u, r, "Failed to convert unit name to device path, ignoring: %m");
+                        return 0;
+                }
+
+                if (path_startswith(path, "/dev/")) {
+                        struct stat st;
+
+                        if (stat(path, &st) < 0 || (!S_ISBLK(st.st_mode) && !S_ISCHR(st.st_mode)))
+                                return 0;
+
+                        r = sd_device_new_from_stat_rdev(&dev, &st);
+                } else if (path_startswith(path, "/sys/"))
+                        r = sd_device_new_from_syspath(&dev, path);
+                else
+                        r = -ENODEV;
+                if (r < 0) /* Not plugged in right now? That's entirely expected, device_dispatch_io() will
+                            * pick the unit up once the device shows up. */
+                        return 0;
+
+                if (!device_is_ready(dev))
+                        return 0;
+
+                (void) device_setup_unit(u->manager, dev, path, false);
+                device_update_found_one(DEVICE(u), DEVICE_FOUND_UDEV, DEVICE_FOUND_UDEV);
+        }
+
         return 0;
 }
 
@@ -594,6 +631,29 @@ fail:
         return r;
 }
 
+static int device_setup_extra_unit(Manager *m, sd_device *dev, const char *path) {
+        char name[UNIT_NAME_MAX];
+        int r;
+
+        assert(m);
+        assert(dev);
+        assert(path);
+
+        /* The extra units for the device node and its symlinks exist purely as dependency anchors for other
+         * units. On big storage boxes the vast majority of them is never referenced by anything, hence
+         * don't instantiate them eagerly here, but only if some other unit already refers to the name.
+         * Units that start referencing a name only later catch up with the device in device_load(). */
+
+        r = unit_name_from_path_buf(path, ".device", name, sizeof(name));
+        if (r < 0)
+                return r;
+
+        if (!manager_get_unit(m, name))
+                return 0;
+
+        return device_setup_unit(m, dev, path, false);
+}
+
 static void device_process_new(Manager *m, sd_device *dev) {
         const char *sysfs, *dn, *alias;
         dev_t devnum;
@@ -610,9 +670,9 @@ static void device_process_new(Manager *m, sd_device *dev) {
         if (device_setup_unit(m, dev, sysfs, true) < 0)
                 return;
 
-        /* Add an additional unit for the device node */
+        /* Add an additional unit for the device node, if referenced */
         if (sd_device_get_devname(dev, &dn) >= 0)
-                (void) device_setup_unit(m, dev, dn, false);
+                (void) device_setup_extra_unit(m, dev, dn);
 
         /* Add additional units for all symlinks */
         if (sd_device_get_devnum(dev, &devnum) >= 0) {
@@ -634,7 +694,7 @@ static void device_process_new(Manager *m, sd_device *dev) {
                              st.st_rdev != devnum))
                                 continue;
 
-                        (void) device_setup_unit(m, dev, p, false);
+                        (void) device_setup_extra_unit(m, dev, p);
                 }
         }
 
@@ -4,6 +4,7 @@
 #include <fcntl.h>
 #include <poll.h>
 #include <sys/eventfd.h>
+#include <sys/file.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/mount.h>
@@ -89,6 +90,7 @@
 #include "securebits-util.h"
 #include "selinux-util.h"
 #include "signal-util.h"
+#include "siphash24.h"
 #include "smack-util.h"
 #include "socket-util.h"
 #include "special.h"
@@ -100,6 +102,7 @@
 #include "terminal-util.h"
 #include "tmpfile-util.h"
 #include "umask-util.h"
+#include "unaligned.h"
 #include "unit-serialize.h"
 #include "user-util.h"
 #include "utmp-wtmp.h"
@@ -1471,6 +1474,23 @@ static bool exec_context_has_credentials(const ExecContext *context) {
                 !hashmap_isempty(context->load_credentials);
 }
 
+static bool exec_context_has_encrypted_credentials(const ExecContext *context) {
+        ExecLoadCredential *lc;
+        ExecSetCredential *sc;
+
+        assert(context);
+
+        HASHMAP_FOREACH(lc, context->load_credentials)
+                if (lc->encrypted)
+                        return true;
+
+        HASHMAP_FOREACH(sc, context->set_credentials)
+                if (sc->encrypted)
+                        return true;
+
+        return false;
+}
+
 #if HAVE_SECCOMP
 
 static bool skip_seccomp_unavailable(const Unit* u, const char* msg) {
@@ -1511,6 +1531,20 @@ static int apply_syscall_filter(const Unit* u, const ExecContext *c, bool needs_
                         return r;
         }
 
+        /* If the manager compiled this filter set before the fork() (see
+         * exec_seccomp_filter_cache_prewarm()), install the cached BPF programs directly instead of
+         * having libseccomp compile the same thing again in each spawned child. */
+        if (!hashmap_isempty(u->manager->exec_seccomp_cache)) {
+                _cleanup_free_ char *key = NULL;
+                SeccompCompiledFilter *compiled;
+
+                if (seccomp_filter_set_raw_make_key(default_action, c->syscall_filter, action, &key) >= 0) {
+                        compiled = hashmap_get(u->manager->exec_seccomp_cache, key);
+                        if (compiled)
+                                return seccomp_load_compiled_filter(compiled);
+                }
+        }
+
         return seccomp_load_syscall_filter_set_raw(default_action, c->syscall_filter, action, false);
 }
 
@@ -2599,6 +2633,158 @@ static int write_credential(
         return 0;
 }
 
+static char* credential_cache_entry(const char *id, const void *ciphertext, size_t size) {
+        static const uint8_t hash_key[16] = {
+                0x14, 0x48, 0xef, 0x5f, 0xb1, 0x5f, 0xcb, 0x93,
+                0xe5, 0x3f, 0xa8, 0x62, 0x69, 0xf6, 0x3b, 0x9e,
+        };
+        char *n;
+
+        /* Entries are named after the credential ID plus a hash of the ciphertext, so that a credential
+         * whose source changed is never answered from stale cache state. */
+
+        if (asprintf(&n, "%s.%016" PRIx64, id, siphash24(ciphertext, size, hash_key)) < 0)
+                return NULL;
+
+        return n;
+}
+
+static int open_credential_cache(const ExecParameters *params) {
+        _cleanup_close_ int lock_fd = -1;
+        _cleanup_free_ char *p = NULL;
+        int r, fd;
+
+        assert(params);
+
+        /* Opens the per-boot cache of decrypted credentials, setting it up first if necessary, and returns
+         * a directory fd to it. Decrypting a credential typically involves a TPM2 unseal operation, which
+         * takes hundreds of milliseconds on common hardware; deployments that attach the same encrypted
+         * credentials to many services would otherwise pay that price on every single service start and
+         * restart. The cache gets its own ramfs instance (so that plaintext never hits swap, same as the
+         * per-unit stores), is accessible to root only, and shares the lifecycle of /run/credentials/,
+         * i.e. of the boot. Note that for the system manager only root can define credentials, and for user
+         * managers mounting ramfs fails and the cache is simply not used, hence unprivileged users get no
+         * way to poison or read cache entries. */
+
+        if (!params->prefix[EXEC_DIRECTORY_RUNTIME])
+                return -EINVAL;
+
+        p = path_join(params->prefix[EXEC_DIRECTORY_RUNTIME], "credentials/.cache");
+        if (!p)
+                return -ENOMEM;
+
+        r = mkdir_label(p, 0700);
+        if (r < 0 && r != -EEXIST)
+                return r;
+
+        /* Concurrently started services race to set up the cache. Serialize via the underlying directory
+         * inode, so that exactly one of us mounts the ramfs. */
+        lock_fd = open(p, O_DIRECTORY|O_CLOEXEC);
+        if (lock_fd < 0)
+                return -errno;
+
+        if (flock(lock_fd, LOCK_EX) < 0)
+                return -errno;
+
+        r = path_is_mount_point(p, NULL, 0);
+        if (r < 0)
+                return r;
+        if (r == 0) {
+                r = mount_nofollow_verbose(LOG_DEBUG, "ramfs", p, "ramfs", MS_NODEV|MS_NOEXEC|MS_NOSUID, "mode=0700");
+                if (r < 0)
+                        return r;
+        }
+
+        /* Reopen, so that we get an fd to the ramfs root rather than to the directory it is mounted on */
+        fd = open(p, O_DIRECTORY|O_CLOEXEC);
+        if (fd < 0)
+                return -errno;
+
+        return fd;
+}
+
+static int decrypt_credential_cached(
+                int cache_dfd,
+                const char *id,
+                const void *data,
+                size_t size,
+                void **ret,
+                size_t *ret_size) {
+
+        _cleanup_(erase_and_freep) void *plaintext = NULL, *entry = NULL;
+        size_t plaintext_size, entry_size;
+        _cleanup_free_ char *n = NULL;
+        usec_t not_after;
+        int r;
+
+        assert(id);
+        assert(data || size == 0);
+        assert(ret);
+        assert(ret_size);
+
+        /* Cache entry files carry the credential's not-after timestamp (a little-endian 64bit µs value, as
+         * embedded in the encrypted blob) in front of the plaintext, so that expiry is enforced on cache
+         * hits just like decrypt_credential_and_warn() enforces it on actual decryption. */
+
+        if (cache_dfd >= 0) {
+                n = credential_cache_entry(id, data, size);
+                if (!n)
+                        return -ENOMEM;
+
+                r = read_full_file_full(
+                                cache_dfd, n,
+                                UINT64_MAX, CREDENTIAL_SIZE_MAX + sizeof(uint64_t),
+                                READ_FULL_FILE_SECURE,
+                                NULL,
+                                (char**) &entry, &entry_size);
+                if (r >= 0 && entry_size < sizeof(uint64_t))
+                        r = -EBADMSG;
+                if (r >= 0) {
+                        not_after = unaligned_read_le64(entry);
+
+                        if (not_after != USEC_INFINITY && not_after < now(CLOCK_REALTIME)) {
+                                /* The credential's time has passed; drop the entry and decrypt anew, so
+                                 * that caching never extends a credential's validity. */
+                                log_debug("Cached decrypted credential '%s' is expired, removing cache entry.", id);
+                                (void) unlinkat(cache_dfd, n, 0);
+                        } else {
+                                log_debug("Retrieved decrypted credential '%s' from cache.", id);
+
+                                memmove(entry, (uint8_t*) entry + sizeof(uint64_t), entry_size - sizeof(uint64_t));
+                                *ret = TAKE_PTR(entry);
+                                *ret_size = entry_size - sizeof(uint64_t);
+                                return 0;
+                        }
+                } else if (r != -ENOENT)
+                        log_debug_errno(r, "Failed to check decrypted credential cache for '%s', ignoring: %m", id);
+
+                entry = erase_and_free(entry);
+        }
+
+        r = decrypt_credential_and_warn(id, now(CLOCK_REALTIME), NULL, data, size, &plaintext, &plaintext_size, &not_after);
+        if (r < 0)
+                return r;
+
+        if (n) {
+                /* Populate the cache. Entry files are root-owned and read-only, just like the per-unit
+                 * copies. Failure to cache is no reason to fail the service. */
+                entry_size = sizeof(uint64_t) + plaintext_size;
+                entry = malloc(entry_size);
+                if (entry) {
+                        unaligned_write_le64(entry, not_after);
+                        memcpy((uint8_t*) entry + sizeof(uint64_t), plaintext, plaintext_size);
+
+                        r = write_credential(cache_dfd, n, entry, entry_size, UID_INVALID, /* ownership_ok= */ true);
+                        if (r < 0)
+                                log_debug_errno(r, "Failed to add decrypted credential '%s' to cache, ignoring: %m", id);
+                }
+        }
+
+        *ret = TAKE_PTR(plaintext);
+        *ret_size = plaintext_size;
+        return 0;
+}
+
 static int load_credential(
                 const ExecContext *context,
                 const ExecParameters *params,
@@ -2606,6 +2792,7 @@ static int load_credential(
                 const char *unit,
                 int read_dfd,
                 int write_dfd,
+                int cache_dfd,
                 uid_t uid,
                 bool ownership_ok,
                 uint64_t *left) {
@@ -2677,7 +2864,7 @@ static int load_credential(
                 _cleanup_free_ void *plaintext = NULL;
                 size_t plaintext_size = 0;
 
-                r = decrypt_credential_and_warn(lc->id, now(CLOCK_REALTIME), NULL, data, size, &plaintext, &plaintext_size);
+                r = decrypt_credential_cached(cache_dfd, lc->id, data, size, &plaintext, &plaintext_size);
                 if (r < 0)
                         return r;
 
@@ -2705,6 +2892,7 @@ struct load_cred_args {
         ExecLoadCredential *parent_local_credential;
         const char *unit;
         int dfd;
+        int cache_dfd;
         uid_t uid;
         bool ownership_ok;
         uint64_t *left;
@@ -2754,7 +2942,7 @@ static int load_cred_recurse_dir_cb(
                         .id = sub_id,
                         .path = (char *) de->d_name,
                         .encrypted = args->parent_local_credential->encrypted,
-                }, args->unit, dir_fd, args->dfd, args->uid, args->ownership_ok, args->left);
+                }, args->unit, dir_fd, args->dfd, args->cache_dfd, args->uid, args->ownership_ok, args->left);
         if (r < 0)
                 return r;
 
@@ -2770,7 +2958,7 @@ static int acquire_credentials(
                 bool ownership_ok) {
 
         uint64_t left = CREDENTIALS_TOTAL_SIZE_MAX;
-        _cleanup_close_ int dfd = -1;
+        _cleanup_close_ int dfd = -1, cache_dfd = -1;
         _cleanup_set_free_ Set *seen_creds = NULL;
         ExecLoadCredential *lc;
         ExecSetCredential *sc;
@@ -2783,6 +2971,12 @@ static int acquire_credentials(
         if (dfd < 0)
                 return -errno;
 
+        if (exec_context_has_encrypted_credentials(context)) {
+                cache_dfd = open_credential_cache(params);
+                if (cache_dfd < 0)
+                        log_debug_errno(cache_dfd, "Couldn't set up decrypted credential cache, proceeding without: %m");
+        }
+
         seen_creds = set_new(&string_hash_ops_free);
         if (!seen_creds)
                 return -ENOMEM;
@@ -2804,7 +2998,7 @@ static int acquire_credentials(
                         r = set_put_strdup(&seen_creds, lc->id);
                         if (r < 0)
                                 return r;
-                        r = load_credential(context, params, lc, unit, -1, dfd, uid, ownership_ok, &left);
+                        r = load_credential(context, params, lc, unit, -1, dfd, cache_dfd, uid, ownership_ok, &left);
                         if (r < 0)
                                 return r;
 
@@ -2823,6 +3017,7 @@ static int acquire_credentials(
                                                 .parent_local_credential = lc,
                                                 .unit = unit,
                                                 .dfd = dfd,
+                                                .cache_dfd = cache_dfd,
                                                 .uid = uid,
                                                 .ownership_ok = ownership_ok,
                                                 .left = &left,
@@ -2845,7 +3040,7 @@ static int acquire_credentials(
                         return log_debug_errno(errno, "Failed to test if credential %s exists: %m", sc->id);
 
                 if (sc->encrypted) {
-                        r = decrypt_credential_and_warn(sc->id, now(CLOCK_REALTIME), NULL, sc->data, sc->size, &plaintext, &size);
+                        r = decrypt_credential_cached(cache_dfd, sc->id, sc->data, sc->size, &plaintext, &size);
                         if (r < 0)
                                 return r;
 
@@ -4046,12 +4241,21 @@ static int exec_child(
         _cleanup_free_ gid_t *gids_after_pam = NULL;
         int ngids_after_pam = 0;
 
+        /* Opt-in instrumentation of the setup phases below, see $SYSTEMD_EXEC_TIMING handling at the
+         * bottom of this function */
+        bool exec_timing = getenv_bool("SYSTEMD_EXEC_TIMING") > 0;
+        usec_t exec_timing_start = 0, exec_timing_ts = 0,
+                exec_timing_cgroup = 0, exec_timing_namespace = 0, exec_timing_seccomp = 0;
+
         assert(unit);
         assert(command);
         assert(context);
         assert(params);
         assert(exit_status);
 
+        if (exec_timing)
+                exec_timing_start = now(CLOCK_MONOTONIC);
+
         /* Explicitly test for CVE-2021-4034 inspired invocations */
         assert(command->path);
         assert(!strv_isempty(command->argv));
@@ -4249,6 +4453,9 @@ static int exec_child(
                         return log_unit_error_errno(unit, r, "Failed to acquire cgroup path: %m");
                 }
 
+                if (exec_timing)
+                        exec_timing_ts = now(CLOCK_MONOTONIC);
+
                 r = cg_attach_everywhere(params->cgroup_supported, p, 0, NULL, NULL);
                 if (r == -EUCLEAN) {
                         *exit_status = EXIT_CGROUP;
@@ -4260,6 +4467,9 @@ static int exec_child(
                         *exit_status = EXIT_CGROUP;
                         return log_unit_error_errno(unit, r, "Failed to attach to cgroup %s: %m", p);
                 }
+
+                if (exec_timing)
+                        exec_timing_cgroup = usec_sub_unsigned(now(CLOCK_MONOTONIC), exec_timing_ts);
         }
 
         if (context->network_namespace_path && runtime && runtime->netns_storage_socket[0] >= 0) {
@@ -4614,12 +4824,18 @@ static int exec_child(
         if (needs_mount_namespace) {
                 _cleanup_free_ char *error_path = NULL;
 
+                if (exec_timing)
+                        exec_timing_ts = now(CLOCK_MONOTONIC);
+
                 r = apply_mount_namespace(unit, command->flags, context, params, runtime, &error_path);
                 if (r < 0) {
                         *exit_status = EXIT_NAMESPACE;
                         return log_unit_error_errno(unit, r, "Failed to set up mount namespacing%s%s: %m",
                                                     error_path ? ": " : "", strempty(error_path));
                 }
+
+                if (exec_timing)
+                        exec_timing_namespace = usec_sub_unsigned(now(CLOCK_MONOTONIC), exec_timing_ts);
         }
 
         if (needs_sandboxing) {
@@ -4902,6 +5118,9 @@ static int exec_child(
                         }
 
 #if HAVE_SECCOMP
+                if (exec_timing)
+                        exec_timing_ts = now(CLOCK_MONOTONIC);
+
                 r = apply_address_families(unit, context);
                 if (r < 0) {
                         *exit_status = EXIT_ADDRESS_FAMILIES;
@@ -4987,6 +5206,9 @@ static int exec_child(
                         *exit_status = EXIT_SECCOMP;
                         return log_unit_error_errno(unit, r, "Failed to apply system call filters: %m");
                 }
+
+                if (exec_timing)
+                        exec_timing_seccomp = usec_sub_unsigned(now(CLOCK_MONOTONIC), exec_timing_ts);
 #endif
 
 #if HAVE_LIBBPF
@@ -5035,6 +5257,29 @@ static int exec_child(
                                 LOG_UNIT_MESSAGE(unit, "Executing: %s", line));
         }
 
+        if (exec_timing) {
+                usec_t exec_timing_total = usec_sub_unsigned(now(CLOCK_MONOTONIC), exec_timing_start);
+
+                /* Leave a structured record of how long the phases of the child setup took in the
+                 * journal, for "systemd-analyze exec-timing" to pick up. Note that we are already
+                 * running under the full sandbox at this point, so this covers everything up to
+                 * (almost) the execve(). */
+                log_unit_struct(unit, LOG_INFO,
+                                "MESSAGE_ID=" SD_MESSAGE_UNIT_EXEC_TIMING_STR,
+                                LOG_UNIT_INVOCATION_ID(unit),
+                                LOG_UNIT_MESSAGE(unit, "Child setup for %s took %s (cgroup: %s, namespace: %s, seccomp: %s).",
+                                                 executable,
+                                                 FORMAT_TIMESPAN(exec_timing_total, USEC_PER_MSEC),
+                                                 FORMAT_TIMESPAN(exec_timing_cgroup, USEC_PER_MSEC),
+                                                 FORMAT_TIMESPAN(exec_timing_namespace, USEC_PER_MSEC),
+                                                 FORMAT_TIMESPAN(exec_timing_seccomp, USEC_PER_MSEC)),
+                                "EXECUTABLE=%s", executable,
+                                "EXEC_TIMING_CGROUP_USEC=" USEC_FMT, exec_timing_cgroup,
+                                "EXEC_TIMING_NAMESPACE_USEC=" USEC_FMT, exec_timing_namespace,
+                                "EXEC_TIMING_SECCOMP_USEC=" USEC_FMT, exec_timing_seccomp,
+                                "EXEC_TIMING_TOTAL_USEC=" USEC_FMT, exec_timing_total);
+        }
+
         if (exec_fd >= 0) {
                 uint8_t hot = 1;
 
@@ -5068,6 +5313,90 @@ static int exec_child(
 static int exec_context_load_environment(const Unit *unit, const ExecContext *c, char ***l);
 static int exec_context_named_iofds(const ExecContext *c, const ExecParameters *p, int named_iofds[static 3]);
 
+#if HAVE_SECCOMP
+static void exec_seccomp_filter_cache_prewarm(
+                Unit *unit,
+                const ExecCommand *command,
+                const ExecContext *c,
+                const ExecParameters *params) {
+
+        _cleanup_(seccomp_compiled_filter_freep) SeccompCompiledFilter *compiled = NULL;
+        _cleanup_hashmap_free_ Hashmap *merged = NULL;
+        uint32_t negative_action, default_action, action;
+        _cleanup_free_ char *key = NULL;
+        Hashmap *filter;
+        int r;
+
+        assert(unit);
+        assert(command);
+        assert(c);
+        assert(params);
+
+        /* Compiles the unit's SystemCallFilter= down to raw BPF programs ahead of the fork(), and
+         * caches the result in the manager, keyed by the filter configuration: the child then just
+         * installs the programs (see apply_syscall_filter()), and later starts of this — or of any
+         * unit with an identical filter — skip the libseccomp compilation entirely. This is a pure
+         * optimization, hence all failures are silently ignored and the child falls back to
+         * compiling the filter itself. */
+
+        if (!context_has_syscall_filters(c))
+                return;
+
+        if (!is_seccomp_available())
+                return;
+
+        /* With SYSTEMD_LOG_SECCOMP the filter needs to be loaded with SECCOMP_FILTER_FLAG_LOG, which
+         * the pre-compiled programs don't carry, hence leave everything to libseccomp then. */
+        if (getenv_bool("SYSTEMD_LOG_SECCOMP") > 0)
+                return;
+
+        negative_action = c->syscall_errno == SECCOMP_ERROR_NUMBER_KILL ? scmp_act_kill_process() : SCMP_ACT_ERRNO(c->syscall_errno);
+
+        if (c->syscall_allow_list) {
+                default_action = negative_action;
+                action = SCMP_ACT_ALLOW;
+        } else {
+                default_action = SCMP_ACT_ALLOW;
+                action = negative_action;
+        }
+
+        filter = c->syscall_filter;
+
+        if ((params->flags & EXEC_APPLY_SANDBOXING) &&
+            (command->flags & EXEC_COMMAND_AMBIENT_MAGIC) &&
+            !ambient_capabilities_supported()) {
+                /* The child will patch the setuid syscalls into its filter (the "ambient hack", see
+                 * exec_child()). Do the same on a copy here, so that the cache keys match. */
+                merged = hashmap_copy(c->syscall_filter);
+                if (!merged)
+                        return;
+
+                if (seccomp_filter_set_add(merged, c->syscall_allow_list, syscall_filter_sets + SYSCALL_FILTER_SET_SETUID) < 0)
+                        return;
+
+                filter = merged;
+        }
+
+        if (seccomp_filter_set_raw_make_key(default_action, filter, action, &key) < 0)
+                return;
+
+        if (hashmap_contains(unit->manager->exec_seccomp_cache, key))
+                return;
+
+        r = seccomp_compile_syscall_filter_set_raw(default_action, filter, action, false, &compiled);
+        if (r < 0) {
+                log_unit_debug_errno(unit, r, "Failed to pre-compile system call filter, ignoring: %m");
+                return;
+        }
+
+        if (hashmap_ensure_put(&unit->manager->exec_seccomp_cache, &seccomp_compiled_filter_hash_ops, key, compiled) < 0)
+                return;
+
+        TAKE_PTR(key);
+        TAKE_PTR(compiled);
+}
+#endif
+
 int exec_spawn(Unit *unit,
                ExecCommand *command,
                const ExecContext *context,
@@ -5080,7 +5409,6 @@ int exec_spawn(Unit *unit,
         _cleanup_free_ char *subcgroup_path = NULL;
         _cleanup_strv_free_ char **files_env = NULL;
         size_t n_storage_fds = 0, n_socket_fds = 0;
-        _cleanup_free_ char *line = NULL;
         pid_t pid;
 
         assert(unit);
@@ -5116,21 +5444,25 @@ int exec_spawn(Unit *unit,
         if (r < 0)
                 return log_unit_error_errno(unit, r, "Failed to load environment files: %m");
 
-        line = quote_command_line(command->argv, SHELL_ESCAPE_EMPTY);
-        if (!line)
-                return log_oom();
-
         /* Fork with up-to-date SELinux label database, so the child inherits the up-to-date db
            and, until the next SELinux policy changes, we save further reloads in future children. */
         mac_selinux_maybe_reload();
 
-        log_unit_struct(unit, LOG_DEBUG,
-                        LOG_UNIT_MESSAGE(unit, "About to execute %s", line),
-                        "EXECUTABLE=%s", command->path, /* We won't know the real executable path until we create
-                                                           the mount namespace in the child, but we want to log
-                                                           from the parent, so we need to use the (possibly
-                                                           inaccurate) path here. */
-                        LOG_UNIT_INVOCATION_ID(unit));
+        if (DEBUG_LOGGING) {
+                _cleanup_free_ char *line = NULL;
+
+                line = quote_command_line(command->argv, SHELL_ESCAPE_EMPTY);
+                if (!line)
+                        return log_oom();
+
+                log_unit_struct(unit, LOG_DEBUG,
+                                LOG_UNIT_MESSAGE(unit, "About to execute %s", line),
+                                "EXECUTABLE=%s", command->path, /* We won't know the real executable path until we create
+                                                                   the mount namespace in the child, but we want to log
+                                                                   from the parent, so we need to use the (possibly
+                                                                   inaccurate) path here. */
+                                LOG_UNIT_INVOCATION_ID(unit));
+        }
 
         if (params->cgroup_path) {
                 r = exec_parameters_get_cgroup_path(params, &subcgroup_path);
@@ -5147,6 +5479,10 @@ int exec_spawn(Unit *unit,
                 }
         }
 
+#if HAVE_SECCOMP
+        exec_seccomp_filter_cache_prewarm(unit, command, context, params);
+#endif
+
         pid = fork();
         if (pid < 0)
                 return log_unit_error_errno(unit, errno, "Failed to fork: %m");
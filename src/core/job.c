@@ -15,6 +15,7 @@
 #include "job.h"
 #include "log.h"
 #include "macro.h"
+#include "mempool.h"
 #include "parse-util.h"
 #include "serialize.h"
 #include "set.h"
@@ -25,17 +26,26 @@
 #include "string-util.h"
 #include "strv.h"
 #include "terminal-util.h"
+#include "tracepoint-util.h"
 #include "unit.h"
 #include "virt.h"
 
+/* Jobs (and their dependency links, while a transaction is being built) are created and destroyed at a high
+ * rate — every unit state change allocates and releases a bunch of them. Allocate them from mempools, so
+ * that constant churn doesn't fragment the heap and the tiles get recycled. */
+DEFINE_MEMPOOL(job_pool, Job, 16);
+DEFINE_MEMPOOL(job_dependency_pool, JobDependency, 64);
+
 Job* job_new_raw(Unit *unit) {
         Job *j;
+        bool up;
 
         /* used for deserialization */
 
         assert(unit);
 
-        j = new(Job, 1);
+        up = mempool_enabled();
+        j = up ? mempool_alloc_tile(&job_pool) : new(Job, 1);
         if (!j)
                 return NULL;
 
@@ -43,6 +53,7 @@ Job* job_new_raw(Unit *unit) {
                 .manager = unit->manager,
                 .unit = unit,
                 .type = _JOB_TYPE_INVALID,
+                .from_pool = up,
         };
 
         return j;
@@ -104,10 +115,17 @@ Job* job_free(Job *j) {
 
         job_unlink(j);
 
+        unit_ref_unset(&j->blocked_by);
+
         sd_bus_track_unref(j->bus_track);
         strv_free(j->deserialized_clients);
 
-        return mfree(j);
+        if (j->from_pool)
+                mempool_free_tile(&job_pool, j);
+        else
+                free(j);
+
+        return NULL;
 }
 
 void job_add_triggering_unit(Job *j, Unit *u) {
@@ -295,6 +313,7 @@ int job_install_deserialized(Job *j) {
 
 JobDependency* job_dependency_new(Job *subject, Job *object, bool matters, bool conflicts) {
         JobDependency *l;
+        bool up;
 
         assert(object);
 
@@ -303,7 +322,8 @@ JobDependency* job_dependency_new(Job *subject, Job *object, bool matters, bool
          * this means the 'anchor' job (i.e. the one the user
          * explicitly asked for) is the requester. */
 
-        l = new0(JobDependency, 1);
+        up = mempool_enabled();
+        l = up ? mempool_alloc0_tile(&job_dependency_pool) : new0(JobDependency, 1);
         if (!l)
                 return NULL;
 
@@ -311,6 +331,7 @@ JobDependency* job_dependency_new(Job *subject, Job *object, bool matters, bool
         l->object = object;
         l->matters = matters;
         l->conflicts = conflicts;
+        l->from_pool = up;
 
         if (subject)
                 LIST_PREPEND(subject, subject->subject_list, l);
@@ -328,7 +349,10 @@ void job_dependency_free(JobDependency *l) {
 
         LIST_REMOVE(object, l->object->object_list, l);
 
-        free(l);
+        if (l->from_pool)
+                mempool_free_tile(&job_dependency_pool, l);
+        else
+                free(l);
 }
 
 void job_dump(Job *j, FILE *f, const char *prefix) {
@@ -488,11 +512,30 @@ static bool job_is_runnable(Job *j) {
         if (j->type == JOB_NOP)
                 return true;
 
+        /* If the job we found blocking us the last time we checked is still doing so, there's no need to
+         * rescan the full set of ordering dependencies. This matters on large transactions, where a
+         * waiting job is woken up whenever any of its ordering dependencies finishes. */
+        other = UNIT_DEREF(j->blocked_by);
+        if (other) {
+                if (unit_has_dependency(j->unit, j->blocked_by_atom, other) &&
+                    other->job && job_compare(j, other->job, j->blocked_by_atom) > 0) {
+                        log_unit_debug(j->unit,
+                                       "%s held back, still waiting for: %s",
+                                       j->blocked_by_atom == UNIT_ATOM_AFTER ? "starting" : "stopping",
+                                       other->id);
+                        return false;
+                }
+
+                unit_ref_unset(&j->blocked_by);
+        }
+
         UNIT_FOREACH_DEPENDENCY(other, j->unit, UNIT_ATOM_AFTER)
                 if (other->job && job_compare(j, other->job, UNIT_ATOM_AFTER) > 0) {
                         log_unit_debug(j->unit,
                                        "starting held back, waiting for: %s",
                                        other->id);
+                        unit_ref_set(&j->blocked_by, j->unit, other);
+                        j->blocked_by_atom = UNIT_ATOM_AFTER;
                         return false;
                 }
 
@@ -501,6 +544,8 @@ static bool job_is_runnable(Job *j) {
                         log_unit_debug(j->unit,
                                        "stopping held back, waiting for: %s",
                                        other->id);
+                        unit_ref_set(&j->blocked_by, j->unit, other);
+                        j->blocked_by_atom = UNIT_ATOM_BEFORE;
                         return false;
                 }
 
@@ -859,6 +904,8 @@ int job_run_and_invalidate(Job *j) {
         job_set_state(j, JOB_RUNNING);
         job_add_to_dbus_queue(j);
 
+        TRACE_POINT(systemd, job_start, j->id, j->unit->id, job_type_to_string(j->type));
+
         switch (j->type) {
 
                 case JOB_VERIFY_ACTIVE: {
@@ -955,6 +1002,8 @@ int job_finish_and_invalidate(Job *j, JobResult result, bool recursive, bool alr
         log_unit_debug(u, "Job %" PRIu32 " %s/%s finished, result=%s",
                        j->id, u->id, job_type_to_string(t), job_result_to_string(result));
 
+        TRACE_POINT(systemd, job_finish, j->id, u->id, job_type_to_string(t), job_result_to_string(result));
+
         /* If this job did nothing to the respective unit we don't log the status message */
         if (!already)
                 job_emit_done_message(u, j->id, t, result);
@@ -12,6 +12,17 @@
 
 typedef struct Job Job;
 typedef struct JobDependency JobDependency;
+typedef struct Unit Unit;
+typedef struct UnitRef UnitRef;
+
+struct UnitRef {
+        /* Keeps tracks of references to a unit. This is useful so
+         * that we can merge two units if necessary and correct all
+         * references to them */
+
+        Unit *source, *target;
+        LIST_FIELDS(UnitRef, refs_by_target);
+};
 typedef enum JobType JobType;
 typedef enum JobState JobState;
 typedef enum JobMode JobMode;
@@ -111,6 +122,7 @@ struct JobDependency {
 
         bool matters:1;
         bool conflicts:1;
+        bool from_pool:1; /* whether this was allocated from the mempool */
 };
 
 struct Job {
@@ -153,6 +165,12 @@ struct Job {
 
         unsigned run_queue_idx;
 
+        /* While the job is waiting, the unit whose job we most recently found to block it, and via which
+         * ordering atom, so that the next runnability check can look there first instead of rescanning
+         * all ordering dependencies */
+        UnitRef blocked_by;
+        UnitDependencyAtom blocked_by_atom;
+
         bool installed:1;
         bool in_run_queue:1;
         bool matters_to_anchor:1;
@@ -163,6 +181,7 @@ struct Job {
         bool in_gc_queue:1;
         bool ref_by_private_bus:1;
         bool return_skip_on_cond_failure:1;
+        bool from_pool:1; /* whether this was allocated from the mempool */
 };
 
 Job* job_new(Unit *unit, JobType type);
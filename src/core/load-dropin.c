@@ -116,10 +116,7 @@ int unit_load_dropin(Unit *u) {
         STRV_FOREACH(f, u->dropin_paths) {
                 struct stat st;
 
-                r = config_parse(u->id, *f, NULL,
-                                 UNIT_VTABLE(u)->sections,
-                                 config_item_perf_lookup, load_fragment_gperf_lookup,
-                                 0, u, &st);
+                r = unit_parse_config_file_cached(u, *f, NULL, &st);
                 if (r > 0)
                         u->dropin_mtime = MAX(u->dropin_mtime, timespec_load(&st.st_mtim));
         }
@@ -6055,6 +6055,72 @@ static int merge_by_names(Unit **u, Set *names, const char *id) {
         return 0;
 }
 
+int unit_parse_config_file_cached(Unit *u, const char *path, FILE *f, struct stat *ret_stat) {
+        _cleanup_fclose_ FILE *ours = NULL;
+        CompiledConfigFile *c;
+        struct stat st;
+        Manager *m;
+        int r;
+
+        assert(u);
+        assert(path);
+
+        /* Parses the file at 'path' into the unit, using a pre-lexed copy from the manager's compiled
+         * fragment cache when one is available and still matches the inode on disk, and compiling (and
+         * caching) the file otherwise. Returns > 0 on success, 0 if the file vanished in the meantime. */
+
+        m = u->manager;
+
+        if (!f) {
+                f = ours = fopen(path, "re");
+                if (!f) {
+                        if (errno == ENOENT) {
+                                if (ret_stat)
+                                        *ret_stat = (struct stat) {};
+
+                                return 0;
+                        }
+
+                        return -errno;
+                }
+        }
+
+        if (fstat(fileno(f), &st) < 0)
+                return -errno;
+
+        c = hashmap_get(m->unit_compile_cache, path);
+        if (c && !stat_inode_unmodified(&c->st, &st)) {
+                compiled_config_file_free(hashmap_remove(m->unit_compile_cache, path));
+                c = NULL;
+        }
+
+        if (!c) {
+                _cleanup_(compiled_config_file_freep) CompiledConfigFile *fresh = NULL;
+
+                r = config_compile(u->id, path, f, UNIT_VTABLE(u)->sections, 0, &fresh);
+                if (r <= 0)
+                        return r;
+
+                r = hashmap_ensure_put(&m->unit_compile_cache, &compiled_config_file_hash_ops, fresh->path, fresh);
+                if (r < 0)
+                        return r;
+
+                c = TAKE_PTR(fresh);
+        }
+
+        r = config_replay(c, u->id,
+                          config_item_perf_lookup, load_fragment_gperf_lookup,
+                          0,
+                          u);
+        if (r < 0)
+                return r;
+
+        if (ret_stat)
+                *ret_stat = st;
+
+        return 1;
+}
+
 int unit_load_fragment(Unit *u) {
         const char *fragment;
         _cleanup_set_free_free_ Set *names = NULL;
@@ -6114,13 +6180,8 @@ int unit_load_fragment(Unit *u) {
                         u->load_state = UNIT_LOADED;
                         u->fragment_mtime = timespec_load(&st.st_mtim);
 
-                        /* Now, parse the file contents */
-                        r = config_parse(u->id, fragment, f,
-                                         UNIT_VTABLE(u)->sections,
-                                         config_item_perf_lookup, load_fragment_gperf_lookup,
-                                         0,
-                                         u,
-                                         NULL);
+                        /* Now, parse the file contents, through the compiled fragment cache */
+                        r = unit_parse_config_file_cached(u, fragment, f, NULL);
                         if (r == -ENOEXEC)
                                 log_unit_notice_errno(u, r, "Unit configuration has fatal error, unit will not be started.");
                         if (r < 0)
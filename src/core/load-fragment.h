@@ -16,6 +16,10 @@ int parse_confirm_spawn(const char *value, char **console);
 
 int unit_load_fragment(Unit *u);
 
+/* Parse a unit configuration file (fragment or drop-in) into the unit, going through the manager's
+ * compiled fragment cache */
+int unit_parse_config_file_cached(Unit *u, const char *path, FILE *f, struct stat *ret_stat);
+
 void unit_dump_config_items(FILE *f);
 
 CONFIG_PARSER_PROTOTYPE(config_parse_unit_deps);
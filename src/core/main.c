@@ -1485,6 +1485,24 @@ static int write_container_id(void) {
         return 1;
 }
 
+static int write_vm_id(void) {
+        int r, v;
+
+        /* Leave the result of our VM detection in a file in /run, so that other processes can pick it up
+         * from there instead of redoing the CPUID/DMI probing over and over again, see detect_vm(). */
+
+        v = detect_vm();
+        if (v < 0)
+                return log_warning_errno(v, "Failed to detect virtualization, ignoring: %m");
+
+        RUN_WITH_UMASK(0022)
+                r = write_string_file("/run/systemd/virtualization", virtualization_to_string(v), WRITE_STRING_FILE_CREATE);
+        if (r < 0)
+                return log_warning_errno(r, "Failed to write /run/systemd/virtualization, ignoring: %m");
+
+        return 1;
+}
+
 static int bump_unix_max_dgram_qlen(void) {
         _cleanup_free_ char *qlen = NULL;
         unsigned long v;
@@ -2241,6 +2259,7 @@ static int initialize_runtime(
                         bump_file_max_and_nr_open();
                         test_usr();
                         write_container_id();
+                        write_vm_id();
                 }
 
                 if (arg_watchdog_device) {
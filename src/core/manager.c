@@ -83,12 +83,16 @@
 #include "umask-util.h"
 #include "unit-name.h"
 #include "user-util.h"
+#include "util.h"
 #include "virt.h"
 #include "watchdog.h"
 
 #define NOTIFY_RCVBUF_SIZE (8*1024*1024)
 #define CGROUPS_AGENT_RCVBUF_SIZE (8*1024*1024)
 
+/* How many notification datagrams we process per event loop wakeup at maximum */
+#define NOTIFY_RECEIVE_MESSAGES_MAX 32U
+
 /* Initial delay and the interval for printing status messages about running jobs */
 #define JOBS_IN_PROGRESS_WAIT_USEC (2*USEC_PER_SEC)
 #define JOBS_IN_PROGRESS_QUIET_WAIT_USEC (25*USEC_PER_SEC)
@@ -864,6 +868,9 @@ int manager_new(UnitFileScope scope, ManagerTestRunFlags test_run_flags, Manager
         /* Reboot immediately if the user hits C-A-D more often than 7x per 2s */
         m->ctrl_alt_del_ratelimit = (RateLimit) { .interval = 2 * USEC_PER_SEC, .burst = 7 };
 
+        /* Spread automatic restarts out once more than 100 become due within 1s */
+        m->auto_restart_ratelimit = (RateLimit) { .interval = 1 * USEC_PER_SEC, .burst = 100 };
+
         r = manager_default_environment(m);
         if (r < 0)
                 return r;
@@ -1482,6 +1489,8 @@ Manager* manager_free(Manager *m) {
         exec_runtime_vacuum(m);
         hashmap_free(m->exec_runtime_by_id);
 
+        hashmap_free(m->exec_seccomp_cache);
+
         dynamic_user_vacuum(m, false);
         hashmap_free(m->dynamic_users);
 
@@ -1526,6 +1535,7 @@ Manager* manager_free(Manager *m) {
 
         hashmap_free(m->cgroup_unit);
         manager_free_unit_name_maps(m);
+        hashmap_free(m->unit_compile_cache);
 
         free(m->switch_root);
         free(m->switch_root_init);
@@ -2418,10 +2428,9 @@ static void manager_invoke_notify_message(
         }
 }
 
-static int manager_dispatch_notify_fd(sd_event_source *source, int fd, uint32_t revents, void *userdata) {
+static int manager_receive_notify_message(Manager *m) {
 
         _cleanup_fdset_free_ FDSet *fds = NULL;
-        Manager *m = userdata;
         char buf[NOTIFY_BUFFER_MAX+1];
         struct iovec iovec = {
                 .iov_base = buf,
@@ -2447,20 +2456,17 @@ static int manager_dispatch_notify_fd(sd_event_source *source, int fd, uint32_t
         ssize_t n;
 
         assert(m);
-        assert(m->notify_fd == fd);
 
-        if (revents != EPOLLIN) {
-                log_warning("Got unexpected poll event for notify fd.");
-                return 0;
-        }
+        /* Receives and processes one datagram from the notify socket. Returns > 0 if one was processed (or
+         * consumed and ignored), 0 if the socket ran empty, and a fatal error otherwise. */
 
         n = recvmsg_safe(m->notify_fd, &msghdr, MSG_DONTWAIT|MSG_CMSG_CLOEXEC|MSG_TRUNC);
         if (n < 0) {
                 if (ERRNO_IS_TRANSIENT(n))
-                        return 0; /* Spurious wakeup, try again */
+                        return 0; /* Socket empty, we are done for now */
                 if (n == -EXFULL) {
                         log_warning("Got message with truncated control data (too many fds sent?), ignoring.");
-                        return 0;
+                        return 1;
                 }
                 /* If this is any other, real error, then let's stop processing this socket. This of course
                  * means we won't take notification messages anymore, but that's still better than busy
@@ -2492,25 +2498,25 @@ static int manager_dispatch_notify_fd(sd_event_source *source, int fd, uint32_t
                 if (r < 0) {
                         close_many(fd_array, n_fds);
                         log_oom();
-                        return 0;
+                        return 1;
                 }
         }
 
         if (!ucred || !pid_is_valid(ucred->pid)) {
                 log_warning("Received notify message without valid credentials. Ignoring.");
-                return 0;
+                return 1;
         }
 
         if ((size_t) n >= sizeof(buf) || (msghdr.msg_flags & MSG_TRUNC)) {
                 log_warning("Received notify message exceeded maximum size. Ignoring.");
-                return 0;
+                return 1;
         }
 
         /* As extra safety check, let's make sure the string we get doesn't contain embedded NUL bytes. We permit one
          * trailing NUL byte in the message, but don't expect it. */
         if (n > 1 && memchr(buf, 0, n-1)) {
                 log_warning("Received notify message with embedded NUL bytes. Ignoring.");
-                return 0;
+                return 1;
         }
 
         /* Make sure it's NUL-terminated, then parse it to obtain the tags list */
@@ -2518,12 +2524,12 @@ static int manager_dispatch_notify_fd(sd_event_source *source, int fd, uint32_t
         tags = strv_split_newlines(buf);
         if (!tags) {
                 log_oom();
-                return 0;
+                return 1;
         }
 
         /* possibly a barrier fd, let's see */
         if (manager_process_barrier_fd(tags, fds))
-                return 0;
+                return 1;
 
         /* Increase the generation counter used for filtering out duplicate unit invocations. */
         m->notifygen++;
@@ -2564,6 +2570,30 @@ static int manager_dispatch_notify_fd(sd_event_source *source, int fd, uint32_t
         if (fdset_size(fds) > 0)
                 log_warning("Got extra auxiliary fds with notification message, closing them.");
 
+        return 1;
+}
+
+static int manager_dispatch_notify_fd(sd_event_source *source, int fd, uint32_t revents, void *userdata) {
+        Manager *m = userdata;
+        int r;
+
+        assert(m);
+        assert(m->notify_fd == fd);
+
+        if (revents != EPOLLIN) {
+                log_warning("Got unexpected poll event for notify fd.");
+                return 0;
+        }
+
+        /* Drain a bunch of datagrams per wakeup rather than just one, so that services sending
+         * high-frequency STATUS=/WATCHDOG=1 updates don't cost us a full event loop iteration per
+         * message. Bounded, so that a notification flood cannot starve the other event sources. */
+        for (unsigned i = 0; i < NOTIFY_RECEIVE_MESSAGES_MAX; i++) {
+                r = manager_receive_notify_message(m);
+                if (r <= 0)
+                        return r;
+        }
+
         return 0;
 }
 
@@ -2997,6 +3027,16 @@ static int manager_dispatch_jobs_in_progress(sd_event_source *source, usec_t use
         return sd_event_source_set_enabled(source, SD_EVENT_ONESHOT);
 }
 
+static void manager_account_dispatch_latency(Manager *m, usec_t q) {
+        assert(m);
+
+        /* Maintains a power-of-two µs histogram of how long each event loop dispatch took, so that
+         * saturation of PID 1's event loop can be diagnosed on a live system, without debug logging. */
+
+        m->dispatch_latency_max = MAX(m->dispatch_latency_max, q);
+        m->dispatch_latency_histogram[MIN(log2u64(q), MANAGER_DISPATCH_LATENCY_BUCKETS - 1U)]++;
+}
+
 int manager_loop(Manager *m) {
         RateLimit rl = { .interval = 1*USEC_PER_SEC, .burst = 50000 };
         int r;
@@ -3048,8 +3088,18 @@ int manager_loop(Manager *m) {
                 if (manager_dispatch_dbus_queue(m) > 0)
                         continue;
 
-                /* Sleep for watchdog runtime wait time */
-                r = sd_event_run(m->event, watchdog_runtime_wait());
+                /* Run the event loop in its separate phases, so that the time spent dispatching event
+                 * sources can be accounted separately from the time spent waiting for the watchdog runtime
+                 * wait time. */
+                r = sd_event_prepare(m->event);
+                if (r == 0) /* No event sources ready yet, wait for some */
+                        r = sd_event_wait(m->event, watchdog_runtime_wait());
+                if (r > 0) {
+                        usec_t ts = now(CLOCK_MONOTONIC);
+
+                        r = sd_event_dispatch(m->event);
+                        manager_account_dispatch_latency(m, usec_sub_unsigned(now(CLOCK_MONOTONIC), ts));
+                }
                 if (r < 0)
                         return log_error_errno(r, "Failed to run event loop: %m");
         }
@@ -3312,6 +3362,65 @@ int manager_override_watchdog_pretimeout_governor(Manager *m, const char *govern
         return free_and_replace(m->watchdog_pretimeout_governor_overridden, p);
 }
 
+static void manager_precompile_one(Manager *m, Unit *u, const char *path) {
+        _cleanup_(compiled_config_file_freep) CompiledConfigFile *fresh = NULL;
+        _cleanup_fclose_ FILE *f = NULL;
+        CompiledConfigFile *c;
+        struct stat st;
+        int r;
+
+        assert(m);
+        assert(u);
+        assert(path);
+
+        f = fopen(path, "re");
+        if (!f)
+                return;
+
+        if (fstat(fileno(f), &st) < 0)
+                return;
+
+        if (null_or_empty(&st)) /* Masked? Then there's nothing to lex. */
+                return;
+
+        c = hashmap_get(m->unit_compile_cache, path);
+        if (c && stat_inode_unmodified(&c->st, &st))
+                return;
+
+        r = config_compile(u->id, path, f, UNIT_VTABLE(u)->sections, 0, &fresh);
+        if (r <= 0)
+                return;
+
+        compiled_config_file_free(hashmap_remove(m->unit_compile_cache, path));
+
+        if (hashmap_ensure_put(&m->unit_compile_cache, &compiled_config_file_hash_ops, fresh->path, fresh) < 0)
+                return;
+
+        TAKE_PTR(fresh);
+}
+
+static void manager_precompile_unit_files(Manager *m) {
+        char **i;
+        Unit *u;
+
+        assert(m);
+
+        /* Refresh the compiled fragment cache for all units whose fragment or drop-ins changed on disk,
+         * while we are still in a state where failing is harmless. This hoists the expensive part of
+         * re-parsing out of the reload window during which we cannot service bus requests: once we are past
+         * the point of no return, unchanged units replay their pre-lexed fragments and only the lookup-table
+         * dispatch remains. All of this is best effort: fragments we cannot pre-lex here are simply lexed
+         * during the reload proper, as before. */
+
+        HASHMAP_FOREACH(u, m->units) {
+                if (u->fragment_path)
+                        manager_precompile_one(m, u, u->fragment_path);
+
+                STRV_FOREACH(i, u->dropin_paths)
+                        manager_precompile_one(m, u, *i);
+        }
+}
+
 int manager_reload(Manager *m) {
         _unused_ _cleanup_(manager_reloading_stopp) Manager *reloading = NULL;
         _cleanup_fdset_free_ FDSet *fds = NULL;
@@ -3320,6 +3429,8 @@ int manager_reload(Manager *m) {
 
         assert(m);
 
+        manager_precompile_unit_files(m);
+
         r = manager_open_serialization(m, &f);
         if (r < 0)
                 return log_error_errno(r, "Failed to create serialization file: %m");
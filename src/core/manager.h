@@ -23,6 +23,10 @@ typedef struct Unit Unit;
 /* Enforce upper limit how many names we allow */
 #define MANAGER_MAX_NAMES 131072 /* 128K */
 
+/* Number of buckets in the event loop dispatch latency histogram. Bucket i counts dispatches that took
+ * [2^i, 2^(i+1)) µs, the last bucket also everything above. */
+#define MANAGER_DISPATCH_LATENCY_BUCKETS 20U
+
 typedef struct Manager Manager;
 
 /* An externally visible state. We don't actually maintain this as state variable, but derive it from various fields
@@ -243,6 +247,11 @@ struct Manager {
         Set *unit_path_cache;
         uint64_t unit_cache_timestamp_hash;
 
+        /* Pre-lexed unit fragments, path → CompiledConfigFile. Deliberately kept across daemon reloads:
+         * entries are validated against the file on disk before reuse, so that unchanged unit files need not
+         * be re-lexed. */
+        Hashmap *unit_compile_cache;
+
         char **transient_environment;  /* The environment, as determined from config files, kernel cmdline and environment generators */
         char **client_environment;     /* Environment variables created by clients through the bus API */
 
@@ -253,6 +262,10 @@ struct Manager {
 
         dual_timestamp timestamps[_MANAGER_TIMESTAMP_MAX];
 
+        /* Event loop dispatch latency accounting, exported on the bus for "systemd-analyze loop-latency" */
+        uint64_t dispatch_latency_histogram[MANAGER_DISPATCH_LATENCY_BUCKETS];
+        usec_t dispatch_latency_max;
+
         /* Data specific to the device subsystem */
         sd_device_monitor *device_monitor;
         Hashmap *devices_by_sysfs;
@@ -425,10 +438,19 @@ struct Manager {
         /* ExecRuntime, indexed by their owner unit id */
         Hashmap *exec_runtime_by_id;
 
+        /* Compiled seccomp filters, indexed by a string describing the filter set, so that services
+         * with identical SystemCallFilter= settings share one compilation */
+        Hashmap *exec_seccomp_cache;
+
         /* When the user hits C-A-D more than 7 times per 2s, do something immediately... */
         RateLimit ctrl_alt_del_ratelimit;
         EmergencyAction cad_burst_action;
 
+        /* When more automatic service restarts than this become due per interval, stretch the restart
+         * timers of the rest, so that a flapping herd doesn't monopolize the manager */
+        RateLimit auto_restart_ratelimit;
+        unsigned n_deferred_auto_restarts;
+
         const char *unit_log_field;
         const char *unit_log_format_string;
 
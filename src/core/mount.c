@@ -1665,7 +1665,7 @@ static int mount_setup_unit(
                 const char *fstype,
                 bool set_flags) {
 
-        _cleanup_free_ char *e = NULL;
+        char e[UNIT_NAME_MAX];
         MountProcFlags flags;
         Unit *u;
         int r;
@@ -1695,8 +1695,10 @@ static int mount_setup_unit(
          * nonetheless they are generally synthesized by software, and thus managed by that other
          * software. Having such long names just means you cannot use systemd to manage those specific mount
          * points, which should be an OK restriction to make. After all we don't have to be able to manage
-         * all mount points in the world — as long as we don't choke on them when we encounter them. */
-        r = unit_name_from_path(where, ".mount", &e);
+         * all mount points in the world — as long as we don't choke on them when we encounter them. Note
+         * that we use the allocation-free conversion here, since we run once per mountinfo line on every
+         * mount table change. */
+        r = unit_name_from_path_buf(where, ".mount", e, sizeof(e));
         if (r < 0) {
                 static RateLimit rate_limit = { /* Let's log about this at warning level at most once every
                                                  * 5s. Given that we generate this whenever we read the file
@@ -1731,9 +1733,17 @@ static int mount_setup_unit(
                 return log_warning_errno(r, "Failed to set up mount unit for '%s': %m", where);
 
         /* If the mount changed properties or state, let's notify our clients */
-        if (flags & (MOUNT_PROC_JUST_CHANGED|MOUNT_PROC_JUST_MOUNTED))
+        if (flags & (MOUNT_PROC_JUST_CHANGED|MOUNT_PROC_JUST_MOUNTED)) {
                 unit_add_to_dbus_queue(u);
 
+                /* Tell the device unit (creating it as "tentative" if udev doesn't know the device yet)
+                 * that its node is backing a mount point. The found-state is sticky on the device unit and
+                 * cleared again when the mount disappears from the table, hence doing this only when the
+                 * mount is new or changed suffices — re-validating the device node for every unchanged line
+                 * on every mountinfo rescan is what made mount storms expensive. */
+                device_found_node(m, what, DEVICE_FOUND_MOUNT, DEVICE_FOUND_MOUNT);
+        }
+
         if (set_flags)
                 MOUNT(u)->proc_flags = flags;
 
@@ -1769,8 +1779,6 @@ static int mount_load_proc_self_mountinfo(Manager *m, bool set_flags) {
                 if (!device || !path)
                         continue;
 
-                device_found_node(m, device, DEVICE_FOUND_MOUNT, DEVICE_FOUND_MOUNT);
-
                 (void) mount_setup_unit(m, device, path, options, fstype, set_flags);
         }
 
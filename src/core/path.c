@@ -288,6 +288,8 @@ static void path_done(Unit *u) {
 
         assert(p);
 
+        p->recheck_event_source = sd_event_source_disable_unref(p->recheck_event_source);
+
         path_free_specs(p);
 }
 
@@ -741,10 +743,47 @@ _pure_ static const char *path_sub_state_to_string(Unit *u) {
         return path_state_to_string(PATH(u)->state);
 }
 
+static int path_dispatch_recheck(sd_event_source *source, void *userdata) {
+        Path *p = PATH(userdata);
+
+        assert(p);
+
+        if (IN_SET(p->state, PATH_WAITING, PATH_RUNNING))
+                path_enter_waiting(p, false, false);
+
+        return 0;
+}
+
+static int path_schedule_recheck(Path *p) {
+        int r;
+
+        assert(p);
+
+        /* Coalesce the condition re-checks — and the full inotify watch rebuild each of them entails — that
+         * a flurry of events would otherwise trigger one-by-one: the deferred source runs at idle priority,
+         * i.e. only once all IO events pending in this event loop turn have been dispatched. Note that
+         * actual triggering is not delayed by this, as events on the primary watch enter the running state
+         * directly from the IO handler. */
+
+        if (!p->recheck_event_source) {
+                r = sd_event_add_defer(UNIT(p)->manager->event, &p->recheck_event_source, path_dispatch_recheck, p);
+                if (r < 0)
+                        return r;
+
+                r = sd_event_source_set_priority(p->recheck_event_source, SD_EVENT_PRIORITY_IDLE);
+                if (r < 0)
+                        return r;
+
+                (void) sd_event_source_set_description(p->recheck_event_source, "path-recheck");
+        }
+
+        return sd_event_source_set_enabled(p->recheck_event_source, SD_EVENT_ONESHOT);
+}
+
 static int path_dispatch_io(sd_event_source *source, int fd, uint32_t revents, void *userdata) {
         PathSpec *s = userdata;
         Path *p;
-        int changed;
+        int changed, r;
 
         assert(s);
         assert(s->unit);
@@ -772,8 +811,13 @@ static int path_dispatch_io(sd_event_source *source, int fd, uint32_t revents, v
 
         if (changed)
                 path_enter_running(p);
-        else
-                path_enter_waiting(p, false, false);
+        else {
+                r = path_schedule_recheck(p);
+                if (r < 0) {
+                        log_unit_warning_errno(UNIT(p), r, "Failed to schedule recheck: %m");
+                        goto fail;
+                }
+        }
 
         return 0;
 
@@ -64,6 +64,8 @@ struct Path {
         PathResult result;
 
         RateLimit trigger_limit;
+
+        sd_event_source *recheck_event_source;
 };
 
 void path_free_specs(Path *p);
@@ -207,6 +207,11 @@ static void service_start_watchdog(Service *s) {
 
         assert(s);
 
+        /* Note that in the healthy path this timer never fires: each WATCHDOG=1 datagram pushes the
+         * deadline forward before it is reached, which is just a prioq update in the event loop, no
+         * timerfd traffic. The per-datagram cost of the keep-alives themselves is amortized in
+         * manager_dispatch_notify_fd(), which drains the notify socket in batches. */
+
         watchdog_usec = service_get_watchdog_usec(s);
         if (!timestamp_is_set(watchdog_usec)) {
                 service_stop_watchdog(s);
@@ -1877,9 +1882,32 @@ static void service_enter_dead(Service *s, ServiceResult f, bool allow_restart)
         service_set_state(s, end_state);
 
         if (s->will_auto_restart) {
+                usec_t restart_usec = s->restart_usec;
+                Manager *m = UNIT(s)->manager;
+
                 s->will_auto_restart = false;
 
-                r = service_arm_timer(s, usec_add(now(CLOCK_MONOTONIC), s->restart_usec));
+                /* When a shared dependency goes away, hundreds of services may become due for restart
+                 * in the same instant, and spawning them all in one event loop iteration just produces
+                 * the next synchronized wave of doomed forks. Once the manager-wide budget is
+                 * exhausted, push each further restart out a bit, spreading the herd over time instead
+                 * of dropping anything. */
+                if (ratelimit_below(&m->auto_restart_ratelimit))
+                        m->n_deferred_auto_restarts = 0;
+                else {
+                        usec_t extra;
+
+                        extra = usec_add(m->auto_restart_ratelimit.interval,
+                                         m->n_deferred_auto_restarts * (m->auto_restart_ratelimit.interval / m->auto_restart_ratelimit.burst));
+                        m->n_deferred_auto_restarts++;
+
+                        log_unit_info(UNIT(s), "Too many automatic restarts are due, delaying restart by an additional %s.",
+                                      FORMAT_TIMESPAN(extra, USEC_PER_MSEC));
+
+                        restart_usec = usec_add(restart_usec, extra);
+                }
+
+                r = service_arm_timer(s, usec_add(now(CLOCK_MONOTONIC), restart_usec));
                 if (r < 0) {
                         s->n_keep_fd_store--;
                         goto fail;
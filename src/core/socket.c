@@ -3002,9 +3002,13 @@ shortcut:
         return cfd;
 }
 
+/* Maximum number of connections we accept in one event loop iteration. Draining the backlog in a batch
+ * saves an event loop iteration per connection on busy listening sockets, but we put a limit on it so that
+ * a connection flood cannot starve the other event sources. */
+#define SOCKET_ACCEPT_BATCH_MAX 16U
+
 static int socket_dispatch_io(sd_event_source *source, int fd, uint32_t revents, void *userdata) {
         SocketPort *p = userdata;
-        int cfd = -1;
 
         assert(p);
         assert(fd >= 0);
@@ -3026,16 +3030,30 @@ static int socket_dispatch_io(sd_event_source *source, int fd, uint32_t revents,
             p->type == SOCKET_SOCKET &&
             socket_address_can_accept(&p->address)) {
 
-                cfd = socket_accept_in_cgroup(p->socket, p, fd);
-                if (cfd == -EAGAIN) /* Spurious accept() */
-                        return 0;
-                if (cfd < 0)
-                        goto fail;
+                for (unsigned i = 0; i < SOCKET_ACCEPT_BATCH_MAX; i++) {
+                        int cfd;
+
+                        cfd = socket_accept_in_cgroup(p->socket, p, fd);
+                        if (cfd == -EAGAIN) /* Backlog drained (or spurious wakeup) */
+                                return 0;
+                        if (cfd < 0)
+                                goto fail;
+
+                        socket_apply_socket_options(p->socket, p, cfd);
 
-                socket_apply_socket_options(p->socket, p, cfd);
+                        socket_enter_running(p->socket, cfd);
+
+                        /* Accepting the connection might have changed our state, e.g. when the trigger
+                         * limit was hit or a stop was queued. Stop draining then, anything still pending
+                         * will be flushed or picked up once we listen again. */
+                        if (p->socket->state != SOCKET_LISTENING)
+                                return 0;
+                }
+
+                return 0;
         }
 
-        socket_enter_running(p->socket, cfd);
+        socket_enter_running(p->socket, -1);
         return 0;
 
 fail:
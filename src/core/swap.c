@@ -413,7 +413,7 @@ static int swap_setup_unit(
                 int priority,
                 bool set_flags) {
 
-        _cleanup_free_ char *e = NULL;
+        char e[UNIT_NAME_MAX];
         bool delete = false;
         Unit *u = NULL;
         int r;
@@ -423,7 +423,8 @@ static int swap_setup_unit(
         assert(what);
         assert(what_proc_swaps);
 
-        r = unit_name_from_path(what, ".swap", &e);
+        /* Allocation-free conversion, since we run once per /proc/swaps line on every change */
+        r = unit_name_from_path_buf(what, ".swap", e, sizeof(e));
         if (r < 0)
                 return log_unit_error_errno(u, r, "Failed to generate unit name from path: %m");
 
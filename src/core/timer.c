@@ -412,9 +412,20 @@ static void timer_enter_waiting(Timer *t, bool time_change) {
                                         b = ts.realtime;
                         }
 
-                        r = calendar_spec_next_usec(v->calendar_spec, b, &v->next_elapse);
-                        if (r < 0)
-                                continue;
+                        /* Finding the next elapse of a calendar expression iterates over the calendar and
+                         * is not exactly cheap, in particular if a foreign timezone forces a subprocess on
+                         * us. If the base time still falls in the window the previous evaluation covered,
+                         * its result is still the next elapse, so reuse it. */
+                        if (b >= v->calendar_base && b < v->calendar_next)
+                                v->next_elapse = v->calendar_next;
+                        else {
+                                r = calendar_spec_next_usec(v->calendar_spec, b, &v->next_elapse);
+                                if (r < 0)
+                                        continue;
+
+                                v->calendar_base = b;
+                                v->calendar_next = v->next_elapse;
+                        }
 
                         /* To make the delay due to RandomizedDelaySec= work even at boot, if the scheduled
                          * time has already passed, set the time when systemd first started as the scheduled
@@ -834,12 +845,17 @@ static void timer_time_change(Unit *u) {
 
 static void timer_timezone_change(Unit *u) {
         Timer *t = TIMER(u);
+        TimerValue *v;
 
         assert(u);
 
         if (t->state != TIMER_WAITING)
                 return;
 
+        /* The timezone change invalidates any cached calendar evaluations */
+        LIST_FOREACH(value, v, t->values)
+                v->calendar_base = v->calendar_next = 0;
+
         if (t->on_timezone_change) {
                 log_unit_debug(u, "Timezone change, triggering activation.");
                 timer_enter_running(t);
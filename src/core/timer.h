@@ -25,6 +25,12 @@ typedef struct TimerValue {
         CalendarSpec *calendar_spec; /* only for calendar events */
         usec_t next_elapse;
 
+        /* Cache of the last calendar evaluation: for any base time in [calendar_base, calendar_next) the
+         * expression elapses next at calendar_next, hence re-arming without an intermediate trigger doesn't
+         * need to reevaluate the spec. Zeroed initially and on timezone changes. */
+        usec_t calendar_base;
+        usec_t calendar_next;
+
         LIST_FIELDS(struct TimerValue, value);
 } TimerValue;
 
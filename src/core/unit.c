@@ -53,6 +53,7 @@
 #include "strv.h"
 #include "terminal-util.h"
 #include "tmpfile-util.h"
+#include "tracepoint-util.h"
 #include "umask-util.h"
 #include "unit-name.h"
 #include "unit.h"
@@ -105,6 +106,7 @@ Unit* unit_new(Manager *m, size_t size) {
         u->on_success_job_mode = JOB_FAIL;
         u->cgroup_control_inotify_wd = -1;
         u->cgroup_memory_inotify_wd = -1;
+        u->cgroup_dir_fd = -1;
         u->job_timeout = USEC_INFINITY;
         u->job_running_timeout = USEC_INFINITY;
         u->ref_uid = UID_INVALID;
@@ -2632,6 +2634,8 @@ void unit_notify(Unit *u, UnitActiveState os, UnitActiveState ns, UnitNotifyFlag
 
         m = u->manager;
 
+        TRACE_POINT(systemd, unit_state_change, u->id, unit_active_state_to_string(os), unit_active_state_to_string(ns));
+
         /* Let's enqueue the change signal early. In case this unit has a job associated we want that this unit is in
          * the bus queue, so that any job change signal queued will force out the unit change signal first. */
         unit_add_to_dbus_queue(u);
@@ -5907,6 +5911,16 @@ Unit* unit_has_dependency(const Unit *u, UnitDependencyAtom atom, Unit *other) {
          * NULL checks if the unit has *any* dependency of that atom. Returns 'other' if found (or if 'other'
          * is NULL the first entry found), or NULL if not found. */
 
+        if (other) {
+                UnitDependency d;
+
+                /* If the atom is unique to one dependency type we can look the unit up directly instead of
+                 * iterating through the table */
+                d = unit_dependency_from_unique_atom(atom);
+                if (d >= 0)
+                        return hashmap_contains(hashmap_get(u->dependencies, UNIT_DEPENDENCY_TO_PTR(d)), other) ? other : NULL;
+        }
+
         UNIT_FOREACH_DEPENDENCY(i, u, atom)
                 if (!other || other == i)
                         return i;
@@ -118,15 +118,6 @@ static inline void* UNIT_DEPENDENCY_TO_PTR(UnitDependency d) {
 
 #include "job.h"
 
-struct UnitRef {
-        /* Keeps tracks of references to a unit. This is useful so
-         * that we can merge two units if necessary and correct all
-         * references to them */
-
-        Unit *source, *target;
-        LIST_FIELDS(UnitRef, refs_by_target);
-};
-
 typedef struct Unit {
         Manager *manager;
 
@@ -141,7 +132,10 @@ typedef struct Unit {
 
         /* For each dependency type we can look up another Hashmap with this, whose key is a Unit* object,
          * and whose value encodes why the dependency exists, using the UnitDependencyInfo type. i.e. a
-         * Hashmap(UnitDependency → Hashmap(Unit* → UnitDependencyInfo)) */
+         * Hashmap(UnitDependency → Hashmap(Unit* → UnitDependencyInfo)). Note that this is not as heavy
+         * as it may look: the UnitDependencyInfo is packed into the hashmap value pointer itself, i.e.
+         * edges carry no allocation of their own, maps with few entries store them inline in the
+         * HashmapBase object, and the HashmapBase objects come from a mempool. */
         Hashmap *dependencies;
 
         /* Similar, for RequiresMountsFor= path dependencies. The key is the path, the value the
@@ -310,6 +304,14 @@ typedef struct Unit {
         int cgroup_control_inotify_wd;
         int cgroup_memory_inotify_wd;
 
+        /* Cached O_PATH fd of the unit's cgroup directory on the unified hierarchy, for cheap repeated
+         * attribute reads, or -1 if not opened yet */
+        int cgroup_dir_fd;
+
+        /* The values we wrote into the unit's cgroup attribute files last, so that rewriting an unchanged
+         * configuration can be suppressed. Flushed whenever the cgroup is created anew. */
+        Hashmap *cgroup_attribute_cache;
+
         /* Device Controller BPF program */
         BPFProgram *bpf_device_control_installed;
 
@@ -37,6 +37,7 @@
 #include "parse-util.h"
 #include "process-util.h"
 #include "signal-util.h"
+#include "siphash24.h"
 #include "socket-util.h"
 #include "special.h"
 #include "stat-util.h"
@@ -72,6 +73,11 @@
  * go below 4MB for writing core files to storage. */
 #define PROCESS_SIZE_MIN (4U*1024U*1024U)
 
+/* If the same program crashes with the same signal more often than this within the interval, skip the
+ * expensive parts of crash processing and only log that the crash happened. */
+#define RATELIMIT_INTERVAL_USEC (10 * USEC_PER_MINUTE)
+#define RATELIMIT_BURST 10
+
 /* Make sure to not make this larger than the maximum journal entry
  * size. See DATA_SIZE_MAX in journal-importer.h. */
 assert_cc(JOURNAL_SIZE_MAX <= DATA_SIZE_MAX);
@@ -1270,6 +1276,66 @@ static int gather_pid_metadata(struct iovec_wrapper *iovw, Context *context) {
         return save_context(context, iovw);
 }
 
+static int coredump_ratelimited(const Context *context) {
+        _cleanup_free_ char *comm = NULL, *unit = NULL, *key = NULL, *p = NULL, *v = NULL;
+        static const uint8_t hash_key[16] = {
+                0x45, 0x9c, 0x12, 0xf0, 0x9b, 0x6a, 0x69, 0x4c,
+                0x8e, 0x2d, 0xd1, 0x53, 0x7b, 0x0f, 0xe5, 0x21,
+        };
+        uint64_t count = 1;
+        usec_t ts = 0, n;
+        int r;
+
+        assert(context);
+
+        /* Checks whether we are in a crash storm, i.e. whether the same program crashed with the same
+         * signal many times in short succession. This is consulted before the expensive parts of crash
+         * processing — the /proc metadata capture, core file storage and stack trace extraction — so that a
+         * service crashing in a tight restart loop doesn't turn coredump handling itself into the dominant
+         * load. Since every crash is handled by a fresh instance of us the state is kept in small per-key
+         * files below /var/lib/systemd/coredump, which age out together with the core files. Returns > 0 if
+         * processing of this crash should be abbreviated. */
+
+        if (context->pid == 1)
+                return 0;
+
+        /* PID 1 and journald crashes receive special treatment later on, never abbreviate those. */
+        if (cg_pid_get_unit(context->pid, &unit) >= 0 &&
+            STRPTR_IN_SET(unit, SPECIAL_JOURNALD_SERVICE, SPECIAL_INIT_SCOPE))
+                return 0;
+
+        r = get_process_comm(context->pid, &comm);
+        if (r < 0)
+                return r;
+
+        key = strjoin(comm, "-", strempty(context->meta[META_ARGV_UID]), "-", strempty(context->meta[META_ARGV_SIGNAL]));
+        if (!key)
+                return -ENOMEM;
+
+        if (asprintf(&p, "/var/lib/systemd/coredump/ratelimit-%016" PRIx64,
+                     siphash24(key, strlen(key), hash_key)) < 0)
+                return -ENOMEM;
+
+        n = now(CLOCK_REALTIME);
+
+        r = read_one_line_file(p, &v);
+        if (r >= 0 &&
+            sscanf(v, USEC_FMT " %" PRIu64, &ts, &count) == 2 &&
+            n >= ts && n - ts < RATELIMIT_INTERVAL_USEC)
+                count++;
+        else {
+                ts = n;
+                count = 1;
+        }
+
+        r = write_string_filef(p, WRITE_STRING_FILE_CREATE|WRITE_STRING_FILE_ATOMIC|WRITE_STRING_FILE_MKDIR_0755,
+                               USEC_FMT " %" PRIu64, ts, count);
+        if (r < 0)
+                return r;
+
+        return count > RATELIMIT_BURST;
+}
+
 static int process_kernel(int argc, char* argv[]) {
         Context context = {};
         struct iovec_wrapper *iovw;
@@ -1289,6 +1355,28 @@ static int process_kernel(int argc, char* argv[]) {
         if (r < 0)
                 goto finish;
 
+        /* During a crash storm only record that the crash happened, don't capture the full runtime
+         * metadata or store the core over and over again. */
+        r = coredump_ratelimited(&context);
+        if (r < 0)
+                log_warning_errno(r, "Failed to check coredump rate limit, ignoring: %m");
+        if (r > 0) {
+                char *m;
+
+                m = strjoina("Process ", context.meta[META_ARGV_PID],
+                             " dumped core, but crash processing is currently rate limited, "
+                             "not collecting the full crash metadata or the core itself.");
+
+                (void) iovw_put_string_field(iovw, "COREDUMP_RATELIMITED=", "1");
+                (void) iovw_put_string_field(iovw, "MESSAGE=", m);
+
+                r = sd_journal_sendv(iovw->iovec, iovw->count);
+                if (r < 0)
+                        log_error_errno(r, "Failed to log rate limited coredump: %m");
+
+                goto finish;
+        }
+
         /* Collect the rest of the process metadata retrieved from the runtime */
         r = gather_pid_metadata(iovw, &context);
         if (r < 0)
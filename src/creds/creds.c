@@ -493,7 +493,8 @@ static int verb_decrypt(int argc, char **argv, void *userdata) {
                         timestamp,
                         arg_tpm2_device,
                         input, input_size,
-                        &plaintext, &plaintext_size);
+                        &plaintext, &plaintext_size,
+                        NULL);
         if (r < 0)
                 return r;
 
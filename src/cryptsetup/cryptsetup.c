@@ -570,6 +570,12 @@ static int get_password(
         assert(src);
         assert(ret);
 
+        /* Note that passwords are pushed to and accepted from the kernel keyring (see the
+         * ASK_PASSWORD_PUSH_CACHE/ASK_PASSWORD_ACCEPT_CACHED flags below): when many volumes share a
+         * passphrase, only the first instance prompts, and the others — which run concurrently, the
+         * generated service units carry no ordering between volumes — unlock from the cache without user
+         * interaction. */
+
         if (arg_headless)
                 return log_error_errno(SYNTHETIC_ERRNO(ENOPKG), "Password querying disabled via 'headless' option.");
 
@@ -696,6 +696,9 @@ static int enumerate_partitions(dev_t devnum) {
         if (r <= 0)
                 return r;
 
+        /* This is the only blkid probe of the disk during the generator phase: generators run before
+         * udevd has processed (or even seen) the block devices, hence we must probe ourselves here and
+         * cannot reuse or seed any udev-collected metadata. */
         r = dissect_image(
                         fd,
                         NULL, NULL,
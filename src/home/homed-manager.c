@@ -1844,8 +1844,13 @@ static int manager_rebalance_calculate(Manager *m) {
                 if (!home_shall_rebalance(h)) /* Only look at actual candidates */
                         continue;
 
-                if (home_is_busy(h))
-                        return -EBUSY; /* Let's not rebalance if there's a busy home directory. */
+                if (home_is_busy(h)) {
+                        /* Don't touch homes that are currently worked on, but don't let a single busy home
+                         * stall rebalancing of all the others either — simply leave it at its current size
+                         * this cycle. */
+                        log_debug("Home '%s' is currently busy, leaving it out of this rebalancing cycle.", h->user_name);
+                        continue;
+                }
 
                 r = home_get_disk_status(
                                 h,
@@ -1980,6 +1985,14 @@ static int manager_rebalance_apply(Manager *m) {
 
                 h->rebalance_pending = false;
 
+                if (!ordered_set_isempty(h->pending_operations)) {
+                        /* If explicit operations are queued for this home (e.g. a log-in is waiting), don't
+                         * start a possibly long automatic resize now that they'd be stuck behind. We'll
+                         * catch this home again on the next cycle. */
+                        log_debug("Not rebalancing home '%s', operations are queued for it.", h->user_name);
+                        continue;
+                }
+
                 r = home_resize(h, h->rebalance_goal, /* secret= */ NULL, /* automatic= */ true, &error);
                 if (r < 0)
                         log_warning_errno(r, "Failed to resize home '%s' for rebalancing, ignoring: %s",
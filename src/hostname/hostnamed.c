@@ -73,6 +73,12 @@ typedef struct Context {
         struct stat etc_os_release_stat;
         struct stat etc_machine_info_stat;
 
+        /* Cached DMI data, these can't change without a reboot, hence read them only once per daemon
+         * runtime */
+        char *hardware_vendor;
+        char *hardware_model;
+        bool dmi_read;
+
         Hashmap *polkit_registry;
 } Context;
 
@@ -91,6 +97,8 @@ static void context_destroy(Context *c) {
         assert(c);
 
         context_reset(c, UINT64_MAX);
+        free(c->hardware_vendor);
+        free(c->hardware_model);
         bus_verify_polkit_async_registry_free(c->polkit_registry);
 }
 
@@ -206,6 +214,18 @@ static int get_hardware_model(char **ret) {
         return get_dmi_data("ID_MODEL_FROM_DATABASE", "ID_MODEL", ret);
 }
 
+static void context_read_dmi(Context *c) {
+        assert(c);
+
+        if (c->dmi_read)
+                return;
+
+        (void) get_hardware_vendor(&c->hardware_vendor);
+        (void) get_hardware_model(&c->hardware_model);
+
+        c->dmi_read = true;
+}
+
 static int get_hardware_serial(char **ret) {
         _cleanup_(sd_device_unrefp) sd_device *device = NULL;
         _cleanup_free_ char *b = NULL;
@@ -550,22 +570,20 @@ static int context_write_data_machine_info(Context *c) {
 static int property_get_hardware_property(
                 sd_bus_message *reply,
                 Context *c,
-                HostProperty prop,
-                int (*getter)(char **)) {
-
-        _cleanup_free_ char *from_dmi = NULL;
+                HostProperty prop) {
 
         assert(reply);
         assert(c);
         assert(IN_SET(prop, PROP_VENDOR, PROP_MODEL));
-        assert(getter);
 
         context_read_machine_info(c);
 
-        if (isempty(c->data[prop]))
-                (void) getter(&from_dmi);
+        if (!isempty(c->data[prop]))
+                return sd_bus_message_append(reply, "s", c->data[prop]);
+
+        context_read_dmi(c);
 
-        return sd_bus_message_append(reply, "s", from_dmi ?: c->data[prop]);
+        return sd_bus_message_append(reply, "s", prop == PROP_VENDOR ? c->hardware_vendor : c->hardware_model);
 }
 
 static int property_get_hardware_vendor(
@@ -577,7 +595,7 @@ static int property_get_hardware_vendor(
                 void *userdata,
                 sd_bus_error *error) {
 
-        return property_get_hardware_property(reply, userdata, PROP_VENDOR, get_hardware_vendor);
+        return property_get_hardware_property(reply, userdata, PROP_VENDOR);
 }
 
 static int property_get_hardware_model(
@@ -589,7 +607,7 @@ static int property_get_hardware_model(
                 void *userdata,
                 sd_bus_error *error) {
 
-        return property_get_hardware_property(reply, userdata, PROP_MODEL, get_hardware_model);
+        return property_get_hardware_property(reply, userdata, PROP_MODEL);
 }
 
 static int property_get_hostname(
@@ -1119,7 +1137,7 @@ static int method_get_hardware_serial(sd_bus_message *m, void *userdata, sd_bus_
 
 static int method_describe(sd_bus_message *m, void *userdata, sd_bus_error *error) {
         _cleanup_free_ char *hn = NULL, *dhn = NULL, *in = NULL, *text = NULL,
-                *chassis = NULL, *vendor = NULL, *model = NULL, *serial = NULL;
+                *chassis = NULL, *serial = NULL;
         _cleanup_(sd_bus_message_unrefp) sd_bus_message *reply = NULL;
         _cleanup_(json_variant_unrefp) JsonVariant *v = NULL;
         sd_id128_t product_uuid = SD_ID128_NULL;
@@ -1173,10 +1191,8 @@ static int method_describe(sd_bus_message *m, void *userdata, sd_bus_error *erro
 
         assert_se(uname(&u) >= 0);
 
-        if (isempty(c->data[PROP_VENDOR]))
-                (void) get_hardware_vendor(&vendor);
-        if (isempty(c->data[PROP_MODEL]))
-                (void) get_hardware_model(&model);
+        if (isempty(c->data[PROP_VENDOR]) || isempty(c->data[PROP_MODEL]))
+                context_read_dmi(c);
 
         if (privileged) {
                 /* The product UUID and hardware serial is only available to privileged clients */
@@ -1200,8 +1216,8 @@ static int method_describe(sd_bus_message *m, void *userdata, sd_bus_error *erro
                                        JSON_BUILD_PAIR("OperatingSystemPrettyName", JSON_BUILD_STRING(c->data[PROP_OS_PRETTY_NAME])),
                                        JSON_BUILD_PAIR("OperatingSystemCPEName", JSON_BUILD_STRING(c->data[PROP_OS_CPE_NAME])),
                                        JSON_BUILD_PAIR("OperatingSystemHomeURL", JSON_BUILD_STRING(c->data[PROP_OS_HOME_URL])),
-                                       JSON_BUILD_PAIR("HardwareVendor", JSON_BUILD_STRING(vendor ?: c->data[PROP_VENDOR])),
-                                       JSON_BUILD_PAIR("HardwareModel", JSON_BUILD_STRING(model ?: c->data[PROP_MODEL])),
+                                       JSON_BUILD_PAIR("HardwareVendor", JSON_BUILD_STRING(isempty(c->data[PROP_VENDOR]) ? c->hardware_vendor : c->data[PROP_VENDOR])),
+                                       JSON_BUILD_PAIR("HardwareModel", JSON_BUILD_STRING(isempty(c->data[PROP_MODEL]) ? c->hardware_model : c->data[PROP_MODEL])),
                                        JSON_BUILD_PAIR("HardwareSerial", JSON_BUILD_STRING(serial)),
                                        JSON_BUILD_PAIR_CONDITION(!sd_id128_is_null(product_uuid), "ProductUUID", JSON_BUILD_ID128(product_uuid)),
                                        JSON_BUILD_PAIR_CONDITION(sd_id128_is_null(product_uuid), "ProductUUID", JSON_BUILD_NULL)));
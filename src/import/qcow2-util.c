@@ -4,6 +4,7 @@
 
 #include "alloc-util.h"
 #include "btrfs-util.h"
+#include "memory-util.h"
 #include "qcow2-util.h"
 #include "sparse-endian.h"
 #include "util.h"
@@ -61,30 +62,41 @@ static uint32_t HEADER_HEADER_LENGTH(const Header *h) {
         return be32toh(h->header_length);
 }
 
-static int copy_cluster(
+static int copy_clusters(
                 int sfd, uint64_t soffset,
                 int dfd, uint64_t doffset,
                 uint64_t cluster_size,
+                uint64_t size,
                 void *buffer) {
 
-        ssize_t l;
+        uint64_t copied;
         int r;
 
-        r = btrfs_clone_range(sfd, soffset, dfd, doffset, cluster_size);
+        r = btrfs_clone_range(sfd, soffset, dfd, doffset, size);
         if (r >= 0)
                 return r;
 
-        l = pread(sfd, buffer, cluster_size, soffset);
-        if (l < 0)
-                return -errno;
-        if ((uint64_t) l != cluster_size)
-                return -EIO;
+        for (copied = 0; copied < size; copied += cluster_size) {
+                ssize_t l;
 
-        l = pwrite(dfd, buffer, cluster_size, doffset);
-        if (l < 0)
-                return -errno;
-        if ((uint64_t) l != cluster_size)
-                return -EIO;
+                l = pread(sfd, buffer, cluster_size, soffset + copied);
+                if (l < 0)
+                        return -errno;
+                if ((uint64_t) l != cluster_size)
+                        return -EIO;
+
+                /* The target file is freshly truncated, hence an all-zero cluster is already in place if we
+                 * simply don't write it out, and the output stays sparse. qcow2 v2 images have no way to
+                 * mark zero clusters in the cluster table and store them fully allocated instead. */
+                if (memeqzero(buffer, cluster_size))
+                        continue;
+
+                l = pwrite(dfd, buffer, cluster_size, doffset + copied);
+                if (l < 0)
+                        return -errno;
+                if ((uint64_t) l != cluster_size)
+                        return -EIO;
+        }
 
         return 0;
 }
@@ -307,11 +319,30 @@ int qcow2_convert(int qcow2_fd, int raw_fd) {
                                                 raw_fd, p,
                                                 compressed_size, HEADER_CLUSTER_SIZE(&header),
                                                 buffer1, buffer2);
-                        else
-                                r = copy_cluster(
+                        else {
+                                uint64_t extent_size = HEADER_CLUSTER_SIZE(&header);
+
+                                /* Coalesce runs of clusters that are contiguous in the qcow2 file too, so
+                                 * that we can copy them in one go. */
+                                while (j + 1 < HEADER_L2_SIZE(&header)) {
+                                        uint64_t next_begin, next_compressed_size;
+                                        bool next_compressed;
+
+                                        r = normalize_offset(&header, l2_table[j+1], &next_begin, &next_compressed, &next_compressed_size);
+                                        if (r < 0)
+                                                return r;
+                                        if (r == 0 || next_compressed || next_begin != data_begin + extent_size)
+                                                break;
+
+                                        extent_size += HEADER_CLUSTER_SIZE(&header);
+                                        j++;
+                                }
+
+                                r = copy_clusters(
                                                 qcow2_fd, data_begin,
                                                 raw_fd, p,
-                                                HEADER_CLUSTER_SIZE(&header), buffer1);
+                                                HEADER_CLUSTER_SIZE(&header), extent_size, buffer1);
+                        }
                         if (r < 0)
                                 return r;
                 }
@@ -29,7 +29,6 @@
 #include "parse-util.h"
 #include "pretty-print.h"
 #include "sigbus.h"
-#include "tmpfile-util.h"
 #include "util.h"
 
 #define JOURNAL_WAIT_TIMEOUT (10*USEC_PER_SEC)
@@ -57,6 +56,8 @@ typedef struct RequestMeta {
         bool n_entries_set;
 
         FILE *tmp;
+        char *buffer;
+        size_t buffer_size;
         uint64_t delta, size;
 
         int argument_parse_error;
@@ -102,6 +103,7 @@ static void request_meta_free(
         sd_journal_close(m->journal);
 
         safe_fclose(m->tmp);
+        free(m->buffer);
 
         free(m->cursor);
         free(m);
@@ -124,18 +126,14 @@ static int open_journal(RequestMeta *m) {
 static int request_meta_ensure_tmp(RequestMeta *m) {
         assert(m);
 
+        /* The spool is a memory stream rather than a temporary file: each entry is serialized into it
+         * and copied out again in chunks, hence there is no reason to take the detour through the fs. */
         if (m->tmp)
                 rewind(m->tmp);
         else {
-                _cleanup_close_ int fd = -1;
-
-                fd = open_tmpfile_unlinkable("/tmp", O_RDWR|O_CLOEXEC);
-                if (fd < 0)
-                        return fd;
-
-                m->tmp = take_fdopen(&fd, "w+");
+                m->tmp = open_memstream_unlocked(&m->buffer, &m->buffer_size);
                 if (!m->tmp)
-                        return -errno;
+                        return -ENOMEM;
         }
 
         return 0;
@@ -241,8 +239,9 @@ static ssize_t request_reader_entries(
         if (m->tmp == NULL && m->follow)
                 return 0;
 
-        if (fseeko(m->tmp, pos, SEEK_SET) < 0) {
-                log_error_errno(errno, "Failed to seek to position: %m");
+        /* Make the serialized data visible in the buffer. Note that this may move the buffer. */
+        if (fflush(m->tmp) != 0) {
+                log_error_errno(errno, "Failed to flush memory stream: %m");
                 return MHD_CONTENT_READER_END_WITH_ERROR;
         }
 
@@ -252,12 +251,8 @@ static ssize_t request_reader_entries(
         if (n > max)
                 n = max;
 
-        errno = 0;
-        k = fread(buf, 1, n, m->tmp);
-        if (k != n) {
-                log_error("Failed to read from file: %s", errno != 0 ? strerror_safe(errno) : "Premature EOF");
-                return MHD_CONTENT_READER_END_WITH_ERROR;
-        }
+        memcpy(buf, m->buffer + pos, n);
+        k = n;
 
         return (ssize_t) k;
 }
@@ -591,8 +586,9 @@ static ssize_t request_reader_fields(
                 m->size = (uint64_t) sz;
         }
 
-        if (fseeko(m->tmp, pos, SEEK_SET) < 0) {
-                log_error_errno(errno, "Failed to seek to position: %m");
+        /* Make the serialized data visible in the buffer. Note that this may move the buffer. */
+        if (fflush(m->tmp) != 0) {
+                log_error_errno(errno, "Failed to flush memory stream: %m");
                 return MHD_CONTENT_READER_END_WITH_ERROR;
         }
 
@@ -600,12 +596,8 @@ static ssize_t request_reader_fields(
         if (n > max)
                 n = max;
 
-        errno = 0;
-        k = fread(buf, 1, n, m->tmp);
-        if (k != n) {
-                log_error("Failed to read from file: %s", errno != 0 ? strerror_safe(errno) : "Premature EOF");
-                return MHD_CONTENT_READER_END_WITH_ERROR;
-        }
+        memcpy(buf, m->buffer + pos, n);
+        k = n;
 
         return (ssize_t) k;
 }
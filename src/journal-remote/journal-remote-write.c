@@ -18,15 +18,24 @@ static int do_rotate(ManagedJournalFile **f, MMapCache *m, bool compress, bool s
 Writer* writer_new(RemoteServer *server) {
         Writer *w;
 
+        assert(server);
+
         w = new0(Writer, 1);
         if (!w)
                 return NULL;
 
         memset(&w->metrics, 0xFF, sizeof(w->metrics));
 
-        w->mmap = mmap_cache_new();
-        if (!w->mmap)
-                return mfree(w);
+        /* Share one window cache between all writers: in split-by-host mode one writer (and hence one
+         * journal file) exists per source machine, and giving each its own cache would multiply the
+         * number of mapped windows accordingly. */
+        if (!server->mmap) {
+                server->mmap = mmap_cache_new();
+                if (!server->mmap)
+                        return mfree(w);
+        }
+
+        w->mmap = mmap_cache_ref(server->mmap);
 
         w->n_ref = 1;
         w->server = server;
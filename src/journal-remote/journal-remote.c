@@ -359,6 +359,8 @@ void journal_remote_server_destroy(RemoteServer *s) {
         writer_unref(s->_single_writer);
         hashmap_free(s->writers);
 
+        mmap_cache_unref(s->mmap);
+
         sd_event_source_unref(s->sigterm_event);
         sd_event_source_unref(s->sigint_event);
         sd_event_source_unref(s->listen_event);
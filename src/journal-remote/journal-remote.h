@@ -32,6 +32,9 @@ struct RemoteServer {
         Writer *_single_writer;
         uint64_t event_count;
 
+        /* Window cache shared by all writers, as in journald */
+        MMapCache *mmap;
+
 #if HAVE_MICROHTTPD
         Hashmap *daemons;
 #endif
@@ -144,6 +144,7 @@ static int update_cursor_state(Uploader *u) {
                 goto fail;
         }
 
+        u->cursor_state_saved_timestamp = now(CLOCK_MONOTONIC);
         return 0;
 
 fail:
@@ -467,6 +468,9 @@ static int setup_uploader(Uploader *u, const char *url, const char *state_file)
 static void destroy_uploader(Uploader *u) {
         assert(u);
 
+        /* Write the final cursor position, since perform_upload() only saves it periodically */
+        (void) update_cursor_state(u);
+
         curl_easy_cleanup(u->easy);
         curl_slist_free_all(u->header);
         free(u->answer);
@@ -524,6 +528,13 @@ static int perform_upload(Uploader *u) {
 
         free_and_replace(u->last_cursor, u->current_cursor);
 
+        /* The state file exists to avoid re-uploading everything after a restart, not to track every
+         * single entry, and rewriting it after each upload makes it the I/O hotspot on busy senders.
+         * Persist it at most every 10s here; destroy_uploader() writes the final state on exit. After
+         * a crash we merely upload the last few seconds again. */
+        if (now(CLOCK_MONOTONIC) < usec_add(u->cursor_state_saved_timestamp, JOURNAL_UPLOAD_CURSOR_SAVE_INTERVAL))
+                return 0;
+
         return update_cursor_state(u);
 }
 
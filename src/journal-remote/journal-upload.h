@@ -52,11 +52,13 @@ typedef struct Uploader {
 
         size_t entries_sent;
         char *last_cursor, *current_cursor;
+        usec_t cursor_state_saved_timestamp;
         usec_t watchdog_timestamp;
         usec_t watchdog_usec;
 } Uploader;
 
 #define JOURNAL_UPLOAD_POLL_TIMEOUT (10 * USEC_PER_SEC)
+#define JOURNAL_UPLOAD_CURSOR_SAVE_INTERVAL (10 * USEC_PER_SEC)
 
 int start_upload(Uploader *u,
                  size_t (*input_callback)(void *ptr,
@@ -2007,14 +2007,16 @@ static int verify(sd_journal *j) {
 
         ORDERED_HASHMAP_FOREACH(f, j->files) {
                 int k;
-                usec_t first = 0, validated = 0, last = 0;
+                usec_t first = 0, validated = 0, last = 0, start_usec, duration_usec;
 
 #if HAVE_GCRYPT
                 if (!arg_verify_key && JOURNAL_HEADER_SEALED(f->header))
                         log_notice("Journal file %s has sealing enabled but verification key has not been passed using --verify-key=.", f->path);
 #endif
 
+                start_usec = now(CLOCK_MONOTONIC);
                 k = journal_file_verify(f, arg_verify_key, &first, &validated, &last, true);
+                duration_usec = usec_sub_unsigned(now(CLOCK_MONOTONIC), start_usec);
                 if (k == -EINVAL)
                         /* If the key was invalid give up right-away. */
                         return k;
@@ -2022,7 +2024,11 @@ static int verify(sd_journal *j) {
                         r = log_warning_errno(k, "FAIL: %s (%m)", f->path);
                 else {
                         char a[FORMAT_TIMESTAMP_MAX], b[FORMAT_TIMESTAMP_MAX];
-                        log_info("PASS: %s", f->path);
+                        log_info("PASS: %s (%s in %s, %s/s)",
+                                 f->path,
+                                 FORMAT_BYTES((uint64_t) f->last_stat.st_size),
+                                 FORMAT_TIMESPAN(duration_usec, USEC_PER_MSEC),
+                                 FORMAT_BYTES((uint64_t) f->last_stat.st_size * USEC_PER_SEC / MAX(duration_usec, USEC_PER_MSEC)));
 
                         if (arg_verify_key && JOURNAL_HEADER_SEALED(f->header)) {
                                 if (validated > 0) {
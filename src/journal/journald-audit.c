@@ -24,9 +24,9 @@ static int map_simple_field(
                 struct iovec *iovec,
                 size_t *n) {
 
-        _cleanup_free_ char *c = NULL;
-        size_t l = 0;
         const char *e;
+        size_t l, v;
+        char *c;
 
         assert(field);
         assert(p);
@@ -34,24 +34,18 @@ static int map_simple_field(
         assert(n);
 
         l = strlen(field);
-        c = malloc(l + 1);
+        e = *p + strcspn(*p, " ");
+        v = e - *p;
+
+        c = malloc(l + v + 1);
         if (!c)
                 return -ENOMEM;
 
-        memcpy(c, field, l);
-        for (e = *p; !IN_SET(*e, 0, ' '); e++) {
-                if (!GREEDY_REALLOC(c, l+2))
-                        return -ENOMEM;
-
-                c[l++] = *e;
-        }
-
-        c[l] = 0;
+        *((char*) mempcpy(mempcpy(c, field, l), *p, v)) = 0;
 
-        iovec[(*n)++] = IOVEC_MAKE(c, l);
+        iovec[(*n)++] = IOVEC_MAKE(c, l + v);
 
         *p = e;
-        c = NULL;
 
         return 1;
 }
@@ -92,13 +86,19 @@ static int map_string_field_internal(
 
         } else if (unhexchar(**p) >= 0) {
                 /* Hexadecimal escaping */
+                size_t hl;
+
+                hl = strcspn(*p, " ");
+                if (hl % 2 != 0)
+                        return 0;
+
                 l = strlen(field);
-                c = malloc(l + 2);
+                c = malloc(l + hl / 2 + 1);
                 if (!c)
                         return -ENOMEM;
 
                 memcpy(c, field, l);
-                for (e = *p; !IN_SET(*e, 0, ' '); e += 2) {
+                for (e = *p; e < *p + hl; e += 2) {
                         int a, b;
                         uint8_t x;
 
@@ -115,9 +115,6 @@ static int map_string_field_internal(
                         if (filter_printable && x < (uint8_t) ' ')
                                 x = (uint8_t) ' ';
 
-                        if (!GREEDY_REALLOC(c, l+2))
-                                return -ENOMEM;
-
                         c[l++] = (char) x;
                 }
 
@@ -304,6 +301,11 @@ static int map_all_fields(
 
                 /* Try to map the kernel fields to our own names */
                 for (mf = map_fields; mf->audit_field; mf++) {
+                        /* Checking the first byte inline skips almost all non-matching table
+                         * entries without a call */
+                        if (mf->audit_field[0] != *p)
+                                continue;
+
                         v = startswith(p, mf->audit_field);
                         if (!v)
                                 continue;
@@ -373,6 +375,9 @@ void process_audit_string(Server *s, int type, const char *data, size_t size) {
         if (isempty(p))
                 return;
 
+        if (!server_ratelimit_test(s, NULL, LOG_NOTICE))
+                return;
+
         iovec[n++] = IOVEC_MAKE_STRING("_TRANSPORT=audit");
 
         sprintf(source_time_field, "_SOURCE_REALTIME_TIMESTAMP=%" PRIu64,
@@ -401,6 +406,7 @@ void process_audit_string(Server *s, int type, const char *data, size_t size) {
 
         map_all_fields(p, map_fields_kernel, "_AUDIT_FIELD_", true, iovec, &n, n + N_IOVEC_AUDIT_FIELDS);
 
+        s->n_dispatched_messages_audit++;
         server_dispatch_message(s, iovec, n, ELEMENTSOF(iovec), NULL, NULL, LOG_NOTICE, 0);
 
         /* free() all entries that map_all_fields() added. All others
@@ -18,6 +18,7 @@
 #include "path-util.h"
 #include "process-util.h"
 #include "procfs-util.h"
+#include "string-intern.h"
 #include "string-util.h"
 #include "syslog-util.h"
 #include "unaligned.h"
@@ -158,12 +159,12 @@ static void client_context_reset(Server *s, ClientContext *c) {
         c->loginuid = UID_INVALID;
 
         c->cgroup = mfree(c->cgroup);
-        c->session = mfree(c->session);
+        c->session = string_intern_unref(c->session);
         c->owner_uid = UID_INVALID;
-        c->unit = mfree(c->unit);
-        c->user_unit = mfree(c->user_unit);
-        c->slice = mfree(c->slice);
-        c->user_slice = mfree(c->user_slice);
+        c->unit = string_intern_unref(c->unit);
+        c->user_unit = string_intern_unref(c->user_unit);
+        c->slice = string_intern_unref(c->slice);
+        c->user_slice = string_intern_unref(c->user_slice);
 
         c->invocation_id = SD_ID128_NULL;
 
@@ -281,7 +282,7 @@ static int client_context_read_cgroup(Server *s, ClientContext *c, const char *u
                  * failed or process is running in a root cgroup. Zombie processes are automatically migrated to root cgroup
                  * on cgroup v1 and we want to be able to map log messages from them too. */
                 if (unit_id && !c->unit) {
-                        c->unit = strdup(unit_id);
+                        c->unit = string_intern(unit_id);
                         if (c->unit)
                                 return 0;
                 }
@@ -296,22 +297,27 @@ static int client_context_read_cgroup(Server *s, ClientContext *c, const char *u
         free_and_replace(c->cgroup, t);
 
         (void) cg_path_get_session(c->cgroup, &t);
-        free_and_replace(c->session, t);
+        (void) string_intern_update(&c->session, t);
+        t = mfree(t);
 
         if (cg_path_get_owner_uid(c->cgroup, &c->owner_uid) < 0)
                 c->owner_uid = UID_INVALID;
 
         (void) cg_path_get_unit(c->cgroup, &t);
-        free_and_replace(c->unit, t);
+        (void) string_intern_update(&c->unit, t);
+        t = mfree(t);
 
         (void) cg_path_get_user_unit(c->cgroup, &t);
-        free_and_replace(c->user_unit, t);
+        (void) string_intern_update(&c->user_unit, t);
+        t = mfree(t);
 
         (void) cg_path_get_slice(c->cgroup, &t);
-        free_and_replace(c->slice, t);
+        (void) string_intern_update(&c->slice, t);
+        t = mfree(t);
 
         (void) cg_path_get_user_slice(c->cgroup, &t);
-        free_and_replace(c->user_slice, t);
+        (void) string_intern_update(&c->user_slice, t);
+        t = mfree(t);
 
         return 0;
 }
@@ -320,7 +326,9 @@ static int client_context_read_invocation_id(
                 Server *s,
                 ClientContext *c) {
 
-        _cleanup_free_ char *p = NULL, *value = NULL;
+        _cleanup_free_ char *p = NULL;
+        char value[SD_ID128_STRING_MAX];
+        ssize_t n;
         int r;
 
         assert(s);
@@ -343,9 +351,14 @@ static int client_context_read_invocation_id(
                         return -ENOMEM;
         }
 
-        r = readlink_malloc(p, &value);
-        if (r < 0)
-                return r;
+        /* The link target is always a formatted 128bit ID, hence no need for readlink_malloc() and its
+         * allocation here — this runs on every context refresh. */
+        n = readlink(p, value, sizeof(value));
+        if (n < 0)
+                return -errno;
+        if (n != SD_ID128_STRING_MAX - 1)
+                return -EINVAL;
+        value[n] = 0;
 
         return sd_id128_from_string(value, &c->invocation_id);
 }
@@ -629,6 +642,16 @@ static void client_context_try_shrink_to(Server *s, size_t limit) {
         }
 }
 
+void client_context_flush_regular(Server *s) {
+        assert(s);
+
+        /* Flush out everything not pinned by an active stream or datagram. Called when the system is under
+         * memory pressure, so that we return our caches to the kernel instead of competing for what's
+         * left. */
+
+        client_context_try_shrink_to(s, 0);
+}
+
 void client_context_flush_all(Server *s) {
         assert(s);
 
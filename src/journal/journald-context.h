@@ -32,14 +32,17 @@ struct ClientContext {
         uid_t loginuid;
 
         char *cgroup;
-        char *session;
+
+        /* These are interned since they are typically shared by a large number of clients, see
+         * string-intern.h */
+        const char *session;
         uid_t owner_uid;
 
-        char *unit;
-        char *user_unit;
+        const char *unit;
+        const char *user_unit;
 
-        char *slice;
-        char *user_slice;
+        const char *slice;
+        const char *user_slice;
 
         sd_id128_t invocation_id;
 
@@ -85,6 +88,7 @@ void client_context_maybe_refresh(
 
 void client_context_acquire_default(Server *s);
 void client_context_flush_all(Server *s);
+void client_context_flush_regular(Server *s);
 
 static inline size_t client_context_extra_fields_n_iovec(const ClientContext *c) {
         return c ? c->extra_fields_n_iovec : 0;
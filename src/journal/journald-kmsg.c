@@ -297,7 +297,10 @@ void dev_kmsg_record(Server *s, char *p, size_t l) {
                 iovec[n++] = IOVEC_MAKE_STRING(message);
 
 
-        server_dispatch_message(s, iovec, n, ELEMENTSOF(iovec), c, NULL, priority, 0);
+        if (server_ratelimit_test(s, c, priority)) {
+                s->n_dispatched_messages_kmsg++;
+                server_dispatch_message(s, iovec, n, ELEMENTSOF(iovec), c, NULL, priority, 0);
+        }
 
         if (saved_log_max_level != INT_MAX)
                 log_set_max_level(saved_log_max_level);
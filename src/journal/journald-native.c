@@ -273,6 +273,10 @@ static int server_process_entry(
                         server_forward_wall(s, priority, identifier, message, ucred);
         }
 
+        if (!server_ratelimit_test(s, context, priority))
+                goto finish;
+
+        s->n_dispatched_messages_native++;
         server_dispatch_message(s, iovec, n, MALLOC_ELEMENTSOF(iovec), context, tv, priority, object_pid);
 
 finish:
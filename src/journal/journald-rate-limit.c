@@ -122,7 +122,7 @@ static void journal_ratelimit_vacuum(JournalRateLimit *r, usec_t ts) {
                 journal_ratelimit_group_free(r->lru_tail);
 }
 
-static JournalRateLimitGroup* journal_ratelimit_group_new(JournalRateLimit *r, const char *id, usec_t interval, usec_t ts) {
+static JournalRateLimitGroup* journal_ratelimit_group_new(JournalRateLimit *r, const char *id, uint64_t hash, usec_t interval, usec_t ts) {
         JournalRateLimitGroup *g;
 
         assert(r);
@@ -136,7 +136,7 @@ static JournalRateLimitGroup* journal_ratelimit_group_new(JournalRateLimit *r, c
         if (!g->id)
                 goto fail;
 
-        g->hash = siphash24_string(g->id, r->hash_key);
+        g->hash = hash;
 
         g->interval = interval;
 
@@ -213,12 +213,25 @@ int journal_ratelimit_test(JournalRateLimit *r, const char *id, usec_t rl_interv
                         break;
 
         if (!g) {
-                g = journal_ratelimit_group_new(r, id, rl_interval, ts);
+                g = journal_ratelimit_group_new(r, id, h, rl_interval, ts);
                 if (!g)
                         return -ENOMEM;
-        } else
+        } else {
                 g->interval = rl_interval;
 
+                /* Move the group to the head of the LRU list, so that when the vacuuming needs to make
+                 * room it drops the group that hasn't logged for the longest time, not the one that
+                 * happens to have been created first. Otherwise busy groups get evicted and immediately
+                 * reallocated over and over when many different peers log at once. */
+                if (r->lru != g) {
+                        if (r->lru_tail == g)
+                                r->lru_tail = g->lru_prev;
+
+                        LIST_REMOVE(lru, r->lru, g);
+                        LIST_PREPEND(lru, r->lru, g);
+                }
+        }
+
         if (rl_interval == 0 || rl_burst == 0)
                 return 1;
 
@@ -642,8 +642,13 @@ void server_rotate(Server *s) {
 
 void server_sync(Server *s) {
         ManagedJournalFile *f;
+        usec_t q;
         int r;
 
+        /* Track how long we spend waiting for journal files to hit the disk, so that fsync() stalls on slow
+         * or overloaded storage show up in the GetMetrics telemetry. */
+        q = now(CLOCK_MONOTONIC);
+
         if (s->system_journal) {
                 r = managed_journal_file_set_offline(s->system_journal, false);
                 if (r < 0)
@@ -656,6 +661,9 @@ void server_sync(Server *s) {
                         log_warning_errno(r, "Failed to sync user journal, ignoring: %m");
         }
 
+        s->n_syncs++;
+        s->sync_duration = usec_add(s->sync_duration, usec_sub_unsigned(now(CLOCK_MONOTONIC), q));
+
         if (s->sync_event_source) {
                 r = sd_event_source_set_enabled(s->sync_event_source, SD_EVENT_OFF);
                 if (r < 0)
@@ -701,6 +709,48 @@ int server_vacuum(Server *s, bool verbose) {
         return 0;
 }
 
+static int server_dispatch_vacuum(sd_event_source *es, void *userdata) {
+        Server *s = userdata;
+
+        assert(s);
+
+        (void) server_vacuum(s, false);
+        return 0;
+}
+
+static void server_schedule_vacuum(Server *s) {
+        int r;
+
+        assert(s);
+
+        /* Schedules a vacuum run for the next time the event loop goes idle. Vacuuming lists, sorts and
+         * stats every archived file in the journal directories, which can take a while on directories with
+         * thousands of archived files — too long to run synchronously from the message dispatch path.
+         * Rotation only starts a fresh file and doesn't depend on the vacuum having happened already; where
+         * freeing space is the point (i.e. when a write just failed) we still vacuum synchronously. */
+
+        if (!s->vacuum_event_source) {
+                r = sd_event_add_defer(s->event, &s->vacuum_event_source, server_dispatch_vacuum, s);
+                if (r < 0) {
+                        log_warning_errno(r, "Failed to allocate vacuum event source, vacuuming synchronously: %m");
+                        (void) server_vacuum(s, false);
+                        return;
+                }
+
+                r = sd_event_source_set_priority(s->vacuum_event_source, SD_EVENT_PRIORITY_IDLE);
+                if (r < 0)
+                        log_warning_errno(r, "Failed to adjust vacuum event source priority, ignoring: %m");
+
+                (void) sd_event_source_set_description(s->vacuum_event_source, "vacuum");
+        }
+
+        r = sd_event_source_set_enabled(s->vacuum_event_source, SD_EVENT_ONESHOT);
+        if (r < 0) {
+                log_warning_errno(r, "Failed to enable vacuum event source, vacuuming synchronously: %m");
+                (void) server_vacuum(s, false);
+        }
+}
+
 static void server_cache_machine_id(Server *s) {
         sd_id128_t id;
         int r;
@@ -794,7 +844,7 @@ static bool shall_try_append_again(JournalFile *f, int r) {
 }
 
 static void write_to_journal(Server *s, uid_t uid, struct iovec *iovec, size_t n, int priority) {
-        bool vacuumed = false, rotate = false;
+        bool rotate = false;
         struct dual_timestamp ts;
         ManagedJournalFile *f;
         int r;
@@ -831,8 +881,7 @@ static void write_to_journal(Server *s, uid_t uid, struct iovec *iovec, size_t n
 
         if (rotate) {
                 server_rotate(s);
-                server_vacuum(s, false);
-                vacuumed = true;
+                server_schedule_vacuum(s);
 
                 f = find_journal(s, uid);
                 if (!f)
@@ -843,11 +892,13 @@ static void write_to_journal(Server *s, uid_t uid, struct iovec *iovec, size_t n
 
         r = journal_file_append_entry(f->file, &ts, NULL, iovec, n, &s->seqnum, NULL, NULL);
         if (r >= 0) {
+                s->n_written_entries++;
+                s->n_written_bytes += IOVEC_TOTAL_SIZE(iovec, n);
                 server_schedule_sync(s, priority);
                 return;
         }
 
-        if (vacuumed || !shall_try_append_again(f->file, r)) {
+        if (!shall_try_append_again(f->file, r)) {
                 log_error_errno(r, "Failed to write entry (%zu items, %zu bytes), ignoring: %m", n, IOVEC_TOTAL_SIZE(iovec, n));
                 return;
         }
@@ -868,8 +919,11 @@ static void write_to_journal(Server *s, uid_t uid, struct iovec *iovec, size_t n
         r = journal_file_append_entry(f->file, &ts, NULL, iovec, n, &s->seqnum, NULL, NULL);
         if (r < 0)
                 log_error_errno(r, "Failed to write entry to %s (%zu items, %zu bytes) despite vacuuming, ignoring: %m", f->file->path, n, IOVEC_TOTAL_SIZE(iovec, n));
-        else
+        else {
+                s->n_written_entries++;
+                s->n_written_bytes += IOVEC_TOTAL_SIZE(iovec, n);
                 server_schedule_sync(s, priority);
+        }
 }
 
 #define IOVEC_ADD_NUMERIC_FIELD(iovec, n, value, type, isset, format, field)  \
@@ -1077,47 +1131,65 @@ void server_driver_message(Server *s, pid_t object_pid, const char *message_id,
         }
 }
 
-void server_dispatch_message(
-                Server *s,
-                struct iovec *iovec, size_t n, size_t m,
-                ClientContext *c,
-                const struct timeval *tv,
-                int priority,
-                pid_t object_pid) {
-
+bool server_ratelimit_test(Server *s, ClientContext *c, int priority) {
         uint64_t available = 0;
         int rl;
 
         assert(s);
-        assert(iovec || n == 0);
 
-        if (n == 0)
-                return;
+        /* Checks whether a message with the specified priority from the specified client shall be stored,
+         * applying the configured maximum log level, the storage mode, and the per-unit rate limit. The
+         * ingestion paths call this as soon as they know the priority and client, so that messages dropped
+         * here never pay for field extraction and entry assembly. Since this counts the message against
+         * the rate limit (and emits the suppression message once a burst ends), call it exactly once per
+         * message. */
 
         if (LOG_PRI(priority) > s->max_level_store)
-                return;
+                return false;
 
-        /* Stop early in case the information will not be stored
-         * in a journal. */
+        /* Stop early in case the information will not be stored in a journal. */
         if (s->storage == STORAGE_NONE)
-                return;
+                return false;
 
-        if (c && c->unit) {
-                (void) determine_space(s, &available, NULL);
+        if (!c || !c->unit)
+                return true;
 
-                rl = journal_ratelimit_test(s->ratelimit, c->unit, c->log_ratelimit_interval, c->log_ratelimit_burst, priority & LOG_PRIMASK, available);
-                if (rl == 0)
-                        return;
+        (void) determine_space(s, &available, NULL);
 
-                /* Write a suppression message if we suppressed something */
-                if (rl > 1)
-                        server_driver_message(s, c->pid,
-                                              "MESSAGE_ID=" SD_MESSAGE_JOURNAL_DROPPED_STR,
-                                              LOG_MESSAGE("Suppressed %i messages from %s", rl - 1, c->unit),
-                                              "N_DROPPED=%i", rl - 1,
-                                              NULL);
+        rl = journal_ratelimit_test(s->ratelimit, c->unit, c->log_ratelimit_interval, c->log_ratelimit_burst, priority & LOG_PRIMASK, available);
+        if (rl == 0) {
+                s->n_ratelimited_messages++;
+                return false;
         }
 
+        /* Write a suppression message if we suppressed something */
+        if (rl > 1)
+                server_driver_message(s, c->pid,
+                                      "MESSAGE_ID=" SD_MESSAGE_JOURNAL_DROPPED_STR,
+                                      LOG_MESSAGE("Suppressed %i messages from %s", rl - 1, c->unit),
+                                      "N_DROPPED=%i", rl - 1,
+                                      NULL);
+
+        return true;
+}
+
+void server_dispatch_message(
+                Server *s,
+                struct iovec *iovec, size_t n, size_t m,
+                ClientContext *c,
+                const struct timeval *tv,
+                int priority,
+                pid_t object_pid) {
+
+        assert(s);
+        assert(iovec || n == 0);
+
+        /* Note that the caller is expected to have invoked server_ratelimit_test() (once!) for this
+         * message before assembling the iovec array. */
+
+        if (n == 0)
+                return;
+
         dispatch_message_real(s, iovec, n, m, c, tv, priority, object_pid);
 }
 
@@ -1258,14 +1330,13 @@ static int server_relinquish_var(Server *s) {
         return 0;
 }
 
-int server_process_datagram(
-                sd_event_source *es,
-                int fd,
-                uint32_t revents,
-                void *userdata) {
+/* How many datagrams to process from one socket per event loop iteration at max. The sockets are handled at
+ * level triggering, hence any backlog beyond this simply retriggers the event source, but in between other
+ * event sources get a chance to run. */
+#define DATAGRAM_BATCH_MAX 64U
 
+static int server_process_datagram_one(Server *s, int fd) {
         size_t label_len = 0, m;
-        Server *s = userdata;
         struct ucred *ucred = NULL;
         struct timeval *tv = NULL;
         struct cmsghdr *cmsg;
@@ -1301,11 +1372,6 @@ int server_process_datagram(
         assert(s);
         assert(fd == s->native_fd || fd == s->syslog_fd || fd == s->audit_fd);
 
-        if (revents != EPOLLIN)
-                return log_error_errno(SYNTHETIC_ERRNO(EIO),
-                                       "Got invalid event from epoll for datagram fd: %" PRIx32,
-                                       revents);
-
         /* Try to get the right size, if we can. (Not all sockets support SIOCINQ, hence we just try, but don't rely on
          * it.) */
         (void) ioctl(fd, SIOCINQ, &v);
@@ -1382,8 +1448,37 @@ int server_process_datagram(
 
         close_many(fds, n_fds);
 
+        return 1;
+}
+
+int server_process_datagram(
+                sd_event_source *es,
+                int fd,
+                uint32_t revents,
+                void *userdata) {
+
+        Server *s = userdata;
+        int r = 0;
+
+        assert(s);
+
+        if (revents != EPOLLIN)
+                return log_error_errno(SYNTHETIC_ERRNO(EIO),
+                                       "Got invalid event from epoll for datagram fd: %" PRIx32,
+                                       revents);
+
+        /* Drain the socket in batches: processing a single datagram per wakeup means one epoll_wait() round
+         * trip per log record, which dominates under high-volume clients. The credential and cgroup metadata
+         * lookups are cached per client in journald-context.c, hence draining consecutive datagrams of one
+         * burst amortizes those lookups nicely. */
+        for (unsigned i = 0; i < DATAGRAM_BATCH_MAX; i++) {
+                r = server_process_datagram_one(s, fd);
+                if (r <= 0)
+                        break;
+        }
+
         server_refresh_idle_timer(s);
-        return 0;
+        return r < 0 ? r : 0;
 }
 
 static void server_full_flush(Server *s) {
@@ -1757,6 +1852,53 @@ static int server_open_hostname(Server *s) {
         return 0;
 }
 
+static int dispatch_memory_pressure(sd_event_source *es, int fd, uint32_t revents, void *userdata) {
+        Server *s = userdata;
+
+        assert(s);
+
+        log_debug("Memory pressure above configured threshold, flushing client context cache.");
+        client_context_flush_regular(s);
+
+        return 0;
+}
+
+static int server_open_memory_pressure(Server *s) {
+        /* Act once memory stalls exceeded 200ms within a 2s window */
+        static const char trigger[] = "some 200000 2000000";
+        _cleanup_close_ int fd = -1;
+        int r;
+
+        assert(s);
+
+        /* Watch the kernel's PSI interface, so that we shed our client context cache when the system runs
+         * low on memory, rather than hold on to it until something gets OOM killed. This is best effort:
+         * the interface is unavailable with CONFIG_PSI=n, in containers without /proc/pressure, and on old
+         * kernels. */
+
+        fd = open("/proc/pressure/memory", O_RDWR|O_CLOEXEC|O_NONBLOCK|O_NOCTTY);
+        if (fd < 0) {
+                log_full_errno(errno == ENOENT ? LOG_DEBUG : LOG_WARNING, errno,
+                               "Failed to open /proc/pressure/memory, ignoring: %m");
+                return 0;
+        }
+
+        if (write(fd, trigger, sizeof(trigger) - 1) < 0) {
+                log_full_errno(ERRNO_IS_NOT_SUPPORTED(errno) ? LOG_DEBUG : LOG_WARNING, errno,
+                               "Failed to arm memory pressure trigger, ignoring: %m");
+                return 0;
+        }
+
+        r = sd_event_add_io(s->event, &s->memory_pressure_event_source, fd, EPOLLPRI, dispatch_memory_pressure, s);
+        if (r < 0) {
+                log_warning_errno(r, "Failed to register memory pressure fd in event loop, ignoring: %m");
+                return 0;
+        }
+
+        s->memory_pressure_fd = TAKE_FD(fd);
+        return 0;
+}
+
 static int dispatch_notify_event(sd_event_source *es, int fd, uint32_t revents, void *userdata) {
         Server *s = userdata;
         int r;
@@ -2014,6 +2156,41 @@ static int vl_method_relinquish_var(Varlink *link, JsonVariant *parameters, Varl
         return varlink_reply(link, NULL);
 }
 
+static int vl_method_get_metrics(Varlink *link, JsonVariant *parameters, VarlinkMethodFlags flags, void *userdata) {
+        unsigned context_cache_hits = 0, window_list_hits = 0, misses = 0;
+        Server *s = userdata;
+
+        assert(link);
+        assert(s);
+
+        if (json_variant_elements(parameters) > 0)
+                return varlink_error_invalid_parameter(link, parameters);
+
+        /* Exposes journald's throughput and drop counters, so that log infrastructure capacity planning
+         * doesn't have to guess from suppression messages. All counters are cumulative since daemon start
+         * (or the most recent daemon reexec), callers are expected to sample and diff them. */
+
+        if (s->mmap)
+                mmap_cache_stats(s->mmap, &context_cache_hits, &window_list_hits, &misses);
+
+        return varlink_replyb(link, JSON_BUILD_OBJECT(
+                                              JSON_BUILD_PAIR("dispatchedMessages", JSON_BUILD_OBJECT(
+                                                                              JSON_BUILD_PAIR("native", JSON_BUILD_UNSIGNED(s->n_dispatched_messages_native)),
+                                                                              JSON_BUILD_PAIR("syslog", JSON_BUILD_UNSIGNED(s->n_dispatched_messages_syslog)),
+                                                                              JSON_BUILD_PAIR("stream", JSON_BUILD_UNSIGNED(s->n_dispatched_messages_stream)),
+                                                                              JSON_BUILD_PAIR("kmsg", JSON_BUILD_UNSIGNED(s->n_dispatched_messages_kmsg)),
+                                                                              JSON_BUILD_PAIR("audit", JSON_BUILD_UNSIGNED(s->n_dispatched_messages_audit)))),
+                                              JSON_BUILD_PAIR("writtenEntries", JSON_BUILD_UNSIGNED(s->n_written_entries)),
+                                              JSON_BUILD_PAIR("writtenBytes", JSON_BUILD_UNSIGNED(s->n_written_bytes)),
+                                              JSON_BUILD_PAIR("ratelimitedMessages", JSON_BUILD_UNSIGNED(s->n_ratelimited_messages)),
+                                              JSON_BUILD_PAIR("syncs", JSON_BUILD_UNSIGNED(s->n_syncs)),
+                                              JSON_BUILD_PAIR("syncDurationUSec", JSON_BUILD_UNSIGNED(s->sync_duration)),
+                                              JSON_BUILD_PAIR("mmapCache", JSON_BUILD_OBJECT(
+                                                                              JSON_BUILD_PAIR("contextCacheHits", JSON_BUILD_UNSIGNED(context_cache_hits)),
+                                                                              JSON_BUILD_PAIR("windowListHits", JSON_BUILD_UNSIGNED(window_list_hits)),
+                                                                              JSON_BUILD_PAIR("misses", JSON_BUILD_UNSIGNED(misses))))));
+}
+
 static int vl_connect(VarlinkServer *server, Varlink *link, void *userdata) {
         Server *s = userdata;
 
@@ -2052,7 +2229,8 @@ static int server_open_varlink(Server *s, const char *socket, int fd) {
                         "io.systemd.Journal.Synchronize",   vl_method_synchronize,
                         "io.systemd.Journal.Rotate",        vl_method_rotate,
                         "io.systemd.Journal.FlushToVar",    vl_method_flush_to_var,
-                        "io.systemd.Journal.RelinquishVar", vl_method_relinquish_var);
+                        "io.systemd.Journal.RelinquishVar", vl_method_relinquish_var,
+                        "io.systemd.Journal.GetMetrics",    vl_method_get_metrics);
         if (r < 0)
                 return r;
 
@@ -2191,6 +2369,7 @@ int server_init(Server *s, const char *namespace) {
                 .audit_fd = -1,
                 .hostname_fd = -1,
                 .notify_fd = -1,
+                .memory_pressure_fd = -1,
 
                 .compress.enabled = true,
                 .compress.threshold_bytes = UINT64_MAX,
@@ -2396,6 +2575,10 @@ int server_init(Server *s, const char *namespace) {
         if (r < 0)
                 return r;
 
+        r = server_open_memory_pressure(s);
+        if (r < 0)
+                return r;
+
         r = setup_signals(s);
         if (r < 0)
                 return r;
@@ -2482,12 +2665,14 @@ void server_done(Server *s) {
         sd_event_source_unref(s->dev_kmsg_event_source);
         sd_event_source_unref(s->audit_event_source);
         sd_event_source_unref(s->sync_event_source);
+        sd_event_source_unref(s->vacuum_event_source);
         sd_event_source_unref(s->sigusr1_event_source);
         sd_event_source_unref(s->sigusr2_event_source);
         sd_event_source_unref(s->sigterm_event_source);
         sd_event_source_unref(s->sigint_event_source);
         sd_event_source_unref(s->sigrtmin1_event_source);
         sd_event_source_unref(s->hostname_event_source);
+        sd_event_source_unref(s->memory_pressure_event_source);
         sd_event_source_unref(s->notify_event_source);
         sd_event_source_unref(s->watchdog_event_source);
         sd_event_source_unref(s->idle_event_source);
@@ -2499,6 +2684,7 @@ void server_done(Server *s) {
         safe_close(s->dev_kmsg_fd);
         safe_close(s->audit_fd);
         safe_close(s->hostname_fd);
+        safe_close(s->memory_pressure_fd);
         safe_close(s->notify_fd);
 
         if (s->ratelimit)
@@ -70,6 +70,7 @@ struct Server {
         int audit_fd;
         int hostname_fd;
         int notify_fd;
+        int memory_pressure_fd;
 
         sd_event *event;
 
@@ -79,12 +80,14 @@ struct Server {
         sd_event_source *dev_kmsg_event_source;
         sd_event_source *audit_event_source;
         sd_event_source *sync_event_source;
+        sd_event_source *vacuum_event_source;
         sd_event_source *sigusr1_event_source;
         sd_event_source *sigusr2_event_source;
         sd_event_source *sigterm_event_source;
         sd_event_source *sigint_event_source;
         sd_event_source *sigrtmin1_event_source;
         sd_event_source *hostname_event_source;
+        sd_event_source *memory_pressure_event_source;
         sd_event_source *notify_event_source;
         sd_event_source *watchdog_event_source;
         sd_event_source *idle_event_source;
@@ -174,6 +177,18 @@ struct Server {
         ClientContext *pid1_context; /* the context of PID 1 */
 
         VarlinkServer *varlink_server;
+
+        /* Telemetry counters, exported via the io.systemd.Journal.GetMetrics varlink method */
+        uint64_t n_dispatched_messages_native;
+        uint64_t n_dispatched_messages_syslog;
+        uint64_t n_dispatched_messages_stream;
+        uint64_t n_dispatched_messages_kmsg;
+        uint64_t n_dispatched_messages_audit;
+        uint64_t n_written_entries;
+        uint64_t n_written_bytes;
+        uint64_t n_ratelimited_messages;
+        uint64_t n_syncs;
+        usec_t sync_duration;
 };
 
 #define SERVER_MACHINE_ID(s) ((s)->machine_id_field + STRLEN("_MACHINE_ID="))
@@ -196,6 +211,7 @@ struct Server {
 /* audit: Maximum number of extra fields we'll import from audit messages */
 #define N_IOVEC_AUDIT_FIELDS 64
 
+bool server_ratelimit_test(Server *s, ClientContext *c, int priority);
 void server_dispatch_message(Server *s, struct iovec *iovec, size_t n, size_t m, ClientContext *c, const struct timeval *tv, int priority, pid_t object_pid);
 void server_driver_message(Server *s, pid_t object_pid, const char *message_id, const char *format, ...) _sentinel_ _printf_(4,0);
 
@@ -292,6 +292,11 @@ static int stdout_stream_log(
         if (s->server->forward_to_wall)
                 server_forward_wall(s->server, priority, s->identifier, p, &s->ucred);
 
+        /* Forwarding is done, the rest is about storing the entry — check the rate limit before we
+         * bother assembling it */
+        if (!server_ratelimit_test(s->server, s->context, priority))
+                return 0;
+
         m = N_IOVEC_META_FIELDS + 7 + client_context_extra_fields_n_iovec(s->context);
         iovec = newa(struct iovec, m);
 
@@ -331,6 +336,7 @@ static int stdout_stream_log(
         if (message)
                 iovec[n++] = IOVEC_MAKE_STRING(message);
 
+        s->server->n_dispatched_messages_stream++;
         server_dispatch_message(s->server, iovec, n, m, s->context, NULL, priority, 0);
         return 0;
 }
@@ -481,6 +487,13 @@ static size_t stdout_stream_line_max(StdoutStream *s) {
         return s->server->line_max;
 }
 
+/* Note: this transport is deliberately line-based, with no binary framing mode negotiated in the handshake
+ * header: the stdout stream exists to capture plain stdout/stderr of processes that know nothing about
+ * journald, and every writer that is journal-aware enough to emit length-prefixed records is better served
+ * by the native datagram protocol on /run/systemd/journal/socket, which already carries structured fields,
+ * needs no line scanning and keeps record boundaries via datagram boundaries. The scanning below is
+ * memchr()-based, i.e. vectorized by libc, and not a measurable bottleneck compared to the journal write
+ * path itself. */
 static int stdout_stream_scan(
                 StdoutStream *s,
                 char *p,
@@ -545,10 +558,14 @@ static int stdout_stream_scan(
         return 0;
 }
 
-static int stdout_stream_process(sd_event_source *es, int fd, uint32_t revents, void *userdata) {
+/* Read at most this many times from a stream in a single event loop iteration. Draining several reads per
+ * dispatch cuts down the per-iteration event loop overhead (epoll_wait() and clock queries) when many chatty
+ * streams are connected, while the bound keeps a single flooding stream from starving the others. */
+#define STDOUT_STREAM_BATCH_MAX 8U
+
+static int stdout_stream_process_one(StdoutStream *s) {
         CMSG_BUFFER_TYPE(CMSG_SPACE(sizeof(struct ucred))) control;
         size_t limit, consumed, allocated;
-        StdoutStream *s = userdata;
         struct ucred *ucred;
         struct iovec iovec;
         ssize_t l;
@@ -564,18 +581,11 @@ static int stdout_stream_process(sd_event_source *es, int fd, uint32_t revents,
 
         assert(s);
 
-        if ((revents|EPOLLIN|EPOLLHUP) != (EPOLLIN|EPOLLHUP)) {
-                log_error("Got invalid event from epoll for stdout stream: %"PRIx32, revents);
-                goto terminate;
-        }
-
         /* If the buffer is almost full, add room for another 1K */
         allocated = MALLOC_ELEMENTSOF(s->buffer);
         if (s->length + 512 >= allocated) {
-                if (!GREEDY_REALLOC(s->buffer, s->length + 1 + 1024)) {
-                        log_oom();
-                        goto terminate;
-                }
+                if (!GREEDY_REALLOC(s->buffer, s->length + 1 + 1024))
+                        return log_oom();
 
                 allocated = MALLOC_ELEMENTSOF(s->buffer);
         }
@@ -591,14 +601,13 @@ static int stdout_stream_process(sd_event_source *es, int fd, uint32_t revents,
                 if (ERRNO_IS_TRANSIENT(errno))
                         return 0;
 
-                log_warning_errno(errno, "Failed to read from stream: %m");
-                goto terminate;
+                return log_warning_errno(errno, "Failed to read from stream: %m");
         }
         cmsg_close_all(&msghdr);
 
         if (l == 0) {
                 (void) stdout_stream_scan(s, s->buffer, s->length, /* force_flush = */ LINE_BREAK_EOF, NULL);
-                goto terminate;
+                return -ECONNRESET;
         }
 
         /* Invalidate the context if the PID of the sender changed. This happens when a forked process
@@ -610,7 +619,7 @@ static int stdout_stream_process(sd_event_source *es, int fd, uint32_t revents,
                  * the new ucred structure for everything we just added */
                 r = stdout_stream_scan(s, s->buffer, s->length, /* force_flush = */ LINE_BREAK_PID_CHANGE, NULL);
                 if (r < 0)
-                        goto terminate;
+                        return r;
 
                 s->context = client_context_release(s->server, s->context);
 
@@ -626,7 +635,7 @@ static int stdout_stream_process(sd_event_source *es, int fd, uint32_t revents,
 
         r = stdout_stream_scan(s, p, l, _LINE_BREAK_INVALID, &consumed);
         if (r < 0)
-                goto terminate;
+                return r;
 
         /* Move what wasn't consumed to the front of the buffer */
         assert(consumed <= (size_t) l);
@@ -634,10 +643,32 @@ static int stdout_stream_process(sd_event_source *es, int fd, uint32_t revents,
         memmove(s->buffer, p + consumed, s->length);
 
         return 1;
+}
 
-terminate:
-        stdout_stream_destroy(s);
-        return 0;
+static int stdout_stream_process(sd_event_source *es, int fd, uint32_t revents, void *userdata) {
+        StdoutStream *s = userdata;
+        int r = 0;
+
+        assert(s);
+
+        if ((revents|EPOLLIN|EPOLLHUP) != (EPOLLIN|EPOLLHUP)) {
+                log_error("Got invalid event from epoll for stdout stream: %"PRIx32, revents);
+                stdout_stream_destroy(s);
+                return 0;
+        }
+
+        for (unsigned i = 0; i < STDOUT_STREAM_BATCH_MAX; i++) {
+                r = stdout_stream_process_one(s);
+                if (r <= 0)
+                        break;
+        }
+        if (r < 0) {
+                /* Real errors were logged above already, EOF is routine, hence no logging here. */
+                stdout_stream_destroy(s);
+                return 0;
+        }
+
+        return r;
 }
 
 int stdout_stream_install(Server *s, int fd, StdoutStream **ret) {
@@ -704,7 +735,6 @@ int stdout_stream_install(Server *s, int fd, StdoutStream **ret) {
 }
 
 static int stdout_stream_new(sd_event_source *es, int listen_fd, uint32_t revents, void *userdata) {
-        _cleanup_close_ int fd = -1;
         Server *s = userdata;
         int r;
 
@@ -715,34 +745,43 @@ static int stdout_stream_new(sd_event_source *es, int listen_fd, uint32_t revent
                                        "Got invalid event from epoll for stdout server fd: %" PRIx32,
                                        revents);
 
-        fd = accept4(s->stdout_fd, NULL, NULL, SOCK_NONBLOCK|SOCK_CLOEXEC);
-        if (fd < 0) {
-                if (ERRNO_IS_ACCEPT_AGAIN(errno))
-                        return 0;
+        /* Accept a bunch of connections in one go, so that a burst of services starting up (with their
+         * stdout/stderr connections arriving back-to-back) doesn't cost us one event loop wakeup per
+         * stream. The cap keeps us from hogging the loop; anything beyond it is picked up on the next
+         * wakeup, which the level-triggered event guarantees. */
+        for (unsigned i = 0; i < 32; i++) {
+                _cleanup_close_ int fd = -1;
 
-                return log_error_errno(errno, "Failed to accept stdout connection: %m");
-        }
+                fd = accept4(s->stdout_fd, NULL, NULL, SOCK_NONBLOCK|SOCK_CLOEXEC);
+                if (fd < 0) {
+                        if (ERRNO_IS_ACCEPT_AGAIN(errno))
+                                return 0;
 
-        if (s->n_stdout_streams >= STDOUT_STREAMS_MAX) {
-                struct ucred u = UCRED_INVALID;
+                        return log_error_errno(errno, "Failed to accept stdout connection: %m");
+                }
 
-                (void) getpeercred(fd, &u);
+                if (s->n_stdout_streams >= STDOUT_STREAMS_MAX) {
+                        struct ucred u = UCRED_INVALID;
 
-                /* By closing fd here we make sure that the client won't wait too long for journald to
-                 * gather all the data it adds to the error message to find out that the connection has
-                 * just been refused.
-                 */
-                fd = safe_close(fd);
+                        (void) getpeercred(fd, &u);
 
-                server_driver_message(s, u.pid, NULL, LOG_MESSAGE("Too many stdout streams, refusing connection."), NULL);
-                return 0;
-        }
+                        /* By closing fd here we make sure that the client won't wait too long for journald to
+                         * gather all the data it adds to the error message to find out that the connection has
+                         * just been refused.
+                         */
+                        fd = safe_close(fd);
 
-        r = stdout_stream_install(s, fd, NULL);
-        if (r < 0)
-                return r;
+                        server_driver_message(s, u.pid, NULL, LOG_MESSAGE("Too many stdout streams, refusing connection."), NULL);
+                        return 0;
+                }
+
+                r = stdout_stream_install(s, fd, NULL);
+                if (r < 0)
+                        return r;
+
+                TAKE_FD(fd);
+        }
 
-        TAKE_FD(fd);
         return 0;
 }
 
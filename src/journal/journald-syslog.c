@@ -392,6 +392,11 @@ void server_process_syslog_message(
         if (s->forward_to_wall)
                 server_forward_wall(s, priority, identifier, msg, ucred);
 
+        /* Forwarding is done, the rest is about storing the entry — check the rate limit before we
+         * bother assembling it */
+        if (!server_ratelimit_test(s, context, priority))
+                return;
+
         m = N_IOVEC_META_FIELDS + 8 + client_context_extra_fields_n_iovec(context);
         iovec = newa(struct iovec, m);
 
@@ -447,6 +452,7 @@ void server_process_syslog_message(
                 iovec[n++] = IOVEC_MAKE(msg_raw, hlen + raw_len);
         }
 
+        s->n_dispatched_messages_syslog++;
         server_dispatch_message(s, iovec, n, m, context, tv, priority, 0);
 }
 
@@ -11,6 +11,7 @@
 #include "dhcp-internal.h"
 #include "network-common.h"
 #include "ordered-set.h"
+#include "prioq.h"
 #include "time-util.h"
 
 typedef enum DHCPRawOption {
@@ -40,6 +41,7 @@ typedef struct DHCPLease {
         be32_t gateway;
         uint8_t chaddr[16];
         usec_t expiration;
+        unsigned prioq_idx; /* index into bound_leases_by_expiry, PRIOQ_IDX_NULL for static leases */
 } DHCPLease;
 
 struct sd_dhcp_server {
@@ -76,6 +78,7 @@ struct sd_dhcp_server {
 
         Hashmap *bound_leases_by_client_id;
         Hashmap *bound_leases_by_address;
+        Prioq *bound_leases_by_expiry;
         Hashmap *static_leases_by_client_id;
         Hashmap *static_leases_by_address;
 
@@ -23,6 +23,9 @@ struct sd_lldp_rx {
         Prioq *neighbor_by_expiry;
         Hashmap *neighbor_by_id;
 
+        /* Reusable receive buffer, so that periodic refreshes of unchanged neighbors don't allocate */
+        uint8_t *read_buffer;
+
         uint64_t neighbors_max;
 
         sd_lldp_rx_callback_t callback;
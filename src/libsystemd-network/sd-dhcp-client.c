@@ -782,6 +782,18 @@ static usec_t client_compute_reacquisition_timeout(usec_t now, usec_t expire) {
         return now + MAX(usec_sub_unsigned(expire, now) / 2, 60 * USEC_PER_SEC);
 }
 
+/* RFC2131 section 4.4.5:
+ * Times T1 and T2 SHOULD be chosen with some random "fuzz". The RFC doesn't specify how much; the
+ * fixed -1…+1s retransmission fuzz of section 4.1 is not enough to desynchronize a large number of
+ * clients that acquired their leases in the same instant (e.g. after an uplink flap), whose renewals
+ * would then keep hitting the server as one burst every T1. Hence scale the fuzz with the timespan
+ * it applies to: a uniform offset of up to ±1/64 of the interval, but no less than ±1s. */
+static int64_t client_compute_t_fuzz(usec_t interval) {
+        uint64_t span = MAX(interval / 32, 2 * USEC_PER_SEC);
+
+        return (int64_t) (random_u64() % span) - (int64_t) (span / 2);
+}
+
 static int cmp_uint8(const uint8_t *a, const uint8_t *b) {
         return CMP(*a, *b);
 }
@@ -1706,12 +1718,9 @@ static int client_set_lease_timeouts(sd_dhcp_client *client) {
         client->t1_time = client->request_sent + client->lease->t1 * USEC_PER_SEC;
         client->t2_time = client->request_sent + client->lease->t2 * USEC_PER_SEC;
 
-        /* RFC2131 section 4.4.5:
-         * Times T1 and T2 SHOULD be chosen with some random "fuzz".
-         * Since the RFC doesn't specify here the exact 'fuzz' to use,
-         * we use the range from section 4.1: -1 to +1 sec. */
-        client->t1_time = usec_sub_signed(client->t1_time, RFC2131_RANDOM_FUZZ);
-        client->t2_time = usec_sub_signed(client->t2_time, RFC2131_RANDOM_FUZZ);
+        /* Apply the lease-proportional fuzz, see client_compute_t_fuzz() */
+        client->t1_time = usec_sub_signed(client->t1_time, client_compute_t_fuzz(client->lease->t1 * USEC_PER_SEC));
+        client->t2_time = usec_sub_signed(client->t2_time, client_compute_t_fuzz(client->lease->t2 * USEC_PER_SEC));
 
         /* after fuzzing, ensure t2 is still >= t1 */
         client->t2_time = MAX(client->t1_time, client->t2_time);
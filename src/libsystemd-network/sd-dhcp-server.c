@@ -35,6 +35,7 @@ static DHCPLease *dhcp_lease_free(DHCPLease *lease) {
                 hashmap_remove_value(lease->server->bound_leases_by_client_id, &lease->client_id, lease);
                 hashmap_remove_value(lease->server->static_leases_by_address, UINT32_TO_PTR(lease->address), lease);
                 hashmap_remove_value(lease->server->static_leases_by_client_id, &lease->client_id, lease);
+                prioq_remove(lease->server->bound_leases_by_expiry, lease, &lease->prioq_idx);
         }
 
         free(lease->client_id.data);
@@ -43,6 +44,12 @@ static DHCPLease *dhcp_lease_free(DHCPLease *lease) {
 
 DEFINE_TRIVIAL_CLEANUP_FUNC(DHCPLease*, dhcp_lease_free);
 
+static int dhcp_lease_expiration_compare(const void *a, const void *b) {
+        const DHCPLease *x = a, *y = b;
+
+        return CMP(x->expiration, y->expiration);
+}
+
 /* configures the server's address and subnet, and optionally the pool's size and offset into the subnet
  * the whole pool must fit into the subnet, and may not contain the first (any) nor last (broadcast) address
  * moreover, the server's own address may be in the pool, and is in that case reserved in order not to
@@ -173,6 +180,7 @@ static sd_dhcp_server *dhcp_server_free(sd_dhcp_server *server) {
         server->bound_leases_by_client_id = hashmap_free(server->bound_leases_by_client_id);
         server->static_leases_by_address = hashmap_free(server->static_leases_by_address);
         server->static_leases_by_client_id = hashmap_free(server->static_leases_by_client_id);
+        server->bound_leases_by_expiry = prioq_free(server->bound_leases_by_expiry);
 
         ordered_set_free(server->extra_options);
         ordered_set_free(server->vendor_options);
@@ -949,6 +957,7 @@ static int prepare_new_lease(
                 .hlen = hlen,
                 .gateway = gateway,
                 .expiration = expiration,
+                .prioq_idx = PRIOQ_IDX_NULL,
         };
         lease->client_id.data = memdup(client_id->data, client_id->length);
         if (!lease->client_id.data)
@@ -979,6 +988,7 @@ static int server_ack_request(sd_dhcp_server *server, DHCPRequest *req, DHCPLeas
                 assert(existing_lease->server);
                 assert(existing_lease->address == address);
                 existing_lease->expiration = expiration;
+                prioq_reshuffle(server->bound_leases_by_expiry, existing_lease, &existing_lease->prioq_idx);
 
         } else {
                 _cleanup_(dhcp_lease_freep) DHCPLease *lease = NULL;
@@ -999,6 +1009,10 @@ static int server_ack_request(sd_dhcp_server *server, DHCPRequest *req, DHCPLeas
                 if (r < 0)
                         return log_dhcp_server_errno(server, r, "Could not save lease: %m");
 
+                r = prioq_ensure_put(&server->bound_leases_by_expiry, dhcp_lease_expiration_compare, lease, &lease->prioq_idx);
+                if (r < 0)
+                        return log_dhcp_server_errno(server, r, "Could not save lease: %m");
+
                 TAKE_PTR(lease);
         }
 
@@ -1025,11 +1039,15 @@ static int dhcp_server_cleanup_expired_leases(sd_dhcp_server *server) {
         if (r < 0)
                 return r;
 
-        HASHMAP_FOREACH(lease, server->bound_leases_by_client_id)
-                if (lease->expiration < time_now) {
-                        log_dhcp_server(server, "CLEAN (0x%x)", be32toh(lease->address));
-                        dhcp_lease_free(lease);
-                }
+        /* Bound leases are kept in a priority queue ordered by expiration, hence it is sufficient to
+         * look at its head instead of iterating through all leases. */
+        while ((lease = prioq_peek(server->bound_leases_by_expiry))) {
+                if (lease->expiration >= time_now)
+                        break;
+
+                log_dhcp_server(server, "CLEAN (0x%x)", be32toh(lease->address));
+                dhcp_lease_free(lease);
+        }
 
         return 0;
 }
@@ -1640,6 +1658,7 @@ int sd_dhcp_server_set_static_lease(
         *lease = (DHCPLease) {
                 .address = address->s_addr,
                 .client_id.length = client_id_size,
+                .prioq_idx = PRIOQ_IDX_NULL,
         };
         lease->client_id.data = memdup(client_id, client_id_size);
         if (!lease->client_id.data)
@@ -193,6 +193,8 @@ static int lldp_rx_receive_datagram(sd_event_source *s, int fd, uint32_t revents
         _cleanup_(sd_lldp_neighbor_unrefp) sd_lldp_neighbor *n = NULL;
         ssize_t space, length;
         sd_lldp_rx *lldp_rx = userdata;
+        sd_lldp_neighbor *existing;
+        triple_timestamp timestamp;
         struct timespec ts;
 
         assert(fd >= 0);
@@ -207,13 +209,12 @@ static int lldp_rx_receive_datagram(sd_event_source *s, int fd, uint32_t revents
                 return 0;
         }
 
-        n = lldp_neighbor_new(space);
-        if (!n) {
+        if (!GREEDY_REALLOC(lldp_rx->read_buffer, (size_t) space)) {
                 log_oom_debug();
                 return 0;
         }
 
-        length = recv(fd, LLDP_NEIGHBOR_RAW(n), n->raw_size, MSG_DONTWAIT);
+        length = recv(fd, lldp_rx->read_buffer, (size_t) space, MSG_DONTWAIT);
         if (length < 0) {
                 if (ERRNO_IS_TRANSIENT(errno) || ERRNO_IS_DISCONNECT(errno))
                         return 0;
@@ -222,16 +223,46 @@ static int lldp_rx_receive_datagram(sd_event_source *s, int fd, uint32_t revents
                 return 0;
         }
 
-        if ((size_t) length != n->raw_size) {
+        if (length != space) {
                 log_lldp_rx(lldp_rx, "Packet size mismatch, ignoring");
                 return 0;
         }
 
         /* Try to get the timestamp of this packet if it is known */
         if (ioctl(fd, SIOCGSTAMPNS, &ts) >= 0)
-                triple_timestamp_from_realtime(&n->timestamp, timespec_load(&ts));
+                triple_timestamp_from_realtime(&timestamp, timespec_load(&ts));
         else
-                triple_timestamp_get(&n->timestamp);
+                triple_timestamp_get(&timestamp);
+
+        /* Neighbors refresh their info by resending the very same frame every few seconds. If the
+         * datagram is bit-identical to the last frame of a neighbor we already know there's no point in
+         * parsing it again and churning through a new neighbor object — just restart the TTL. */
+        HASHMAP_FOREACH(existing, lldp_rx->neighbor_by_id)
+                if (existing->raw_size == (size_t) length &&
+                    memcmp(LLDP_NEIGHBOR_RAW(existing), lldp_rx->read_buffer, existing->raw_size) == 0) {
+
+                        if (!lldp_rx_keep_neighbor(lldp_rx, existing)) {
+                                /* The filter configuration changed since this entry was added */
+                                n = sd_lldp_neighbor_ref(existing);
+                                lldp_neighbor_unlink(existing);
+                                lldp_rx_callback(lldp_rx, SD_LLDP_RX_EVENT_REMOVED, n);
+                                return 0;
+                        }
+
+                        existing->timestamp = timestamp;
+                        lldp_rx_start_timer(lldp_rx, existing);
+                        lldp_rx_callback(lldp_rx, SD_LLDP_RX_EVENT_REFRESHED, existing);
+                        return 0;
+                }
+
+        n = lldp_neighbor_new((size_t) length);
+        if (!n) {
+                log_oom_debug();
+                return 0;
+        }
+
+        memcpy(LLDP_NEIGHBOR_RAW(n), lldp_rx->read_buffer, n->raw_size);
+        n->timestamp = timestamp;
 
         (void) lldp_rx_handle_datagram(lldp_rx, n);
         return 0;
@@ -389,6 +420,7 @@ static sd_lldp_rx *lldp_rx_free(sd_lldp_rx *lldp_rx) {
 
         hashmap_free(lldp_rx->neighbor_by_id);
         prioq_free(lldp_rx->neighbor_by_expiry);
+        free(lldp_rx->read_buffer);
         free(lldp_rx->ifname);
         return mfree(lldp_rx);
 }
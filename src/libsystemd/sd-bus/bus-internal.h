@@ -102,6 +102,10 @@ struct node_vtable {
         const sd_bus_vtable *vtable;
         sd_bus_object_find_t find;
 
+        /* Cached introspection XML fragment for this vtable, generated on first use. For fallback vtables
+         * this is shared by all object paths covered by the registration. */
+        char *introspection;
+
         LIST_FIELDS(struct node_vtable, vtables);
 };
 
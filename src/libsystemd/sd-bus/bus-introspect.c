@@ -187,23 +187,13 @@ static int introspect_write_arguments(struct introspect *i, const char *signatur
         }
 }
 
-int introspect_write_interface(
-                struct introspect *i,
-                const char *interface_name,
-                const sd_bus_vtable *v) {
-
+static int introspect_write_interface_members(struct introspect *i, const sd_bus_vtable *v) {
         const sd_bus_vtable *vtable = v;
         const char *names = "";
-        int r;
 
         assert(i);
-        assert(interface_name);
         assert(v);
 
-        r = set_interface_name(i, interface_name);
-        if (r < 0)
-                return r;
-
         for (; v->type != _SD_BUS_VTABLE_END; v = bus_vtable_next(vtable, v)) {
 
                 /* Ignore methods, signals and properties that are
@@ -255,6 +245,69 @@ int introspect_write_interface(
         return 0;
 }
 
+int introspect_write_interface(
+                struct introspect *i,
+                const char *interface_name,
+                const sd_bus_vtable *v) {
+
+        int r;
+
+        assert(i);
+        assert(interface_name);
+        assert(v);
+
+        r = set_interface_name(i, interface_name);
+        if (r < 0)
+                return r;
+
+        return introspect_write_interface_members(i, v);
+}
+
+int introspect_render_interface(const sd_bus_vtable *v, bool trusted, char **ret) {
+        _cleanup_(introspect_free) struct introspect intro = {};
+        int r;
+
+        assert(v);
+        assert(ret);
+
+        /* Renders the member XML of one interface, without the enclosing <interface> element, into a string
+         * that may be cached and written out for any number of objects the vtable is attached to. */
+
+        intro.trusted = trusted;
+
+        intro.f = open_memstream_unlocked(&intro.introspection, &intro.size);
+        if (!intro.f)
+                return -ENOMEM;
+
+        r = introspect_write_interface_members(&intro, v);
+        if (r < 0)
+                return r;
+
+        r = fflush_and_check(intro.f);
+        if (r < 0)
+                return r;
+
+        intro.f = safe_fclose(intro.f);
+        *ret = TAKE_PTR(intro.introspection);
+
+        return 0;
+}
+
+int introspect_write_interface_fragment(struct introspect *i, const char *interface_name, const char *fragment) {
+        int r;
+
+        assert(i);
+        assert(interface_name);
+        assert(fragment);
+
+        r = set_interface_name(i, interface_name);
+        if (r < 0)
+                return r;
+
+        fputs(fragment, i->f);
+        return 0;
+}
+
 int introspect_finish(struct introspect *i, char **ret) {
         int r;
 
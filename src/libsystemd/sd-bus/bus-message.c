@@ -2537,6 +2537,60 @@ _public_ int sd_bus_message_append(sd_bus_message *m, const char *types, ...) {
         return r;
 }
 
+_public_ int sd_bus_message_reserve(sd_bus_message *m, size_t sz) {
+        struct bus_body_part *part;
+        size_t new_allocated, os;
+        void *n, *op;
+
+        assert_return(m, -EINVAL);
+        assert_return(!m->sealed, -EPERM);
+        assert_return(!m->poisoned, -ESTALE);
+
+        /* Pre-allocates space so that the next sz bytes appended to the message body won't require any
+         * further allocation. This is merely a hint: the message contents and size are unaffected, and
+         * appending more than sz bytes afterwards is fine too, it just allocates again. Useful when
+         * marshalling large bodies of known (or easily estimated) size field by field. */
+
+        if (sz == 0)
+                return 0;
+
+        if ((uint64_t) m->body_size + sz > UINT32_MAX)
+                return -ENOMEM;
+
+        if (m->n_body_parts <= 0 || m->body_end->sealed) {
+                part = message_append_part(m);
+                if (!part)
+                        return -ENOMEM;
+        } else
+                part = m->body_end;
+
+        new_allocated = part->size + sz;
+        if (new_allocated <= part->allocated)
+                return 0;
+
+        op = part->data;
+        os = part->size;
+
+        n = realloc(part->data, new_allocated);
+        if (!n) {
+                m->poisoned = true;
+                return -ENOMEM;
+        }
+
+        part->data = n;
+        part->allocated = new_allocated;
+        part->free_this = true;
+
+        /* The part's data possibly moved, hence readjust the pointers we keep into it, just like
+         * message_extend_body() does. */
+        for (struct bus_container *c = m->containers; c < m->containers + m->n_containers; c++)
+                c->array_size = adjust_pointer(c->array_size, op, os, part->data);
+
+        m->error.message = (const char*) adjust_pointer(m->error.message, op, os, part->data);
+
+        return 0;
+}
+
 _public_ int sd_bus_message_append_array_space(
                 sd_bus_message *m,
                 char type,
@@ -4684,13 +4738,42 @@ _public_ int sd_bus_message_skip(sd_bus_message *m, const char *types) {
                         if (r <= 0)
                                 return r;
 
-                        for (;;) {
-                                r = sd_bus_message_skip(m, s);
-                                if (r < 0)
-                                        return r;
-                                if (r == 0)
-                                        break;
-                        }
+                        if (k == 1 && bus_type_is_trivial(s[0])) {
+                                /* Arrays of fixed-size elements carry no per-element framing that
+                                 * would need validating, hence don't bother iterating through them
+                                 * but jump directly to the end, after checking the payload is
+                                 * actually fully contained in the message. */
+
+                                struct bus_container *c = message_get_last_container(m);
+                                ssize_t align;
+                                size_t sz;
+                                void *q;
+
+                                if (BUS_MESSAGE_IS_GVARIANT(m)) {
+                                        align = bus_gvariant_get_alignment(s);
+                                        sz = c->end - c->begin;
+                                } else {
+                                        align = bus_type_get_alignment(s[0]);
+                                        sz = BUS_MESSAGE_BSWAP32(m, *c->array_size);
+                                }
+                                if (align < 0)
+                                        return align;
+
+                                if (sz > 0) {
+                                        r = message_peek_body(m, &m->rindex, align, sz, &q);
+                                        if (r < 0) {
+                                                message_quit_container(m);
+                                                return r;
+                                        }
+                                }
+                        } else
+                                for (;;) {
+                                        r = sd_bus_message_skip(m, s);
+                                        if (r < 0)
+                                                return r;
+                                        if (r == 0)
+                                                break;
+                                }
 
                         r = sd_bus_message_exit_container(m);
                         if (r < 0)
@@ -5586,6 +5669,7 @@ int bus_message_get_blob(sd_bus_message *m, void **buffer, size_t *sz) {
 int bus_message_read_strv_extend(sd_bus_message *m, char ***l) {
         char type;
         const char *contents, *s;
+        size_t n;
         int r;
 
         assert(m);
@@ -5602,9 +5686,11 @@ int bus_message_read_strv_extend(sd_bus_message *m, char ***l) {
         if (r <= 0)
                 return r;
 
+        n = strv_length(*l);
+
         /* sd_bus_message_read_basic() does content validation for us. */
         while ((r = sd_bus_message_read_basic(m, *contents, &s)) > 0) {
-                r = strv_extend(l, s);
+                r = strv_extend_with_size(l, &n, s);
                 if (r < 0)
                         return r;
         }
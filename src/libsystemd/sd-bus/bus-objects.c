@@ -981,7 +981,15 @@ int introspect_path(
                 if (c->vtable[0].flags & SD_BUS_VTABLE_HIDDEN)
                         continue;
 
-                r = introspect_write_interface(&intro, c->interface, c->vtable);
+                /* The interface XML only depends on the vtable, not on the object, hence generate it once
+                 * per registration and reuse it for all paths it applies to. */
+                if (!c->introspection) {
+                        r = introspect_render_interface(c->vtable, bus->trusted, &c->introspection);
+                        if (r < 0)
+                                return r;
+                }
+
+                r = introspect_write_interface_fragment(&intro, c->interface, c->introspection);
                 if (r < 0)
                         return r;
         }
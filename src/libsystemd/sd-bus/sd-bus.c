@@ -42,6 +42,7 @@
 #include "stdio-util.h"
 #include "string-util.h"
 #include "strv.h"
+#include "tracepoint-util.h"
 #include "user-util.h"
 
 #define log_debug_bus_message(m)                                         \
@@ -2935,6 +2936,13 @@ static int process_message(sd_bus *bus, sd_bus_message *m) {
         bus->iteration_counter++;
 
         log_debug_bus_message(m);
+        TRACE_POINT(sd_bus, message_dispatch,
+                    bus_message_type_to_string(m->header->type),
+                    strempty(m->sender),
+                    strempty(m->path),
+                    strempty(m->interface),
+                    strempty(m->member),
+                    BUS_MESSAGE_COOKIE(m));
 
         r = process_hello(bus, m);
         if (r != 0)
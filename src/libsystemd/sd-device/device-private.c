@@ -2,6 +2,7 @@
 
 #include <ctype.h>
 #include <net/if.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 
 #include "sd-device.h"
@@ -989,12 +990,37 @@ void device_set_db_persist(sd_device *device) {
         device->db_persist = true;
 }
 
+static bool device_db_unchanged(const char *path, const char *content, size_t size, mode_t mode) {
+        _cleanup_free_ char *existing = NULL;
+        size_t existing_size;
+        struct stat st;
+
+        assert(path);
+        assert(content || size == 0);
+
+        if (stat(path, &st) < 0)
+                return false;
+
+        if (!S_ISREG(st.st_mode) || (st.st_mode & 07777) != mode)
+                return false;
+
+        if ((uint64_t) st.st_size != size)
+                return false;
+
+        if (read_full_file(path, &existing, &existing_size) < 0)
+                return false;
+
+        return existing_size == size && memcmp(existing, content, size) == 0;
+}
+
 int device_update_db(sd_device *device) {
         const char *id;
         char *path;
         _cleanup_fclose_ FILE *f = NULL;
-        _cleanup_free_ char *path_tmp = NULL;
+        _cleanup_free_ char *path_tmp = NULL, *content = NULL;
+        size_t content_size = 0;
         bool has_info;
+        mode_t mode;
         int r;
 
         assert(device);
@@ -1016,32 +1042,13 @@ int device_update_db(sd_device *device) {
                 return 0;
         }
 
-        /* write a database file */
-        r = mkdir_parents(path, 0755);
-        if (r < 0)
-                return r;
-
-        r = fopen_temporary(path, &f, &path_tmp);
-        if (r < 0)
-                return r;
-
-        /*
-         * set 'sticky' bit to indicate that we should not clean the
-         * database when we transition from initramfs to the real root
-         */
-        if (device->db_persist) {
-                r = fchmod(fileno(f), 01644);
-                if (r < 0) {
-                        r = -errno;
-                        goto fail;
-                }
-        } else {
-                r = fchmod(fileno(f), 0644);
-                if (r < 0) {
-                        r = -errno;
-                        goto fail;
-                }
-        }
+        /* Render the record into memory first, so that we can compare it with what is already on disk, and
+         * skip the rewrite when nothing changed. Repeated change events — common on storage devices — tend
+         * to produce the very same record each time, and replacing it anyway just churns /run and wakes up
+         * everybody watching the directory. */
+        f = open_memstream_unlocked(&content, &content_size);
+        if (!f)
+                return -ENOMEM;
 
         if (has_info) {
                 const char *property, *value, *tag;
@@ -1073,6 +1080,39 @@ int device_update_db(sd_device *device) {
                 fputs("V:" STRINGIFY(LATEST_UDEV_DATABASE_VERSION) "\n", f);
         }
 
+        r = fflush_and_check(f);
+        if (r < 0)
+                return r;
+        f = safe_fclose(f);
+
+        /* The 'sticky' bit indicates that we should not clean the database when we transition from the
+         * initramfs to the real root. */
+        mode = device->db_persist ? 01644 : 0644;
+
+        if (device_db_unchanged(path, content, content_size, mode)) {
+                log_device_debug(device, "sd-device: db file '%s' for '%s' is up-to-date", path, device->devpath);
+                return 0;
+        }
+
+        /* write a database file */
+        r = mkdir_parents(path, 0755);
+        if (r < 0)
+                return r;
+
+        r = fopen_temporary(path, &f, &path_tmp);
+        if (r < 0)
+                return r;
+
+        if (fchmod(fileno(f), mode) < 0) {
+                r = -errno;
+                goto fail;
+        }
+
+        if (fwrite(content, 1, content_size, f) != content_size) {
+                r = -EIO;
+                goto fail;
+        }
+
         r = fflush_and_check(f);
         if (r < 0)
                 goto fail;
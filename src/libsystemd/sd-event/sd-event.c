@@ -2629,6 +2629,12 @@ _public_ int sd_event_source_set_time(sd_event_source *s, uint64_t usec) {
         assert_return(s->event->state != SD_EVENT_FINISHED, -ESTALE);
         assert_return(!event_pid_changed(s->event), -ECHILD);
 
+        /* If the deadline is unmodified and the source is not marked pending, then the prioq ordering and
+         * the armed timerfd are still correct, hence avoid reshuffling the prioqs and re-arming the timer
+         * altogether. Callers tend to re-arm per-connection timeouts like this a lot. */
+        if (s->time.next == usec && !s->pending && !s->ratelimited)
+                return 0;
+
         r = source_set_pending(s, false);
         if (r < 0)
                 return r;
@@ -2676,13 +2682,17 @@ _public_ int sd_event_source_set_time_accuracy(sd_event_source *s, uint64_t usec
         assert_return(s->event->state != SD_EVENT_FINISHED, -ESTALE);
         assert_return(!event_pid_changed(s->event), -ECHILD);
 
+        if (usec == 0)
+                usec = DEFAULT_ACCURACY_USEC;
+
+        /* Same shortcut as in sd_event_source_set_time(): nothing to reorder if this is a no-op. */
+        if (s->time.accuracy == usec && !s->pending && !s->ratelimited)
+                return 0;
+
         r = source_set_pending(s, false);
         if (r < 0)
                 return r;
 
-        if (usec == 0)
-                usec = DEFAULT_ACCURACY_USEC;
-
         s->time.accuracy = usec;
 
         event_source_time_prioq_reshuffle(s);
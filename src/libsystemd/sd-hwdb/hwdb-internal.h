@@ -19,9 +19,13 @@ struct sd_hwdb {
                 const char *map;
         };
 
-        OrderedHashmap *properties;
+        OrderedHashmap *properties; /* points into 'cache', not owned */
         Iterator properties_iterator;
         bool properties_modified;
+
+        /* LRU cache of recently resolved modalias lookups, keyed by modalias string. Owns the property
+         * maps, ordered from least to most recently used. */
+        OrderedHashmap *cache;
 };
 
 /* on-disk trie objects */
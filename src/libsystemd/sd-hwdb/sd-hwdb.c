@@ -345,20 +345,81 @@ static sd_hwdb *hwdb_free(sd_hwdb *hwdb) {
         if (hwdb->map)
                 munmap((void *)hwdb->map, hwdb->st.st_size);
         safe_fclose(hwdb->f);
-        ordered_hashmap_free(hwdb->properties);
+        ordered_hashmap_free(hwdb->cache);
         return mfree(hwdb);
 }
 
 DEFINE_PUBLIC_TRIVIAL_REF_UNREF_FUNC(sd_hwdb, sd_hwdb, hwdb_free)
 
+/* Maximum number of resolved modalias lookups to keep around. During coldplug the same modalias shows up
+ * many times in a row (identical hubs, ports, namespaces), and walking the trie with all its fnmatch()
+ * branches is by far the most expensive part of a query. */
+#define CACHE_ENTRIES_MAX 64U
+
+DEFINE_PRIVATE_HASH_OPS_FULL(cache_hash_ops, char, string_hash_func, string_compare_func, free, OrderedHashmap, ordered_hashmap_free);
+
 static int properties_prepare(sd_hwdb *hwdb, const char *modalias) {
+        _cleanup_free_ char *mcopy = NULL;
+        OrderedHashmap *cached;
+        int r;
+
         assert(hwdb);
         assert(modalias);
 
-        ordered_hashmap_clear(hwdb->properties);
         hwdb->properties_modified = true;
 
-        return trie_search_f(hwdb, modalias);
+        cached = ordered_hashmap_get(hwdb->cache, modalias);
+        if (cached) {
+                void *key;
+
+                /* Move the entry to the end of the cache, so that we always evict the least recently
+                 * used one. */
+                assert_se(ordered_hashmap_remove2(hwdb->cache, modalias, &key) == cached);
+                r = ordered_hashmap_put(hwdb->cache, key, cached);
+                if (r < 0) {
+                        free(key);
+                        ordered_hashmap_free(cached);
+                        return r;
+                }
+
+                hwdb->properties = cached;
+                return 0;
+        }
+
+        hwdb->properties = NULL;
+
+        r = trie_search_f(hwdb, modalias);
+        if (r < 0)
+                goto fail;
+
+        /* Make sure negative results get an (empty) map as well, so that they are cached too. */
+        r = ordered_hashmap_ensure_allocated(&hwdb->properties, &string_hash_ops);
+        if (r < 0)
+                goto fail;
+
+        mcopy = strdup(modalias);
+        if (!mcopy) {
+                r = -ENOMEM;
+                goto fail;
+        }
+
+        while (ordered_hashmap_size(hwdb->cache) >= CACHE_ENTRIES_MAX) {
+                void *key;
+
+                ordered_hashmap_free(ordered_hashmap_steal_first_key_and_value(hwdb->cache, &key));
+                free(key);
+        }
+
+        r = ordered_hashmap_ensure_put(&hwdb->cache, &cache_hash_ops, mcopy, hwdb->properties);
+        if (r < 0)
+                goto fail;
+        TAKE_PTR(mcopy);
+
+        return 0;
+
+fail:
+        hwdb->properties = ordered_hashmap_free(hwdb->properties);
+        return r;
 }
 
 _public_ int sd_hwdb_get(sd_hwdb *hwdb, const char *modalias, const char *key, const char **_value) {
@@ -546,47 +546,97 @@ static int open_mmap(const char *database, int *_fd, struct stat *_st, void **_p
         return 0;
 }
 
-static const char *find_id(void *p, sd_id128_t id) {
-        CatalogItem *f = NULL, key = { .id = id };
-        const CatalogHeader *h = p;
+struct Catalog {
+        void *p;
+        size_t size;
+
+        /* The locale-derived lookup keys, resolved once at open time. Same size as
+         * CatalogItem.language, incl. the terminating NUL byte. */
+        char language[32];
+        char language_fallback[32]; /* "de" if language is "de_DE" */
+};
+
+int catalog_open(const char *database, Catalog **ret) {
+        _cleanup_(catalog_freep) Catalog *c = NULL;
+        _cleanup_close_ int fd = -1;
+        struct stat st;
         const char *loc;
+        int r;
+
+        assert(database);
+        assert(ret);
+
+        c = new0(Catalog, 1);
+        if (!c)
+                return -ENOMEM;
+
+        r = open_mmap(database, &fd, &st, &c->p);
+        if (r < 0)
+                return r;
+
+        c->size = st.st_size;
 
+        /* Resolve the locale into the lookup keys once here, so that repeated lookups don't have to */
         loc = setlocale(LC_MESSAGES, NULL);
         if (!isempty(loc) && !STR_IN_SET(loc, "C", "POSIX")) {
                 size_t len;
 
                 len = strcspn(loc, ".@");
-                if (len > sizeof(key.language) - 1)
+                if (len > sizeof(c->language) - 1)
                         log_debug("LC_MESSAGES value too long, ignoring: \"%.*s\"", (int) len, loc);
                 else {
-                        strncpy(key.language, loc, len);
-                        key.language[len] = '\0';
+                        char *e;
+
+                        strncpy(c->language, loc, len);
+
+                        e = strchr(c->language, '_');
+                        if (e)
+                                strncpy(c->language_fallback, c->language, e - c->language);
+                }
+        }
+
+        *ret = TAKE_PTR(c);
+        return 0;
+}
+
+Catalog* catalog_free(Catalog *c) {
+        if (!c)
+                return NULL;
+
+        if (c->p)
+                munmap(c->p, c->size);
+
+        return mfree(c);
+}
+
+static const char *find_id(const Catalog *c, sd_id128_t id) {
+        CatalogItem *f = NULL, key = { .id = id };
+        const CatalogHeader *h = c->p;
+
+        if (!isempty(c->language)) {
+                strcpy(key.language, c->language);
+
+                f = bsearch(&key,
+                            (const uint8_t*) c->p + le64toh(h->header_size),
+                            le64toh(h->n_items),
+                            le64toh(h->catalog_item_size),
+                            (comparison_fn_t) catalog_compare_func);
+
+                if (!f && !isempty(c->language_fallback)) {
+                        strcpy(key.language, c->language_fallback);
 
                         f = bsearch(&key,
-                                    (const uint8_t*) p + le64toh(h->header_size),
+                                    (const uint8_t*) c->p + le64toh(h->header_size),
                                     le64toh(h->n_items),
                                     le64toh(h->catalog_item_size),
                                     (comparison_fn_t) catalog_compare_func);
-                        if (!f) {
-                                char *e;
-
-                                e = strchr(key.language, '_');
-                                if (e) {
-                                        *e = 0;
-                                        f = bsearch(&key,
-                                                    (const uint8_t*) p + le64toh(h->header_size),
-                                                    le64toh(h->n_items),
-                                                    le64toh(h->catalog_item_size),
-                                                    (comparison_fn_t) catalog_compare_func);
-                                }
-                        }
                 }
         }
 
         if (!f) {
                 zero(key.language);
                 f = bsearch(&key,
-                            (const uint8_t*) p + le64toh(h->header_size),
+                            (const uint8_t*) c->p + le64toh(h->header_size),
                             le64toh(h->n_items),
                             le64toh(h->catalog_item_size),
                             (comparison_fn_t) catalog_compare_func);
@@ -595,46 +645,40 @@ static const char *find_id(void *p, sd_id128_t id) {
         if (!f)
                 return NULL;
 
-        return (const char*) p +
+        return (const char*) c->p +
                 le64toh(h->header_size) +
                 le64toh(h->n_items) * le64toh(h->catalog_item_size) +
                 le64toh(f->offset);
 }
 
-int catalog_get(const char* database, sd_id128_t id, char **_text) {
-        _cleanup_close_ int fd = -1;
-        void *p = NULL;
-        struct stat st = {};
-        char *text = NULL;
-        int r;
+int catalog_get_from(const Catalog *c, sd_id128_t id, char **_text) {
         const char *s;
+        char *text;
 
+        assert(c);
         assert(_text);
 
-        r = open_mmap(database, &fd, &st, &p);
-        if (r < 0)
-                return r;
-
-        s = find_id(p, id);
-        if (!s) {
-                r = -ENOENT;
-                goto finish;
-        }
+        s = find_id(c, id);
+        if (!s)
+                return -ENOENT;
 
         text = strdup(s);
-        if (!text) {
-                r = -ENOMEM;
-                goto finish;
-        }
+        if (!text)
+                return -ENOMEM;
 
         *_text = text;
-        r = 0;
+        return 0;
+}
 
-finish:
-        if (p)
-                munmap(p, st.st_size);
+int catalog_get(const char* database, sd_id128_t id, char **_text) {
+        _cleanup_(catalog_freep) Catalog *c = NULL;
+        int r;
 
-        return r;
+        r = catalog_open(database, &c);
+        if (r < 0)
+                return r;
+
+        return catalog_get_from(c, id, _text);
 }
 
 static char *find_header(const char *s, const char *header) {
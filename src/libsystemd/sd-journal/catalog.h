@@ -9,8 +9,16 @@
 #include "hashmap.h"
 #include "strbuf.h"
 
+/* An open, mmaped catalog database, for doing many lookups without reopening it each time */
+typedef struct Catalog Catalog;
+
+int catalog_open(const char *database, Catalog **ret);
+Catalog* catalog_free(Catalog *c);
+DEFINE_TRIVIAL_CLEANUP_FUNC(Catalog*, catalog_free);
+
 int catalog_import_file(OrderedHashmap *h, const char *path);
 int catalog_update(const char* database, const char* root, const char* const* dirs);
+int catalog_get_from(const Catalog *c, sd_id128_t id, char **data);
 int catalog_get(const char* database, sd_id128_t id, char **data);
 int catalog_list(FILE *f, const char* database, bool oneline);
 int catalog_list_items(FILE *f, const char* database, bool oneline, char **items);
@@ -44,6 +44,28 @@ DEFINE_TRIVIAL_CLEANUP_FUNC_FULL(LZ4F_decompressionContext_t, LZ4F_freeDecompres
 DEFINE_TRIVIAL_CLEANUP_FUNC_FULL(ZSTD_CCtx*, ZSTD_freeCCtx, NULL);
 DEFINE_TRIVIAL_CLEANUP_FUNC_FULL(ZSTD_DCtx*, ZSTD_freeDCtx, NULL);
 
+/* Creating a zstd (de)compression context means allocating a nontrivial work space, which hurts with the
+ * journal's many small DATA objects where the setup cost rivals the actual codec work. Hence keep one
+ * context per thread around and reuse it; zstd resets the session state at the start of every one-shot
+ * operation. The contexts are intentionally leaked on thread exit. */
+static ZSTD_CCtx* zstd_cctx(void) {
+        static thread_local ZSTD_CCtx *cctx = NULL;
+
+        if (!cctx)
+                cctx = ZSTD_createCCtx();
+
+        return cctx;
+}
+
+static ZSTD_DCtx* zstd_dctx(void) {
+        static thread_local ZSTD_DCtx *dctx = NULL;
+
+        if (!dctx)
+                dctx = ZSTD_createDCtx();
+
+        return dctx;
+}
+
 static int zstd_ret_to_errno(size_t ret) {
         switch (ZSTD_getErrorCode(ret)) {
         case ZSTD_error_dstSize_tooSmall:
@@ -140,6 +162,7 @@ int compress_blob_zstd(
                 const void *src, uint64_t src_size,
                 void *dst, size_t dst_alloc_size, size_t *dst_size) {
 #if HAVE_ZSTD
+        ZSTD_CCtx *cctx;
         size_t k;
 
         assert(src);
@@ -148,7 +171,12 @@ int compress_blob_zstd(
         assert(dst_alloc_size > 0);
         assert(dst_size);
 
-        k = ZSTD_compress(dst, dst_alloc_size, src, src_size, 0);
+        cctx = zstd_cctx();
+        if (cctx)
+                k = ZSTD_compressCCtx(cctx, dst, dst_alloc_size, src, src_size, 0);
+        else
+                /* Couldn't allocate the shared context? Use the (slower) one-shot API then. */
+                k = ZSTD_compress(dst, dst_alloc_size, src, src_size, 0);
         if (ZSTD_isError(k))
                 return zstd_ret_to_errno(k);
 
@@ -285,10 +313,12 @@ int decompress_blob_zstd(
         if (!(greedy_realloc(dst, MAX(ZSTD_DStreamOutSize(), size), 1)))
                 return -ENOMEM;
 
-        _cleanup_(ZSTD_freeDCtxp) ZSTD_DCtx *dctx = ZSTD_createDCtx();
+        ZSTD_DCtx *dctx = zstd_dctx();
         if (!dctx)
                 return -ENOMEM;
 
+        ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only);
+
         ZSTD_inBuffer input = {
                 .src = src,
                 .size = src_size,
@@ -488,10 +518,12 @@ int decompress_startswith_zstd(
         if (size < prefix_len + 1)
                 return 0; /* Decompressed text too short to match the prefix and extra */
 
-        _cleanup_(ZSTD_freeDCtxp) ZSTD_DCtx *dctx = ZSTD_createDCtx();
+        ZSTD_DCtx *dctx = zstd_dctx();
         if (!dctx)
                 return -ENOMEM;
 
+        ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only);
+
         if (!(greedy_realloc(buffer, MAX(ZSTD_DStreamOutSize(), prefix_len + 1), 1)))
                 return -ENOMEM;
 
@@ -862,6 +894,7 @@ int compress_stream_zstd(int fdf, int fdt, uint64_t max_bytes, uint64_t *ret_unc
         size_t in_allocsize, out_allocsize;
         size_t z;
         uint64_t left = max_bytes, in_bytes = 0;
+        long n_cpus;
 
         assert(fdf >= 0);
         assert(fdt >= 0);
@@ -879,6 +912,17 @@ int compress_stream_zstd(int fdf, int fdt, uint64_t max_bytes, uint64_t *ret_unc
         if (ZSTD_isError(z))
                 log_debug("Failed to enable ZSTD checksum, ignoring: %s", ZSTD_getErrorName(z));
 
+        /* Compress with worker threads, so that compression overlaps with the read/write loop below. This
+         * matters for the large payloads we are fed here, such as coredumps. Cap the number of workers to
+         * bound the memory overhead. If libzstd was built without threading support this fails, which we'll
+         * ignore, staying single-threaded. */
+        n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        if (n_cpus > 1) {
+                z = ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, (int) MIN(n_cpus, 4L));
+                if (ZSTD_isError(z))
+                        log_debug("Failed to enable ZSTD multi-threaded compression, ignoring: %s", ZSTD_getErrorName(z));
+        }
+
         /* This loop read from the input file, compresses that entire chunk,
          * and writes all output produced to the output file.
          */
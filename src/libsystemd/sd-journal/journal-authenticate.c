@@ -241,37 +241,45 @@ int journal_file_hmac_put_object(JournalFile *f, ObjectType type, Object *o, uin
                         return -EBADMSG;
         }
 
-        gcry_md_write(f->hmac, o, offsetof(ObjectHeader, payload));
+        /* The object header and the leading immutable fields of each object type are contiguous, hence feed
+         * them to the HMAC in a single call: every gcry_md_write() comes with fixed buffer management
+         * overhead that dominates for the small writes the append path does per object. The bytes hashed
+         * (and their order) are exactly as before, so tags stay compatible with existing sealed files. */
+
+        assert_cc(offsetof(Object, data.hash) == offsetof(ObjectHeader, payload));
+        assert_cc(offsetof(Object, field.hash) == offsetof(ObjectHeader, payload));
+        assert_cc(offsetof(Object, entry.seqnum) == offsetof(ObjectHeader, payload));
+        assert_cc(offsetof(Object, tag.seqnum) == offsetof(ObjectHeader, payload));
 
         switch (o->object.type) {
 
         case OBJECT_DATA:
                 /* All but hash and payload are mutable */
-                gcry_md_write(f->hmac, &o->data.hash, sizeof(o->data.hash));
+                gcry_md_write(f->hmac, o, offsetof(Object, data.hash) + sizeof(o->data.hash));
                 gcry_md_write(f->hmac, o->data.payload, le64toh(o->object.size) - offsetof(Object, data.payload));
                 break;
 
         case OBJECT_FIELD:
                 /* Same here */
-                gcry_md_write(f->hmac, &o->field.hash, sizeof(o->field.hash));
+                gcry_md_write(f->hmac, o, offsetof(Object, field.hash) + sizeof(o->field.hash));
                 gcry_md_write(f->hmac, o->field.payload, le64toh(o->object.size) - offsetof(Object, field.payload));
                 break;
 
         case OBJECT_ENTRY:
                 /* All */
-                gcry_md_write(f->hmac, &o->entry.seqnum, le64toh(o->object.size) - offsetof(Object, entry.seqnum));
+                gcry_md_write(f->hmac, o, le64toh(o->object.size));
                 break;
 
         case OBJECT_FIELD_HASH_TABLE:
         case OBJECT_DATA_HASH_TABLE:
         case OBJECT_ENTRY_ARRAY:
-                /* Nothing: everything is mutable */
+                /* Nothing but the header: everything else is mutable */
+                gcry_md_write(f->hmac, o, offsetof(ObjectHeader, payload));
                 break;
 
         case OBJECT_TAG:
                 /* All but the tag itself */
-                gcry_md_write(f->hmac, &o->tag.seqnum, sizeof(o->tag.seqnum));
-                gcry_md_write(f->hmac, &o->tag.epoch, sizeof(o->tag.epoch));
+                gcry_md_write(f->hmac, o, offsetof(Object, tag.tag));
                 break;
         default:
                 return -EINVAL;
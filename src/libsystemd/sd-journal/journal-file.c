@@ -34,6 +34,7 @@
 #include "string-util.h"
 #include "strv.h"
 #include "sync-util.h"
+#include "tracepoint-util.h"
 #include "xattr-util.h"
 
 #define DEFAULT_DATA_HASH_TABLE_SIZE (2047ULL*sizeof(HashItem))
@@ -81,6 +82,9 @@
 /* Reread fstat() of the file for detecting deletions at least this often */
 #define LAST_STAT_REFRESH_USEC (5*USEC_PER_SEC)
 
+/* Once this much new data accumulated, kick off background writeback of the appended region */
+#define WRITE_BEHIND_CHUNK_SIZE (1024ULL * 1024ULL)      /* 1MB */
+
 /* The mmap context to use for the header we pick as one above the last defined typed */
 #define CONTEXT_HEADER _OBJECT_TYPE_MAX
 
@@ -1920,6 +1924,22 @@ void journal_file_post_change(JournalFile *f) {
 
         if (ftruncate(f->fd, f->last_stat.st_size) < 0)
                 log_debug_errno(errno, "Failed to truncate file to its own size: %m");
+
+        /* Opportunistically start writeback of what we appended so far, in large sequential batches. That
+         * way the next synchronous fsync() — on rotation, or at the sync interval — finds most pages
+         * already submitted to the disk and won't stall the event loop for long. This is called from the
+         * coalescing change timer in journald, hence under load this naturally batches many entries into
+         * one writeback request. */
+        if (f->write_behind_offset > (uint64_t) f->last_stat.st_size)
+                /* The file shrunk (rotation reuse?), start over */
+                f->write_behind_offset = 0;
+
+        if ((uint64_t) f->last_stat.st_size >= f->write_behind_offset + WRITE_BEHIND_CHUNK_SIZE) {
+                if (sync_file_range(f->fd, f->write_behind_offset, 0, SYNC_FILE_RANGE_WRITE) < 0)
+                        log_debug_errno(errno, "Failed to start writeback on %s, ignoring: %m", f->path);
+                else
+                        f->write_behind_offset = f->last_stat.st_size;
+        }
 }
 
 static int post_change_thunk(sd_event_source *timer, uint64_t usec, void *userdata) {
@@ -2093,6 +2113,9 @@ int journal_file_append_entry(
         else
                 journal_file_post_change(f);
 
+        if (r >= 0)
+                TRACE_POINT(journal, entry_appended, f->path, n_iovec, ts->realtime);
+
         return r;
 }
 
@@ -2687,6 +2710,16 @@ int journal_file_move_to_entry_by_seqnum(
         assert(f);
         assert(f->header);
 
+        /* When resuming from a cursor most files are typically entirely on one side of the wanted
+         * sequence number. The header records the file's seqnum range and is mapped anyway, so let's use
+         * it to answer such lookups without bisecting through (and possibly faulting in) the entry
+         * arrays at all. */
+        if (direction == DIRECTION_DOWN && seqnum > le64toh(f->header->tail_entry_seqnum))
+                return 0; /* All entries in this file are older than what we look for */
+        if (direction == DIRECTION_UP &&
+            le64toh(f->header->head_entry_seqnum) > 0 && seqnum < le64toh(f->header->head_entry_seqnum))
+                return 0; /* All entries in this file are newer than what we look for */
+
         return generic_array_bisect(
                         f,
                         le64toh(f->header->entry_array_offset),
@@ -2718,6 +2751,29 @@ static int test_object_realtime(JournalFile *f, uint64_t p, uint64_t needle) {
                 return TEST_RIGHT;
 }
 
+/* Check whether a realtime seek in the given direction can possibly produce an entry in this file, judging
+ * only by the entry realtime range recorded in the header. This lets callers skip cold files entirely
+ * without bisecting (and thereby faulting in) their entry arrays. */
+static bool realtime_in_range(JournalFile *f, uint64_t realtime, direction_t direction) {
+        assert(f);
+        assert(f->header);
+
+        if (direction == DIRECTION_DOWN && realtime > le64toh(f->header->tail_entry_realtime))
+                return false;
+
+        if (direction == DIRECTION_UP && realtime < le64toh(f->header->head_entry_realtime))
+                return false;
+
+        return true;
+}
+
+/* Note on clock discontinuities: bisecting the main entry array by realtime relies on per-file realtime
+ * monotonicity. journald maintains that invariant at write time — when the realtime clock steps backwards it
+ * rotates to a fresh file rather than appending out-of-order timestamps (see write_to_journal() in
+ * journald-server.c), and forward steps cannot break the ordering. Hence NTP steps cost at most one extra
+ * file per step, and recording an explicit epoch table object in the file format would buy nothing for
+ * files we write ourselves, while foreign files that violate the invariant wouldn't carry such a table
+ * anyway. */
 int journal_file_move_to_entry_by_realtime(
                 JournalFile *f,
                 uint64_t realtime,
@@ -2727,6 +2783,9 @@ int journal_file_move_to_entry_by_realtime(
         assert(f);
         assert(f->header);
 
+        if (!realtime_in_range(f, realtime, direction))
+                return 0;
+
         return generic_array_bisect(
                         f,
                         le64toh(f->header->entry_array_offset),
@@ -3112,6 +3171,11 @@ int journal_file_move_to_entry_by_realtime_for_data(
         assert(d);
         assert(d->object.type == OBJECT_DATA);
 
+        /* The entries referencing a data object are a subset of the file's entries, hence the file-wide
+         * realtime range applies to them too. */
+        if (!realtime_in_range(f, realtime, direction))
+                return 0;
+
         return generic_array_bisect_plus_one(
                         f,
                         le64toh(d->data.entry_offset),
@@ -3349,6 +3413,7 @@ int journal_file_open(
 
                 .flags = flags,
                 .writable = (flags & O_ACCMODE) != O_RDONLY,
+                .location_prioq_idx = PRIOQ_IDX_NULL,
 
 #if HAVE_ZSTD
                 .compress_zstd = compress,
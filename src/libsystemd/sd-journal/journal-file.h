@@ -14,6 +14,7 @@
 #include "hashmap.h"
 #include "journal-def.h"
 #include "mmap-cache.h"
+#include "prioq.h"
 #include "sparse-endian.h"
 #include "time-util.h"
 
@@ -76,10 +77,16 @@ typedef struct JournalFile {
         LocationType location_type;
         uint64_t last_n_entries;
 
+        /* Index in the sd_journal file queue, or PRIOQ_IDX_NULL if not queued */
+        unsigned location_prioq_idx;
+
         char *path;
         struct stat last_stat;
         usec_t last_stat_usec;
 
+        /* Offset up to which we already kicked off background writeback */
+        uint64_t write_behind_offset;
+
         Header *header;
         HashItem *data_hash_table;
         HashItem *field_hash_table;
@@ -12,6 +12,7 @@
 #include "journal-def.h"
 #include "journal-file.h"
 #include "list.h"
+#include "prioq.h"
 #include "set.h"
 
 typedef struct Match Match;
@@ -34,6 +35,11 @@ struct Match {
         size_t size;
         uint64_t hash; /* old-style jenkins hash. New-style siphash is different per file, hence won't be cached here */
 
+        /* For concrete matches: the resolved data object per journal file, so that iteration doesn't have
+         * to probe the data hash table (and recompute the keyed hash) again on every step. Maps
+         * JournalFile* → MatchCachedData. Entries are dropped when a file is removed. */
+        Hashmap *cached_data;
+
         /* For terms */
         LIST_HEAD(Match, matches);
 };
@@ -75,6 +81,12 @@ struct sd_journal {
         IteratedCache *files_cache;
         MMapCache *mmap;
 
+        /* Files ordered by their current candidate entry, so that interleaved iteration doesn't need to
+         * compare all files on every step. Only files with a valid candidate location are queued; the queue
+         * is flushed whenever the read pointer is detached and rebuilt on direction changes. */
+        Prioq *file_queue;
+        direction_t file_queue_direction;
+
         Location current_location;
 
         JournalFile *current_file;
@@ -119,6 +131,9 @@ struct sd_journal {
         Hashmap *directories_by_wd;
 
         Hashmap *errors;
+
+        /* Message catalog database, opened on first sd_journal_get_catalog() and kept open */
+        struct Catalog *catalog;
 };
 
 char *journal_make_match_string(sd_journal *j);
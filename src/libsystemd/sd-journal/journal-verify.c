@@ -449,20 +449,18 @@ static int verify_data(
         /* We already checked that earlier */
         assert(o->data.entry_offset);
 
+        /* Note that verify_entry_array() ran before us and established that the main entry array consists
+         * of exactly the n_entries entry objects recorded in cache_entry_fd, in order. Hence membership in
+         * that (sorted) list is equivalent to membership in the main entry array, and the bisection over
+         * the compact list below replaces what used to be an additional binary search over the entry array
+         * chain in the journal file itself, once per referenced entry. */
+
         last = q = le64toh(o->data.entry_offset);
         if (!contains_uint64(cache_entry_fd, n_entries, q)) {
                 error(p, "Data object references invalid entry at "OFSfmt, q);
                 return -EBADMSG;
         }
 
-        r = journal_file_move_to_entry_by_offset(f, q, DIRECTION_DOWN, NULL, NULL);
-        if (r < 0)
-                return r;
-        if (r == 0) {
-                error(q, "Entry object doesn't exist in the main entry array");
-                return -EBADMSG;
-        }
-
         i = 1;
         while (i < n) {
                 uint64_t next, m, j;
@@ -502,14 +500,6 @@ static int verify_data(
                                 return -EBADMSG;
                         }
 
-                        r = journal_file_move_to_entry_by_offset(f, q, DIRECTION_DOWN, NULL, NULL);
-                        if (r < 0)
-                                return r;
-                        if (r == 0) {
-                                error(q, "Entry object doesn't exist in the main entry array");
-                                return -EBADMSG;
-                        }
-
                         /* Pointer might have moved, reposition */
                         r = journal_file_move_to_object(f, OBJECT_ENTRY_ARRAY, a, &o);
                         if (r < 0)
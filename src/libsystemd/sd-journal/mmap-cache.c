@@ -48,6 +48,7 @@ struct MMapFileDescriptor {
         int fd;
         int prot;
         bool sigbus;
+        uint64_t last_window_end; /* end offset of the most recently created window, for detecting sequential scans */
         LIST_HEAD(Window, windows);
 };
 
@@ -413,6 +414,16 @@ static int add_mmap(
         if (r < 0)
                 return r;
 
+        /* If this window starts right where the previously created one ended, the caller is scanning the
+         * file sequentially. In that case ask the kernel to page in the whole window asynchronously now,
+         * instead of taking a minor fault per page with the default readahead ramp-up. On random access
+         * patterns this never triggers and behavior is unchanged. */
+        if (woffset > 0 && woffset == f->last_window_end)
+                if (madvise(d, wsize, MADV_WILLNEED) < 0)
+                        log_debug_errno(errno, "madvise(MADV_WILLNEED) failed, ignoring: %m");
+
+        f->last_window_end = woffset + wsize;
+
         w = window_add(f->cache, f, keep_always, woffset, wsize, d);
         if (!w)
                 goto outofmem;
@@ -471,6 +482,17 @@ void mmap_cache_stats_log_debug(MMapCache *m) {
         log_debug("mmap cache statistics: %u context cache hit, %u window list hit, %u miss", m->n_context_cache_hit, m->n_window_list_hit, m->n_missed);
 }
 
+void mmap_cache_stats(MMapCache *m, unsigned *ret_n_context_cache_hit, unsigned *ret_n_window_list_hit, unsigned *ret_n_missed) {
+        assert(m);
+
+        if (ret_n_context_cache_hit)
+                *ret_n_context_cache_hit = m->n_context_cache_hit;
+        if (ret_n_window_list_hit)
+                *ret_n_window_list_hit = m->n_window_list_hit;
+        if (ret_n_missed)
+                *ret_n_missed = m->n_missed;
+}
+
 static void mmap_cache_process_sigbus(MMapCache *m) {
         bool found = false;
         MMapFileDescriptor *f;
@@ -28,5 +28,6 @@ MMapCache* mmap_cache_fd_cache(MMapFileDescriptor *f);
 void mmap_cache_fd_free(MMapFileDescriptor *f);
 
 void mmap_cache_stats_log_debug(MMapCache *m);
+void mmap_cache_stats(MMapCache *m, unsigned *ret_n_context_cache_hit, unsigned *ret_n_window_list_hit, unsigned *ret_n_missed);
 
 bool mmap_cache_fd_got_sigbus(MMapFileDescriptor *f);
@@ -46,6 +46,10 @@
 
 #define JOURNAL_FILES_RECHECK_USEC (2 * USEC_PER_SEC)
 
+/* How much of the head of each journal file to request readahead for before opening the files of a
+ * directory. Covers the header and the typical hash table region that journal_file_open() inspects. */
+#define JOURNAL_FILE_READAHEAD (256U*1024U)
+
 /* The maximum size of variable values we'll expand in catalog entries. We bind this to PATH_MAX for now, as
  * we want to be able to show all officially valid paths at least */
 #define REPLACE_VAR_MAX PATH_MAX
@@ -99,6 +103,19 @@ static int journal_put_error(sd_journal *j, int r, const char *path) {
         return 0;
 }
 
+static void journal_flush_file_queue(sd_journal *j) {
+        JournalFile *f;
+
+        assert(j);
+
+        /* Drop all queued candidate locations. The queue is rebuilt lazily on the next iteration step. */
+
+        while ((f = prioq_pop(j->file_queue)))
+                f->location_prioq_idx = PRIOQ_IDX_NULL;
+
+        j->file_queue = prioq_free(j->file_queue);
+}
+
 static void detach_location(sd_journal *j) {
         JournalFile *f;
 
@@ -107,6 +124,8 @@ static void detach_location(sd_journal *j) {
         j->current_file = NULL;
         j->current_field = 0;
 
+        journal_flush_file_queue(j);
+
         ORDERED_HASHMAP_FOREACH(f, j->files)
                 journal_file_reset_location(f);
 }
@@ -221,10 +240,101 @@ static Match *match_free(Match *m) {
         if (m->parent)
                 LIST_REMOVE(matches, m->parent->matches, m);
 
+        hashmap_free_free(m->cached_data);
         free(m->data);
         return mfree(m);
 }
 
+/* Cached result of resolving a discrete match in one journal file. An offset of 0 encodes a negative
+ * result, which remains valid as long as the file's data object count doesn't change. */
+typedef struct MatchCachedData {
+        uint64_t offset;
+        uint64_t n_data;
+} MatchCachedData;
+
+static void match_forget_file(Match *m, JournalFile *f) {
+        Match *i;
+
+        if (!m)
+                return;
+
+        if (m->type == MATCH_DISCRETE)
+                free(hashmap_remove(m->cached_data, f));
+
+        LIST_FOREACH(matches, i, m->matches)
+                match_forget_file(i, f);
+}
+
+static int match_data_object(Match *m, JournalFile *f, Object **ret, uint64_t *ret_offset) {
+        uint64_t hash, dp = 0;
+        MatchCachedData *c;
+        int r;
+
+        assert(m);
+        assert(m->type == MATCH_DISCRETE);
+        assert(f);
+        assert(ret);
+
+        /* Looks up the data object this match refers to in the specified file, using the cached offset from
+         * an earlier resolution if we have one, so that stepping through entries doesn't redo the hash table
+         * probe over and over. Data objects never move in the append-only journal files, hence positive
+         * results stay valid as long as the file is open; negative results are rechecked once further data
+         * objects have been added. */
+
+        c = hashmap_get(m->cached_data, f);
+        if (c) {
+                if (c->offset == 0 && c->n_data == le64toh(f->header->n_data))
+                        return 0;
+
+                if (c->offset != 0) {
+                        r = journal_file_move_to_object(f, OBJECT_DATA, c->offset, ret);
+                        if (r >= 0) {
+                                if (ret_offset)
+                                        *ret_offset = c->offset;
+
+                                return 1;
+                        }
+
+                        /* Something changed under us? Then redo the hash table probe below. */
+                }
+        }
+
+        /* If the keyed hash logic is used, we need to calculate the hash fresh per file. Otherwise
+         * we can use what we pre-calculated. */
+        if (JOURNAL_HEADER_KEYED_HASH(f->header))
+                hash = journal_file_hash_data(f, m->data, m->size);
+        else
+                hash = m->hash;
+
+        r = journal_file_find_data_object_with_hash(f, m->data, m->size, hash, ret, &dp);
+        if (r < 0)
+                return r;
+
+        if (c) {
+                c->offset = dp;
+                c->n_data = le64toh(f->header->n_data);
+        } else {
+                MatchCachedData *n;
+
+                n = new(MatchCachedData, 1);
+                if (n) {
+                        *n = (MatchCachedData) {
+                                .offset = dp,
+                                .n_data = le64toh(f->header->n_data),
+                        };
+
+                        /* The cache is an optimization only, hence if we can't cache this, proceed anyway */
+                        if (hashmap_ensure_put(&m->cached_data, NULL, f, n) < 0)
+                                free(n);
+                }
+        }
+
+        if (r > 0 && ret_offset)
+                *ret_offset = dp;
+
+        return r;
+}
+
 static Match *match_free_if_empty(Match *m) {
         if (!m || m->matches)
                 return m;
@@ -502,16 +612,8 @@ static int next_for_match(
 
         if (m->type == MATCH_DISCRETE) {
                 Object *d;
-                uint64_t hash;
 
-                /* If the keyed hash logic is used, we need to calculate the hash fresh per file. Otherwise
-                 * we can use what we pre-calculated. */
-                if (JOURNAL_HEADER_KEYED_HASH(f->header))
-                        hash = journal_file_hash_data(f, m->data, m->size);
-                else
-                        hash = m->hash;
-
-                r = journal_file_find_data_object_with_hash(f, m->data, m->size, hash, &d, NULL);
+                r = match_data_object(m, f, &d, NULL);
                 if (r <= 0)
                         return r;
 
@@ -599,14 +701,9 @@ static int find_location_for_match(
 
         if (m->type == MATCH_DISCRETE) {
                 Object *d;
-                uint64_t dp, hash;
-
-                if (JOURNAL_HEADER_KEYED_HASH(f->header))
-                        hash = journal_file_hash_data(f, m->data, m->size);
-                else
-                        hash = m->hash;
+                uint64_t dp;
 
-                r = journal_file_find_data_object_with_hash(f, m->data, m->size, hash, &d, &dp);
+                r = match_data_object(m, f, &d, &dp);
                 if (r <= 0)
                         return r;
 
@@ -822,8 +919,16 @@ static int next_beyond_location(sd_journal *j, JournalFile *f, direction_t direc
         }
 }
 
+static int file_queue_compare_down(const void *a, const void *b) {
+        return journal_file_compare_locations((JournalFile*) a, (JournalFile*) b);
+}
+
+static int file_queue_compare_up(const void *a, const void *b) {
+        return -journal_file_compare_locations((JournalFile*) a, (JournalFile*) b);
+}
+
 static int real_journal_next(sd_journal *j, direction_t direction) {
-        JournalFile *new_file = NULL;
+        JournalFile *f, *new_file;
         unsigned i, n_files;
         const void **files;
         Object *o;
@@ -836,9 +941,29 @@ static int real_journal_next(sd_journal *j, direction_t direction) {
         if (r < 0)
                 return r;
 
+        /* We keep all files that currently have a candidate entry in a priority queue, ordered by that
+         * candidate, so that each iteration step only needs to touch the consumed file (and possible
+         * duplicate carriers) instead of comparing all open files — which matters a lot when interleaving
+         * hundreds of archived files. */
+
+        if (j->file_queue_direction != direction)
+                journal_flush_file_queue(j);
+
+        if (!j->file_queue) {
+                j->file_queue = prioq_new(direction == DIRECTION_DOWN ? file_queue_compare_down : file_queue_compare_up);
+                if (!j->file_queue)
+                        return -ENOMEM;
+
+                j->file_queue_direction = direction;
+        }
+
+        /* Give all files that are not queued with a candidate — newly added ones, and those that hit EOF
+         * earlier (new entries might have been appended in the meantime) — a chance to produce one. */
         for (i = 0; i < n_files; i++) {
-                JournalFile *f = (JournalFile *)files[i];
-                bool found;
+                f = (JournalFile*) files[i];
+
+                if (f->location_prioq_idx != PRIOQ_IDX_NULL)
+                        continue;
 
                 r = next_beyond_location(j, f, direction);
                 if (r < 0) {
@@ -850,22 +975,47 @@ static int real_journal_next(sd_journal *j, direction_t direction) {
                         continue;
                 }
 
-                if (!new_file)
-                        found = true;
-                else {
+                r = prioq_put(j->file_queue, f, &f->location_prioq_idx);
+                if (r < 0)
+                        return r;
+        }
+
+        /* Advance all queued files whose candidate is not actually beyond the current location, i.e. the
+         * file we last consumed an entry from plus any files carrying duplicates of that entry. Being the
+         * "smallest" locations, they surface at the top of the queue. */
+        for (;;) {
+                f = prioq_peek(j->file_queue);
+                if (!f)
+                        return 0;
+
+                if (j->current_location.type == LOCATION_DISCRETE) {
                         int k;
 
-                        k = journal_file_compare_locations(f, new_file);
+                        k = compare_with_location(f, &j->current_location, j->current_file);
+                        if (!(direction == DIRECTION_DOWN ? k > 0 : k < 0)) {
+                                assert_se(prioq_remove(j->file_queue, f, &f->location_prioq_idx) > 0);
+                                f->location_prioq_idx = PRIOQ_IDX_NULL;
+
+                                r = next_beyond_location(j, f, direction);
+                                if (r < 0) {
+                                        log_debug_errno(r, "Can't iterate through %s, ignoring: %m", f->path);
+                                        remove_file_real(j, f);
+                                } else if (r == 0)
+                                        f->location_type = LOCATION_TAIL;
+                                else {
+                                        r = prioq_put(j->file_queue, f, &f->location_prioq_idx);
+                                        if (r < 0)
+                                                return r;
+                                }
 
-                        found = direction == DIRECTION_DOWN ? k < 0 : k > 0;
+                                continue;
+                        }
                 }
 
-                if (found)
-                        new_file = f;
+                break;
         }
 
-        if (!new_file)
-                return 0;
+        new_file = f;
 
         r = journal_file_move_to_object(new_file, OBJECT_ENTRY, new_file->current_offset, &o);
         if (r < 0)
@@ -1385,7 +1535,8 @@ finish:
 static int add_file_by_name(
                 sd_journal *j,
                 const char *prefix,
-                const char *filename) {
+                const char *filename,
+                bool modify_only) {
 
         const char *path;
 
@@ -1400,6 +1551,22 @@ static int add_file_by_name(
                 return 0;
 
         path = prefix_roota(prefix, filename);
+
+        if (modify_only) {
+                JournalFile *f;
+
+                /* On a plain IN_MODIFY event we only need to pick up files we don't track yet: journald
+                 * emits one such event for every append to an active file, and reopening plus re-stating
+                 * the file on each of them is what makes following a busy journal directory expensive. An
+                 * inode replaced under a tracked name always announces itself with IN_CREATE or IN_MOVED_TO
+                 * first, so we cannot miss a rotation this way. */
+                f = ordered_hashmap_get(j->files, path);
+                if (f) {
+                        f->last_seen_generation = j->generation;
+                        return 0;
+                }
+        }
+
         return add_any_file(j, -1, path);
 }
 
@@ -1429,6 +1596,14 @@ static void remove_file_real(sd_journal *j, JournalFile *f) {
 
         (void) ordered_hashmap_remove(j->files, f->path);
 
+        if (f->location_prioq_idx != PRIOQ_IDX_NULL) {
+                (void) prioq_remove(j->file_queue, f, &f->location_prioq_idx);
+                f->location_prioq_idx = PRIOQ_IDX_NULL;
+        }
+
+        /* Drop any cached per-file match resolutions */
+        match_forget_file(j->level0, f);
+
         log_debug("File %s removed.", f->path);
 
         if (j->current_file == f) {
@@ -1571,9 +1746,31 @@ static void directory_enumerate(sd_journal *j, Directory *m, DIR *d) {
         assert(m);
         assert(d);
 
+        /* On a cold cache, opening a directory with many journal files is dominated by synchronously
+         * reading each file's header, one file at a time. Kick off readahead for all file heads first, so
+         * that the kernel fetches them in parallel while we process the files in order. */
+        if (!j->no_new_files) {
+                FOREACH_DIRENT_ALL(de, d, break) {
+                        _cleanup_close_ int fd = -1;
+
+                        if (!dirent_is_journal_file(de))
+                                continue;
+                        if (!file_type_wanted(j->flags, de->d_name))
+                                continue;
+
+                        fd = openat(dirfd(d), de->d_name, O_RDONLY|O_CLOEXEC|O_NOCTTY|O_NONBLOCK);
+                        if (fd < 0)
+                                continue;
+
+                        (void) posix_fadvise(fd, 0, JOURNAL_FILE_READAHEAD, POSIX_FADV_WILLNEED);
+                }
+
+                rewinddir(d);
+        }
+
         FOREACH_DIRENT_ALL(de, d, goto fail) {
                 if (dirent_is_journal_file(de))
-                        (void) add_file_by_name(j, m->path, de->d_name);
+                        (void) add_file_by_name(j, m->path, de->d_name, /* modify_only= */ false);
 
                 if (m->is_root && dirent_is_journal_subdir(de))
                         (void) add_directory(j, m->path, de->d_name);
@@ -2152,6 +2349,8 @@ _public_ void sd_journal_close(sd_journal *j) {
 
         sd_journal_flush_matches(j);
 
+        prioq_free(j->file_queue);
+
         ordered_hashmap_free_with_destructor(j->files, journal_file_close);
         iterated_cache_free(j->files_cache);
 
@@ -2173,6 +2372,8 @@ _public_ void sd_journal_close(sd_journal *j) {
 
         hashmap_free_free(j->errors);
 
+        catalog_free(j->catalog);
+
         free(j->path);
         free(j->prefix);
         free(j->namespace);
@@ -2629,7 +2830,8 @@ static void process_inotify_event(sd_journal *j, const struct inotify_event *e)
                         /* Event for a journal file */
 
                         if (e->mask & (IN_CREATE|IN_MOVED_TO|IN_MODIFY|IN_ATTRIB))
-                                (void) add_file_by_name(j, d->path, e->name);
+                                (void) add_file_by_name(j, d->path, e->name,
+                                                        /* modify_only= */ !(e->mask & (IN_CREATE|IN_MOVED_TO|IN_ATTRIB)));
                         else if (e->mask & (IN_DELETE|IN_MOVED_FROM|IN_UNMOUNT))
                                 remove_file_by_name(j, d->path, e->name);
 
@@ -3255,7 +3457,14 @@ _public_ int sd_journal_get_catalog(sd_journal *j, char **ret) {
         if (r < 0)
                 return r;
 
-        r = catalog_get(CATALOG_DATABASE, id, &text);
+        /* Keep the catalog database open, "journalctl -x" style iteration does one lookup per entry */
+        if (!j->catalog) {
+                r = catalog_open(CATALOG_DATABASE, &j->catalog);
+                if (r < 0)
+                        return r;
+        }
+
+        r = catalog_get_from(j->catalog, id, &text);
         if (r < 0)
                 return r;
 
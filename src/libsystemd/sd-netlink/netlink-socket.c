@@ -8,6 +8,7 @@
 #include "sd-netlink.h"
 
 #include "alloc-util.h"
+#include "errno-util.h"
 #include "fd-util.h"
 #include "format-util.h"
 #include "io-util.h"
@@ -238,8 +239,6 @@ static int socket_recv_message(int fd, struct iovec *iov, uint32_t *ret_mcast_gr
         if (n < 0) {
                 if (n == -ENOBUFS)
                         return log_debug_errno(n, "sd-netlink: kernel receive buffer overrun");
-                if (ERRNO_IS_TRANSIENT(n))
-                        return 0;
                 return (int) n;
         }
 
@@ -272,10 +271,11 @@ static int socket_recv_message(int fd, struct iovec *iov, uint32_t *ret_mcast_gr
 
 /* On success, the number of bytes received is returned and *ret points to the received message
  * which has a valid header and the correct size.
- * If nothing useful was received 0 is returned.
- * On failure, a negative error code is returned.
+ * If a datagram was consumed but did not complete a message (e.g. an intermediate part of a
+ * multi-part dump), 0 is returned.
+ * On failure, a negative error code is returned; in particular -EAGAIN when the socket is drained.
  */
-int socket_read_message(sd_netlink *nl) {
+static int socket_read_message_one(sd_netlink *nl) {
         _cleanup_(sd_netlink_message_unrefp) sd_netlink_message *first = NULL;
         bool multi_part = false, done = false;
         size_t len, allocated;
@@ -418,3 +418,26 @@ int socket_read_message(sd_netlink *nl) {
                 return 0;
         }
 }
+
+/* Maximum number of datagrams to pull in per read. A multi-part dump (e.g. the route or address
+ * enumerations networkd requests on each link) arrives as a long series of datagrams; consuming only
+ * one per call means a full event loop iteration per datagram. Keep the batch bounded so a busy
+ * socket cannot starve other event sources. */
+#define NETLINK_READ_BATCH_MAX 32U
+
+int socket_read_message(sd_netlink *nl) {
+        int r = 0;
+
+        assert(nl);
+
+        for (unsigned i = 0; i < NETLINK_READ_BATCH_MAX; i++) {
+                r = socket_read_message_one(nl);
+                if (r != 0) /* Got a complete message, or failed */
+                        break;
+        }
+
+        if (ERRNO_IS_TRANSIENT(r)) /* Socket is drained */
+                return 0;
+
+        return r;
+}
@@ -3801,7 +3801,7 @@ int match_job_removed(sd_bus_message *message, void *userdata, sd_bus_error *err
                         session->scope_job = mfree(session->scope_job);
                         (void) session_jobs_reply(session, id, unit, result);
 
-                        session_save(session);
+                        session_add_to_save_queue(session);
                         user_save(session->user);
                 }
 
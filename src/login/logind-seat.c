@@ -254,12 +254,12 @@ int seat_set_active(Seat *s, Session *session) {
         seat_save(s);
 
         if (session) {
-                session_save(session);
+                session_add_to_save_queue(session);
                 user_save(session->user);
         }
 
         if (old_active) {
-                session_save(old_active);
+                session_add_to_save_queue(old_active);
                 if (!session || session->user != old_active->user)
                         user_save(old_active->user);
         }
@@ -455,7 +455,7 @@ static int method_take_device(sd_bus_message *message, void *userdata, sd_bus_er
         if (r < 0)
                 goto error;
 
-        session_save(s);
+        session_add_to_save_queue(s);
         return 1;
 
 error:
@@ -489,7 +489,7 @@ static int method_release_device(sd_bus_message *message, void *userdata, sd_bus
                 return sd_bus_error_set(error, BUS_ERROR_DEVICE_NOT_TAKEN, "Device not taken");
 
         session_device_free(sd);
-        session_save(s);
+        session_add_to_save_queue(s);
 
         return sd_bus_reply_method_return(message, NULL);
 }
@@ -763,10 +763,12 @@ int session_send_lock_all(Manager *m, bool lock) {
 static bool session_ready(Session *s) {
         assert(s);
 
-        /* Returns true when the session is ready, i.e. all jobs we enqueued for it are done (regardless if successful or not) */
+        /* Returns true when the session is ready, i.e. all jobs we enqueued for it are done (regardless if
+         * successful or not). Only sessions of the "user" class wait for the user service manager too, see
+         * session_start_scope() for the matching job ordering. */
 
         return !s->scope_job &&
-                !s->user->service_job;
+                (s->class != SESSION_USER || !s->user->service_job);
 }
 
 int session_send_create_reply(Session *s, sd_bus_error *error) {
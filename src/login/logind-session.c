@@ -93,6 +93,9 @@ Session* session_free(Session *s) {
         if (s->in_gc_queue)
                 LIST_REMOVE(gc_queue, s->manager->session_gc_queue, s);
 
+        if (s->in_save_queue)
+                LIST_REMOVE(save_queue, s->manager->session_save_queue, s);
+
         s->timer_event_source = sd_event_source_unref(s->timer_event_source);
 
         session_drop_controller(s);
@@ -666,11 +669,19 @@ static int session_start_scope(Session *s, sd_bus_message *properties, sd_bus_er
                                 /* These two have StopWhenUnneeded= set, hence add a dep towards them */
                                 STRV_MAKE(s->user->runtime_dir_service,
                                           s->user->service),
-                                /* And order us after some more */
+                                /* And order us after some more. Only sessions of the "user" class wait for
+                                 * the user service manager: their clients expect to be able to talk to it
+                                 * right away. Greeters, lock screens and background sessions just need the
+                                 * runtime directory and shouldn't be held up behind user@.service
+                                 * start-up. */
+                                s->class == SESSION_USER ?
                                 STRV_MAKE("systemd-logind.service",
                                           "systemd-user-sessions.service",
                                           s->user->runtime_dir_service,
-                                          s->user->service),
+                                          s->user->service) :
+                                STRV_MAKE("systemd-logind.service",
+                                          "systemd-user-sessions.service",
+                                          s->user->runtime_dir_service),
                                 user_record_home_directory(s->user->user_record),
                                 properties,
                                 error,
@@ -1039,7 +1050,7 @@ void session_set_type(Session *s, SessionType t) {
                 return;
 
         s->type = t;
-        session_save(s);
+        session_add_to_save_queue(s);
 
         session_send_changed(s, "Type", NULL);
 }
@@ -1161,6 +1172,19 @@ void session_add_to_gc_queue(Session *s) {
         s->in_gc_queue = true;
 }
 
+void session_add_to_save_queue(Session *s) {
+        assert(s);
+
+        /* Schedules a state file update for when we next return to the event loop, so that a burst of
+         * property changes is coalesced into a single write. Callers after which another process might
+         * immediately look at the state file must use session_save() directly instead. */
+        if (s->in_save_queue)
+                return;
+
+        LIST_PREPEND(save_queue, s->manager->session_save_queue, s);
+        s->in_save_queue = true;
+}
+
 SessionState session_get_state(Session *s) {
         assert(s);
 
@@ -1394,7 +1418,7 @@ int session_set_controller(Session *s, const char *sender, bool force, bool prep
 
         session_release_controller(s, true);
         s->controller = TAKE_PTR(name);
-        session_save(s);
+        session_add_to_save_queue(s);
 
         return 0;
 }
@@ -1408,7 +1432,7 @@ void session_drop_controller(Session *s) {
         s->track = sd_bus_track_unref(s->track);
         session_set_type(s, s->original_type);
         session_release_controller(s, false);
-        session_save(s);
+        session_add_to_save_queue(s);
         session_restore_vt(s);
 }
 
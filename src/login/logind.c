@@ -1129,6 +1129,21 @@ static int manager_startup(Manager *m) {
         return 0;
 }
 
+static void manager_save_dirty_sessions(Manager *m) {
+        Session *session;
+
+        assert(m);
+
+        /* Writes out the state files of all sessions marked dirty since we last returned to the event loop,
+         * coalescing any burst of changes to one session into a single write. */
+        while ((session = m->session_save_queue)) {
+                LIST_REMOVE(save_queue, m->session_save_queue, session);
+                session->in_save_queue = false;
+
+                (void) session_save(session);
+        }
+}
+
 static int manager_run(Manager *m) {
         int r;
 
@@ -1138,10 +1153,13 @@ static int manager_run(Manager *m) {
                 r = sd_event_get_state(m->event);
                 if (r < 0)
                         return r;
-                if (r == SD_EVENT_FINISHED)
+                if (r == SD_EVENT_FINISHED) {
+                        manager_save_dirty_sessions(m);
                         return 0;
+                }
 
                 manager_gc(m, true);
+                manager_save_dirty_sessions(m);
 
                 r = manager_dispatch_delayed(m, false);
                 if (r < 0)
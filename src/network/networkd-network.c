@@ -140,6 +140,10 @@ int network_verify(Network *network) {
                                        "%s: Conditions in the file do not match the system environment, skipping.",
                                        network->filename);
 
+        r = net_match_compile(&network->match);
+        if (r < 0)
+                return r;
+
         if (network->keep_master) {
                 if (network->batadv_name)
                         log_warning("%s: BatmanAdvanced= set with KeepMaster= enabled, ignoring BatmanAdvanced=.",
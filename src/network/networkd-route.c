@@ -1439,6 +1439,18 @@ int link_request_route(
                         if (r > 0)
                                 log_route_debug(existing, "Updated expiration timer for", link, link->manager);
                 }
+
+                /* All route attributes that may differ without changing the identity are taken from the
+                 * existing entry above, hence re-sending RTM_NEWROUTE for a route that is already in the
+                 * kernel would only replace it with identical contents. Skip the request then, so that
+                 * e.g. 'networkctl reload' does not needlessly churn the routing table. Routes with a
+                 * finite lifetime are still re-sent, to refresh their expiration in the kernel. */
+                if (route_exists(existing) && existing->lifetime_usec == USEC_INFINITY) {
+                        log_route_debug(existing, "Already requested and exists, skipping request for", link, link->manager);
+                        if (ret)
+                                *ret = NULL;
+                        return 0;
+                }
         }
 
         log_route_debug(existing, "Requesting", link, link->manager);
@@ -574,6 +574,8 @@ int mount_all(const char *dest,
         bool ro = FLAGS_SET(mount_settings, MOUNT_APPLY_APIVFS_RO);
         bool in_userns = FLAGS_SET(mount_settings, MOUNT_IN_USERNS);
         bool tmpfs_tmp = FLAGS_SET(mount_settings, MOUNT_APPLY_TMPFS_TMP);
+        _cleanup_free_ char *previous_where = NULL;
+        const char *previous_unresolved = NULL;
         int r;
 
         for (size_t k = 0; k < ELEMENTSOF(mount_table); k++) {
@@ -593,9 +595,22 @@ int mount_all(const char *dest,
                 if (!tmpfs_tmp && FLAGS_SET(mount_table[k].mount_settings, MOUNT_APPLY_TMPFS_TMP))
                         continue;
 
-                r = chase_symlinks(mount_table[k].where, dest, CHASE_NONEXISTENT|CHASE_PREFIX_ROOT, &where, NULL);
+                /* Many entries come in pairs or triplets operating on the same mount point (bind mount
+                 * first, then remount read-only). Resolving a path is a syscall per component, so reuse the
+                 * path the previous iteration resolved when the target is the same. Mounting at a fully
+                 * resolved path doesn't change how it resolves, hence this is safe. */
+                if (previous_unresolved && streq(mount_table[k].where, previous_unresolved))
+                        where = TAKE_PTR(previous_where);
+                else {
+                        r = chase_symlinks(mount_table[k].where, dest, CHASE_NONEXISTENT|CHASE_PREFIX_ROOT, &where, NULL);
+                        if (r < 0)
+                                return log_error_errno(r, "Failed to resolve %s/%s: %m", dest, mount_table[k].where);
+                }
+
+                previous_unresolved = mount_table[k].where;
+                r = free_and_strdup(&previous_where, where);
                 if (r < 0)
-                        return log_error_errno(r, "Failed to resolve %s/%s: %m", dest, mount_table[k].where);
+                        return log_oom();
 
                 /* Skip this entry if it is not a remount. */
                 if (mount_table[k].what) {
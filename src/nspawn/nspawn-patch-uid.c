@@ -235,16 +235,20 @@ static int patch_fd(int fd, const char *name, const struct stat *st, uid_t shift
                 if (r < 0)
                         return -errno;
 
-                /* The Linux kernel alters the mode in some cases of chown(). Let's undo this. */
-                if (name) {
-                        if (!S_ISLNK(st->st_mode))
-                                r = fchmodat(fd, name, st->st_mode, 0);
-                        else /* AT_SYMLINK_NOFOLLOW is not available for fchmodat() */
-                                r = 0;
-                } else
-                        r = fchmod(fd, st->st_mode);
-                if (r < 0)
-                        return -errno;
+                /* The Linux kernel drops the suid/sgid bits on chown(). Let's undo this, but also
+                 * spare ourselves the extra syscall per inode when there's nothing it could have
+                 * dropped. */
+                if ((st->st_mode & (S_ISUID|S_ISGID)) != 0) {
+                        if (name) {
+                                if (!S_ISLNK(st->st_mode))
+                                        r = fchmodat(fd, name, st->st_mode, 0);
+                                else /* AT_SYMLINK_NOFOLLOW is not available for fchmodat() */
+                                        r = 0;
+                        } else
+                                r = fchmod(fd, st->st_mode);
+                        if (r < 0)
+                                return -errno;
+                }
 
                 changed = true;
         }
@@ -284,33 +288,41 @@ static int is_fs_fully_userns_compatible(const struct statfs *sfs) {
                F_TYPE_EQUAL(sfs->f_type, SYSFS_MAGIC);
 }
 
-static int recurse_fd(int fd, bool donate_fd, const struct stat *st, uid_t shift, bool is_toplevel) {
+static int recurse_fd(int fd, bool donate_fd, const struct stat *st, dev_t parent_dev, uid_t shift, bool is_toplevel) {
         _cleanup_closedir_ DIR *d = NULL;
         bool changed = false;
-        struct statfs sfs;
         int r;
 
         assert(fd >= 0);
 
-        if (fstatfs(fd, &sfs) < 0)
-                return -errno;
+        /* The file system checks below only matter when we cross into a different file system. If this
+         * directory lives on the same one as its parent they'd come out the same, so don't issue an
+         * fstatfs() and a write access probe per directory of a big tree. */
+        if (parent_dev == 0 || st->st_dev != parent_dev) {
+                struct statfs sfs;
 
-        /* We generally want to permit crossing of mount boundaries when patching the UIDs/GIDs. However, we probably
-         * shouldn't do this for /proc and /sys if that is already mounted into place. Hence, let's stop the recursion
-         * when we hit procfs, sysfs or some other special file systems. */
+                if (fstatfs(fd, &sfs) < 0) {
+                        r = -errno;
+                        goto finish;
+                }
 
-        r = is_fs_fully_userns_compatible(&sfs);
-        if (r < 0)
-                goto finish;
-        if (r > 0) {
-                r = 0; /* don't recurse */
-                goto finish;
-        }
+                /* We generally want to permit crossing of mount boundaries when patching the UIDs/GIDs. However, we probably
+                 * shouldn't do this for /proc and /sys if that is already mounted into place. Hence, let's stop the recursion
+                 * when we hit procfs, sysfs or some other special file systems. */
 
-        /* Also, if we hit a read-only file system, then don't bother, skip the whole subtree */
-        if ((sfs.f_flags & ST_RDONLY) ||
-            access_fd(fd, W_OK) == -EROFS)
-                goto read_only;
+                r = is_fs_fully_userns_compatible(&sfs);
+                if (r < 0)
+                        goto finish;
+                if (r > 0) {
+                        r = 0; /* don't recurse */
+                        goto finish;
+                }
+
+                /* Also, if we hit a read-only file system, then don't bother, skip the whole subtree */
+                if ((sfs.f_flags & ST_RDONLY) ||
+                    access_fd(fd, W_OK) == -EROFS)
+                        goto read_only;
+        }
 
         if (S_ISDIR(st->st_mode)) {
                 if (!donate_fd) {
@@ -353,7 +365,7 @@ static int recurse_fd(int fd, bool donate_fd, const struct stat *st, uid_t shift
 
                                 }
 
-                                r = recurse_fd(subdir_fd, true, &fst, shift, false);
+                                r = recurse_fd(subdir_fd, true, &fst, st->st_dev, shift, false);
                                 if (r < 0)
                                         goto finish;
                                 if (r > 0)
@@ -455,7 +467,7 @@ static int fd_patch_uid_internal(int fd, bool donate_fd, uid_t shift, uid_t rang
                 }
         }
 
-        return recurse_fd(fd, donate_fd, &st, shift, true);
+        return recurse_fd(fd, donate_fd, &st, 0, shift, true);
 
 finish:
         if (donate_fd)
@@ -3148,13 +3148,24 @@ static int patch_sysctl(void) {
                 { "net.",              true,  CLONE_NEWNET },
         };
 
+        _cleanup_close_ int proc_sys_fd = -1;
         unsigned long flags;
         char **k, **v;
         int r;
 
+        if (strv_isempty(arg_sysctl))
+                return 0;
+
+        /* As in systemd-sysctl, resolve all keys relative to a single /proc/sys fd, so that applying large
+         * tuned profiles doesn't pay for a full path walk per key on each container start. */
+        proc_sys_fd = open("/proc/sys", O_CLOEXEC|O_DIRECTORY|O_PATH);
+        if (proc_sys_fd < 0)
+                return log_error_errno(errno, "Failed to open /proc/sys/: %m");
+
         flags = effective_clone_ns_flags();
 
         STRV_FOREACH_PAIR(k, v, arg_sysctl) {
+                _cleanup_free_ char *w = NULL;
                 bool good = false;
                 size_t i;
 
@@ -3175,7 +3186,12 @@ static int patch_sysctl(void) {
                 if (!good)
                         return log_error_errno(SYNTHETIC_ERRNO(EPERM), "Refusing to write to sysctl '%s', as it is not safe in the selected namespaces.", *k);
 
-                r = sysctl_write(*k, *v);
+                w = strdup(*k);
+                if (!w)
+                        return log_oom();
+
+                /* The safe list above uses the classic dot notation, normalize to a path now. */
+                r = sysctl_write_at(proc_sys_fd, sysctl_normalize(w), *v);
                 if (r < 0)
                         return log_error_errno(r, "Failed to write sysctl '%s': %m", *k);
         }
@@ -5512,7 +5528,25 @@ static int run(int argc, char *argv[]) {
                         goto finish;
                 }
 
-                if (arg_ephemeral) {
+                if (arg_ephemeral && arg_volatile_mode == VOLATILE_OVERLAY) {
+                        r = chase_symlinks_and_update(&arg_directory, 0);
+                        if (r < 0)
+                                goto finish;
+
+                        /* With --volatile=overlay all writes end up in a throwaway tmpfs upper layer
+                         * anyway, hence there's no point in copying the tree first: use the original
+                         * directory as shared read-only lower layer directly, under a shared lock. This
+                         * makes ephemeral start-up time independent of the image size. */
+                        r = image_path_lock(arg_directory, LOCK_SH|LOCK_NB, &tree_global_lock, &tree_local_lock);
+                        if (r == -EBUSY) {
+                                log_error_errno(r, "Directory tree %s is currently busy.", arg_directory);
+                                goto finish;
+                        }
+                        if (r < 0) {
+                                log_error_errno(r, "Failed to lock %s: %m", arg_directory);
+                                goto finish;
+                        }
+                } else if (arg_ephemeral) {
                         _cleanup_free_ char *np = NULL;
 
                         r = chase_symlinks_and_update(&arg_directory, 0);
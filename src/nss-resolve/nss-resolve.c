@@ -13,6 +13,7 @@
 #include "in-addr-util.h"
 #include "macro.h"
 #include "nss-util.h"
+#include "process-util.h"
 #include "resolved-def.h"
 #include "signal-util.h"
 #include "string-util.h"
@@ -79,6 +80,112 @@ static int connect_to_resolved(Varlink **ret) {
         return 0;
 }
 
+typedef struct ConnectionCache {
+        Varlink *link;
+        pid_t pid;
+} ConnectionCache;
+
+static pthread_once_t connection_cache_once = PTHREAD_ONCE_INIT;
+static pthread_key_t connection_cache_key;
+static bool connection_cache_key_valid = false;
+
+static void connection_cache_destroy(void *p) {
+        ConnectionCache *c = p;
+
+        if (!c)
+                return;
+
+        varlink_unref(c->link);
+        free(c);
+}
+
+static void connection_cache_key_init(void) {
+        connection_cache_key_valid = pthread_key_create(&connection_cache_key, connection_cache_destroy) == 0;
+}
+
+static ConnectionCache* connection_cache_get(void) {
+        ConnectionCache *c;
+
+        if (pthread_once(&connection_cache_once, connection_cache_key_init) != 0 ||
+            !connection_cache_key_valid)
+                return NULL;
+
+        c = pthread_getspecific(connection_cache_key);
+        if (c)
+                return c;
+
+        c = new0(ConnectionCache, 1);
+        if (!c)
+                return NULL;
+
+        if (pthread_setspecific(connection_cache_key, c) != 0)
+                return mfree(c);
+
+        return c;
+}
+
+static int resolved_varlink_call(
+                Varlink **ret_link,
+                const char *method,
+                JsonVariant *cparams,
+                JsonVariant **ret_rparams,
+                const char **ret_error_id) {
+
+        ConnectionCache *c;
+        int r;
+
+        assert(ret_link);
+        assert(method);
+
+        /* Keeps one connection to resolved cached per thread: setting up and tearing down a socket for
+         * every single NSS lookup costs considerably more than the cache lookup on resolved's side. The
+         * cached connection may have died in the meantime (resolved restart), in which case we reconnect
+         * and try a second time. A reference to the connection used is returned via ret_link, so that the
+         * reply parameters stay valid until the caller is done with them, whatever happens to the cache. */
+
+        c = connection_cache_get();
+
+        for (bool reused = true;;) {
+                _cleanup_(varlink_unrefp) Varlink *fresh = NULL;
+                Varlink *link;
+
+                if (c && c->link && c->pid == getpid_cached())
+                        link = c->link;
+                else {
+                        if (c)
+                                /* Either there's no connection yet, or we inherited one through fork(),
+                                 * which we shall not talk on. Closing our copy doesn't affect the parent. */
+                                c->link = varlink_unref(c->link);
+
+                        r = connect_to_resolved(&fresh);
+                        if (r < 0)
+                                return r;
+
+                        reused = false;
+                        link = fresh;
+                }
+
+                r = varlink_call(link, method, cparams, ret_rparams, ret_error_id, NULL);
+                if (r >= 0) {
+                        *ret_link = varlink_ref(link);
+
+                        if (c && fresh) {
+                                c->link = TAKE_PTR(fresh);
+                                c->pid = getpid_cached();
+                        }
+
+                        return r;
+                }
+
+                /* The connection is broken, don't cache it */
+                if (c)
+                        c->link = varlink_unref(c->link);
+
+                if (!reused)
+                        return r;
+        }
+}
+
 static uint32_t ifindex_to_scopeid(int family, const void *a, int ifindex) {
         struct in6_addr in6;
 
@@ -245,10 +352,6 @@ enum nss_status _nss_resolve_gethostbyname4_r(
         assert(errnop);
         assert(h_errnop);
 
-        r = connect_to_resolved(&link);
-        if (r < 0)
-                goto fail;
-
         r = json_build(&cparams, JSON_BUILD_OBJECT(
                                        JSON_BUILD_PAIR("name", JSON_BUILD_STRING(name)),
                                        JSON_BUILD_PAIR("flags", JSON_BUILD_UNSIGNED(query_flags()))));
@@ -261,7 +364,7 @@ enum nss_status _nss_resolve_gethostbyname4_r(
          * configuration can distinguish such executed but negative replies from complete failure to
          * talk to resolved). */
         const char *error_id;
-        r = varlink_call(link, "io.systemd.Resolve.ResolveHostname", cparams, &rparams, &error_id, NULL);
+        r = resolved_varlink_call(&link, "io.systemd.Resolve.ResolveHostname", cparams, &rparams, &error_id);
         if (r < 0)
                 goto fail;
         if (!isempty(error_id)) {
@@ -406,10 +509,6 @@ enum nss_status _nss_resolve_gethostbyname3_r(
                 goto fail;
         }
 
-        r = connect_to_resolved(&link);
-        if (r < 0)
-                goto fail;
-
         r = json_build(&cparams, JSON_BUILD_OBJECT(JSON_BUILD_PAIR("name", JSON_BUILD_STRING(name)),
                                                    JSON_BUILD_PAIR("family", JSON_BUILD_INTEGER(af)),
                                                    JSON_BUILD_PAIR("flags", JSON_BUILD_UNSIGNED(query_flags()))));
@@ -417,7 +516,7 @@ enum nss_status _nss_resolve_gethostbyname3_r(
                 goto fail;
 
         const char *error_id;
-        r = varlink_call(link, "io.systemd.Resolve.ResolveHostname", cparams, &rparams, &error_id, NULL);
+        r = resolved_varlink_call(&link, "io.systemd.Resolve.ResolveHostname", cparams, &rparams, &error_id);
         if (r < 0)
                 goto fail;
         if (!isempty(error_id)) {
@@ -618,10 +717,6 @@ enum nss_status _nss_resolve_gethostbyaddr2_r(
                 goto fail;
         }
 
-        r = connect_to_resolved(&link);
-        if (r < 0)
-                goto fail;
-
         r = json_build(&cparams, JSON_BUILD_OBJECT(JSON_BUILD_PAIR("address", JSON_BUILD_BYTE_ARRAY(addr, len)),
                                                    JSON_BUILD_PAIR("family", JSON_BUILD_INTEGER(af)),
                                                    JSON_BUILD_PAIR("flags", JSON_BUILD_UNSIGNED(query_flags()))));
@@ -629,7 +724,7 @@ enum nss_status _nss_resolve_gethostbyaddr2_r(
                 goto fail;
 
         const char* error_id;
-        r = varlink_call(link, "io.systemd.Resolve.ResolveAddress", cparams, &rparams, &error_id, NULL);
+        r = resolved_varlink_call(&link, "io.systemd.Resolve.ResolveAddress", cparams, &rparams, &error_id);
         if (r < 0)
                 goto fail;
         if (!isempty(error_id)) {
@@ -2,8 +2,13 @@
 
 #include "env-util.h"
 #include "fd-util.h"
+#include "format-util.h"
+#include "fs-util.h"
 #include "nss-systemd.h"
+#include "stdio-util.h"
+#include "string-util.h"
 #include "strv.h"
+#include "uid-alloc-range.h"
 #include "user-record-nss.h"
 #include "user-record.h"
 #include "user-util.h"
@@ -20,6 +25,130 @@ UserDBFlags nss_glue_userdb_flags(void) {
         return flags;
 }
 
+/* PID 1 publishes every dynamic UID registration as a pair of world-readable symlinks below
+ * /run/systemd/dynamic-uid/ (see make_uid_symlinks() in core/dynamic-user.c; originally added for
+ * dbus-daemon's benefit, which cannot talk to the bus to resolve users). The symlinks are created and
+ * removed together with the registration itself, hence reading them is as authoritative as asking PID 1 —
+ * but costs two syscalls instead of a Varlink round-trip per lookup. Since dynamic user records carry no
+ * information beyond the name ↔ UID mapping (cf. build_user_json() in core/core-varlink.c) we can
+ * synthesize the full record locally. */
+
+static int dynamic_user_name_by_uid(uid_t uid, char **ret_name) {
+        char path[STRLEN("/run/systemd/dynamic-uid/direct:") + DECIMAL_STR_MAX(uid_t) + 1];
+        _cleanup_free_ char *name = NULL;
+        int r;
+
+        assert(ret_name);
+
+        if (!uid_is_dynamic(uid))
+                return 0;
+
+        xsprintf(path, "/run/systemd/dynamic-uid/direct:" UID_FMT, uid);
+
+        r = readlink_malloc(path, &name);
+        if (r == -ENOENT) /* not a registered dynamic UID */
+                return 0;
+        if (r < 0)
+                return r;
+
+        if (!valid_user_group_name(name, 0))
+                return -EINVAL;
+
+        *ret_name = TAKE_PTR(name);
+        return 1;
+}
+
+static int dynamic_user_uid_by_name(const char *name, uid_t *ret_uid) {
+        _cleanup_free_ char *s = NULL;
+        const char *path;
+        uid_t uid;
+        int r;
+
+        assert(name);
+        assert(ret_uid);
+
+        if (!valid_user_group_name(name, 0))
+                return 0;
+
+        path = strjoina("/run/systemd/dynamic-uid/direct:", name);
+
+        r = readlink_malloc(path, &s);
+        if (r == -ENOENT)
+                return 0;
+        if (r < 0)
+                return r;
+
+        r = parse_uid(s, &uid);
+        if (r < 0)
+                return r;
+
+        if (!uid_is_dynamic(uid))
+                return -EINVAL;
+
+        *ret_uid = uid;
+        return 1;
+}
+
+static int nss_pack_dynamic_user_record(
+                const char *name,
+                uid_t uid,
+                struct passwd *pwd,
+                char *buffer,
+                size_t buflen) {
+
+        assert(name);
+        assert(pwd);
+        assert(buffer);
+
+        if (buflen < strlen(name) + 1)
+                return -ERANGE;
+
+        /* Mirrors the record PID 1's io.systemd.DynamicUser Varlink service would hand out, after the
+         * conversion nss_pack_user_record() applies to it. */
+        *pwd = (struct passwd) {
+                .pw_name = strcpy(buffer, name),
+                .pw_passwd = (char*) PASSWORD_SEE_SHADOW,
+                .pw_uid = uid,
+                .pw_gid = (gid_t) uid,
+                .pw_gecos = (char*) "Dynamic User",
+                .pw_dir = (char*) "/",
+                .pw_shell = (char*) NOLOGIN,
+        };
+
+        return 0;
+}
+
+static int nss_pack_dynamic_group_record(
+                const char *name,
+                gid_t gid,
+                struct group *gr,
+                char *buffer,
+                size_t buflen) {
+
+        char **array;
+
+        assert(name);
+        assert(gr);
+        assert(buffer);
+
+        if (buflen < sizeof(char*) + strlen(name) + 1)
+                return -ERANGE;
+
+        /* Dynamic groups never carry members, but we still need a NULL terminated member array, which we
+         * place at the beginning of the buffer, under the assumption the buffer is aligned. */
+        array = (char**) buffer;
+        array[0] = NULL;
+
+        *gr = (struct group) {
+                .gr_name = strcpy(buffer + sizeof(char*), name),
+                .gr_gid = gid,
+                .gr_passwd = (char*) PASSWORD_SEE_SHADOW,
+                .gr_mem = array,
+        };
+
+        return 0;
+}
+
 int nss_pack_user_record(
                 UserRecord *hr,
                 struct passwd *pwd,
@@ -81,6 +210,22 @@ enum nss_status userdb_getpwnam(
         if (_nss_systemd_is_blocked())
                 return NSS_STATUS_NOTFOUND;
 
+        if (!FLAGS_SET(nss_glue_userdb_flags(), USERDB_EXCLUDE_DYNAMIC_USER)) {
+                uid_t uid;
+
+                r = dynamic_user_uid_by_name(name, &uid);
+                if (r > 0) {
+                        r = nss_pack_dynamic_user_record(name, uid, pwd, buffer, buflen);
+                        if (r < 0) {
+                                *errnop = -r;
+                                return NSS_STATUS_TRYAGAIN;
+                        }
+
+                        return NSS_STATUS_SUCCESS;
+                }
+                /* On failure fall back to the Varlink query, which is authoritative */
+        }
+
         r = userdb_by_name(name, nss_glue_userdb_flags()|USERDB_SUPPRESS_SHADOW, &hr);
         if (r == -ESRCH)
                 return NSS_STATUS_NOTFOUND;
@@ -114,6 +259,22 @@ enum nss_status userdb_getpwuid(
         if (_nss_systemd_is_blocked())
                 return NSS_STATUS_NOTFOUND;
 
+        if (!FLAGS_SET(nss_glue_userdb_flags(), USERDB_EXCLUDE_DYNAMIC_USER)) {
+                _cleanup_free_ char *name = NULL;
+
+                r = dynamic_user_name_by_uid(uid, &name);
+                if (r > 0) {
+                        r = nss_pack_dynamic_user_record(name, uid, pwd, buffer, buflen);
+                        if (r < 0) {
+                                *errnop = -r;
+                                return NSS_STATUS_TRYAGAIN;
+                        }
+
+                        return NSS_STATUS_SUCCESS;
+                }
+                /* On failure fall back to the Varlink query, which is authoritative */
+        }
+
         r = userdb_by_uid(uid, nss_glue_userdb_flags()|USERDB_SUPPRESS_SHADOW, &hr);
         if (r == -ESRCH)
                 return NSS_STATUS_NOTFOUND;
@@ -290,6 +451,22 @@ enum nss_status userdb_getgrnam(
         if (_nss_systemd_is_blocked())
                 return NSS_STATUS_NOTFOUND;
 
+        if (!FLAGS_SET(nss_glue_userdb_flags(), USERDB_EXCLUDE_DYNAMIC_USER)) {
+                uid_t uid;
+
+                /* Dynamic groups are memberless, hence we may also skip the membership query */
+                r = dynamic_user_uid_by_name(name, &uid);
+                if (r > 0) {
+                        r = nss_pack_dynamic_group_record(name, (gid_t) uid, gr, buffer, buflen);
+                        if (r < 0) {
+                                *errnop = -r;
+                                return NSS_STATUS_TRYAGAIN;
+                        }
+
+                        return NSS_STATUS_SUCCESS;
+                }
+        }
+
         r = groupdb_by_name(name, nss_glue_userdb_flags()|USERDB_SUPPRESS_SHADOW, &g);
         if (r < 0 && r != -ESRCH) {
                 *errnop = -r;
@@ -358,6 +535,21 @@ enum nss_status userdb_getgrgid(
         if (_nss_systemd_is_blocked())
                 return NSS_STATUS_NOTFOUND;
 
+        if (!FLAGS_SET(nss_glue_userdb_flags(), USERDB_EXCLUDE_DYNAMIC_USER)) {
+                _cleanup_free_ char *name = NULL;
+
+                r = dynamic_user_name_by_uid((uid_t) gid, &name);
+                if (r > 0) {
+                        r = nss_pack_dynamic_group_record(name, gid, gr, buffer, buflen);
+                        if (r < 0) {
+                                *errnop = -r;
+                                return NSS_STATUS_TRYAGAIN;
+                        }
+
+                        return NSS_STATUS_SUCCESS;
+                }
+        }
+
         r = groupdb_by_gid(gid, nss_glue_userdb_flags()|USERDB_SUPPRESS_SHADOW, &g);
         if (r < 0 && r != -ESRCH) {
                 *errnop = -r;
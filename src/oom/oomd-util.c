@@ -1,5 +1,7 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <sys/xattr.h>
 #include <unistd.h>
 
@@ -14,6 +16,7 @@
 #include "sort-util.h"
 #include "stat-util.h"
 #include "stdio-util.h"
+#include "xattr-util.h"
 
 DEFINE_HASH_OPS_WITH_VALUE_DESTRUCTOR(
                 oomd_cgroup_ctx_hash_ops,
@@ -326,11 +329,98 @@ int oomd_kill_by_swap_usage(Hashmap *h, uint64_t threshold_usage, bool dry_run,
         return ret;
 }
 
+static int cgroup_read_attribute(int dir_fd, const char *attribute, char **ret) {
+        _cleanup_fclose_ FILE *f = NULL;
+        _cleanup_close_ int fd = -1;
+
+        assert(dir_fd >= 0);
+        assert(attribute);
+        assert(ret);
+
+        fd = openat(dir_fd, attribute, O_RDONLY|O_CLOEXEC|O_NOCTTY);
+        if (fd < 0)
+                return -errno;
+
+        f = take_fdopen(&fd, "re");
+        if (!f)
+                return -errno;
+
+        return read_line(f, LONG_LINE_MAX, ret);
+}
+
+/* Like cg_get_attribute_as_uint64(), but relative to an already open cgroup directory */
+static int cgroup_read_attribute_as_uint64(int dir_fd, const char *attribute, uint64_t *ret) {
+        _cleanup_free_ char *value = NULL;
+        int r;
+
+        assert(ret);
+
+        r = cgroup_read_attribute(dir_fd, attribute, &value);
+        if (r == -ENOENT)
+                return -ENODATA;
+        if (r < 0)
+                return r;
+
+        if (streq(value, "max")) {
+                *ret = CGROUP_LIMIT_MAX;
+                return 0;
+        }
+
+        return safe_atou64(value, ret);
+}
+
+static int cgroup_read_memory_stat_pgscan(int dir_fd, uint64_t *ret) {
+        _cleanup_fclose_ FILE *f = NULL;
+        _cleanup_close_ int fd = -1;
+        int r;
+
+        assert(dir_fd >= 0);
+        assert(ret);
+
+        fd = openat(dir_fd, "memory.stat", O_RDONLY|O_CLOEXEC|O_NOCTTY);
+        if (fd < 0)
+                return -errno;
+
+        f = take_fdopen(&fd, "re");
+        if (!f)
+                return -errno;
+
+        for (;;) {
+                _cleanup_free_ char *line = NULL;
+                const char *v;
+
+                r = read_line(f, LONG_LINE_MAX, &line);
+                if (r < 0)
+                        return r;
+                if (r == 0)
+                        return -ENXIO;
+
+                v = startswith(line, "pgscan ");
+                if (v)
+                        return safe_atou64(v, ret);
+        }
+}
+
+static int cgroup_get_xattr_bool(int dir_fd, const char *name) {
+        _cleanup_free_ char *val = NULL;
+        int r;
+
+        assert(dir_fd >= 0);
+        assert(name);
+
+        r = fgetxattr_malloc(dir_fd, name, &val);
+        if (r < 0)
+                return r;
+
+        return parse_boolean(val);
+}
+
 int oomd_cgroup_context_acquire(const char *path, OomdCGroupContext **ret) {
         _cleanup_(oomd_cgroup_context_freep) OomdCGroupContext *ctx = NULL;
-        _cleanup_free_ char *p = NULL, *val = NULL;
+        _cleanup_free_ char *dir = NULL;
+        _cleanup_close_ int dir_fd = -1;
+        struct stat st;
         bool is_root;
-        uid_t uid;
         int r;
 
         assert(path);
@@ -343,26 +433,31 @@ int oomd_cgroup_context_acquire(const char *path, OomdCGroupContext **ret) {
         is_root = empty_or_root(path);
         ctx->preference = MANAGED_OOM_PREFERENCE_NONE;
 
-        r = cg_get_path(SYSTEMD_CGROUP_CONTROLLER, path, "memory.pressure", &p);
+        r = cg_get_path(SYSTEMD_CGROUP_CONTROLLER, path, NULL, &dir);
         if (r < 0)
-                return log_debug_errno(r, "Error getting cgroup memory pressure path from %s: %m", path);
+                return log_debug_errno(r, "Error getting cgroup directory path from %s: %m", path);
 
-        r = read_resource_pressure(p, PRESSURE_TYPE_FULL, &ctx->memory_pressure);
-        if (r < 0)
-                return log_debug_errno(r, "Error parsing memory pressure from %s: %m", p);
+        /* Open the cgroup directory once and read all attributes relative to it, instead of constructing
+         * and walking the full path for each of them again, on every interval for every monitored cgroup. */
+        dir_fd = open(dir, O_DIRECTORY|O_CLOEXEC|O_RDONLY);
+        if (dir_fd < 0)
+                return log_debug_errno(errno, "Error opening cgroup directory %s: %m", dir);
 
-        r = cg_get_owner(SYSTEMD_CGROUP_CONTROLLER, path, &uid);
+        r = read_resource_pressure(strjoina(dir, "/memory.pressure"), PRESSURE_TYPE_FULL, &ctx->memory_pressure);
         if (r < 0)
-                log_debug_errno(r, "Failed to get owner/group from %s: %m", path);
-        else if (uid == 0) {
+                return log_debug_errno(r, "Error parsing memory pressure from %s: %m", dir);
+
+        if (fstat(dir_fd, &st) < 0)
+                log_debug_errno(errno, "Failed to get owner/group from %s: %m", path);
+        else if (st.st_uid == 0) {
                 /* Ignore most errors when reading the xattr since it is usually unset and cgroup xattrs are only used
                  * as an optional feature of systemd-oomd (and the system might not even support them). */
-                r = cg_get_xattr_bool(SYSTEMD_CGROUP_CONTROLLER, path, "user.oomd_avoid");
+                r = cgroup_get_xattr_bool(dir_fd, "user.oomd_avoid");
                 if (r == -ENOMEM)
                         return r;
                 ctx->preference = r == 1 ? MANAGED_OOM_PREFERENCE_AVOID : ctx->preference;
 
-                r = cg_get_xattr_bool(SYSTEMD_CGROUP_CONTROLLER, path, "user.oomd_omit");
+                r = cgroup_get_xattr_bool(dir_fd, "user.oomd_omit");
                 if (r == -ENOMEM)
                         return r;
                 ctx->preference = r == 1 ? MANAGED_OOM_PREFERENCE_OMIT : ctx->preference;
@@ -373,19 +468,19 @@ int oomd_cgroup_context_acquire(const char *path, OomdCGroupContext **ret) {
                 if (r < 0)
                         return log_debug_errno(r, "Error getting memory used from procfs: %m");
         } else {
-                r = cg_get_attribute_as_uint64(SYSTEMD_CGROUP_CONTROLLER, path, "memory.current", &ctx->current_memory_usage);
+                r = cgroup_read_attribute_as_uint64(dir_fd, "memory.current", &ctx->current_memory_usage);
                 if (r < 0)
                         return log_debug_errno(r, "Error getting memory.current from %s: %m", path);
 
-                r = cg_get_attribute_as_uint64(SYSTEMD_CGROUP_CONTROLLER, path, "memory.min", &ctx->memory_min);
+                r = cgroup_read_attribute_as_uint64(dir_fd, "memory.min", &ctx->memory_min);
                 if (r < 0)
                         return log_debug_errno(r, "Error getting memory.min from %s: %m", path);
 
-                r = cg_get_attribute_as_uint64(SYSTEMD_CGROUP_CONTROLLER, path, "memory.low", &ctx->memory_low);
+                r = cgroup_read_attribute_as_uint64(dir_fd, "memory.low", &ctx->memory_low);
                 if (r < 0)
                         return log_debug_errno(r, "Error getting memory.low from %s: %m", path);
 
-                r = cg_get_attribute_as_uint64(SYSTEMD_CGROUP_CONTROLLER, path, "memory.swap.current", &ctx->swap_usage);
+                r = cgroup_read_attribute_as_uint64(dir_fd, "memory.swap.current", &ctx->swap_usage);
                 if (r == -ENODATA)
                         /* The kernel can be compiled without support for memory.swap.* files,
                          * or it can be disabled with boot param 'swapaccount=0' */
@@ -393,13 +488,9 @@ int oomd_cgroup_context_acquire(const char *path, OomdCGroupContext **ret) {
                 else if (r < 0)
                         return log_debug_errno(r, "Error getting memory.swap.current from %s: %m", path);
 
-                r = cg_get_keyed_attribute(SYSTEMD_CGROUP_CONTROLLER, path, "memory.stat", STRV_MAKE("pgscan"), &val);
+                r = cgroup_read_memory_stat_pgscan(dir_fd, &ctx->pgscan);
                 if (r < 0)
                         return log_debug_errno(r, "Error getting pgscan from memory.stat under %s: %m", path);
-
-                r = safe_atou64(val, &ctx->pgscan);
-                if (r < 0)
-                        return log_debug_errno(r, "Error converting pgscan value to uint64_t: %m");
         }
 
         ctx->path = strdup(empty_to_root(path));
@@ -2746,8 +2746,9 @@ static int deactivate_luks(struct crypt_device *cd, const char *node) {
 }
 
 static int context_copy_blocks(Context *context) {
-        Partition *p;
         int whole_fd = -1, r;
+        bool sync_whole = false;
+        Partition *p;
 
         assert(context);
 
@@ -2759,6 +2760,7 @@ static int context_copy_blocks(Context *context) {
                 _cleanup_free_ char *encrypted = NULL;
                 _cleanup_close_ int encrypted_dev_fd = -1;
                 int target_fd;
+                struct stat st;
 
                 if (p->copy_blocks_fd < 0)
                         continue;
@@ -2803,14 +2805,21 @@ static int context_copy_blocks(Context *context) {
                 log_info("Copying in '%s' (%s) on block level into future partition %" PRIu64 ".",
                          p->copy_blocks_path, FORMAT_BYTES(p->copy_blocks_size), p->partno);
 
-                r = copy_bytes_full(p->copy_blocks_fd, target_fd, p->copy_blocks_size, 0, NULL, NULL, NULL, NULL);
+                if (fstat(p->copy_blocks_fd, &st) < 0)
+                        return log_error_errno(errno, "Failed to stat '%s': %m", p->copy_blocks_path);
+
+                /* If the source is a regular file copy only its data extents and have the hole ranges
+                 * zeroed out on the target, which the kernel implements with efficient zero-out commands on
+                 * block devices. Block device sources don't support SEEK_DATA, hence copy them in full. */
+                r = copy_bytes_full(p->copy_blocks_fd, target_fd, p->copy_blocks_size,
+                                    S_ISREG(st.st_mode) ? COPY_HOLES : 0, NULL, NULL, NULL, NULL);
                 if (r < 0)
                         return log_error_errno(r, "Failed to copy in data from '%s': %m", p->copy_blocks_path);
 
-                if (fsync(target_fd) < 0)
-                        return log_error_errno(errno, "Failed to synchronize copied data blocks: %m");
-
                 if (p->encrypt != ENCRYPT_OFF) {
+                        if (fsync(target_fd) < 0)
+                                return log_error_errno(errno, "Failed to synchronize copied data blocks: %m");
+
                         encrypted_dev_fd = safe_close(encrypted_dev_fd);
 
                         r = deactivate_luks(cd, encrypted);
@@ -2823,11 +2832,17 @@ static int context_copy_blocks(Context *context) {
                         r = loop_device_sync(d);
                         if (r < 0)
                                 return log_error_errno(r, "Failed to sync loopback device: %m");
-                }
+                } else
+                        /* Writes to the whole block device may be synchronized in one go after all
+                         * partitions are copied in, below. */
+                        sync_whole = true;
 
                 log_info("Copying in of '%s' on block level completed.", p->copy_blocks_path);
         }
 
+        if (sync_whole && fsync(whole_fd) < 0)
+                return log_error_errno(errno, "Failed to synchronize copied data blocks: %m");
+
         return 0;
 }
 
@@ -1,15 +1,21 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
 #include <net/if.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "af-list.h"
 #include "alloc-util.h"
 #include "dns-domain.h"
+#include "fd-util.h"
+#include "fileio.h"
 #include "format-util.h"
+#include "fs-util.h"
 #include "resolved-dns-answer.h"
 #include "resolved-dns-cache.h"
 #include "resolved-dns-packet.h"
 #include "string-util.h"
+#include "tmpfile-util.h"
 
 /* Never cache more than 4K entries. RFC 1536, Section 5 suggests to
  * leave DNS caches unbounded, but that's crazy. */
@@ -22,6 +28,9 @@
  * now) */
 #define CACHE_TTL_STRANGE_RCODE_USEC (10 * USEC_PER_SEC)
 
+/* When persisting the cache across restarts, skip entries with less validity left than this */
+#define CACHE_PERSIST_TTL_MIN_USEC (5 * USEC_PER_SEC)
+
 #define CACHEABLE_QUERY_FLAGS (SD_RESOLVED_AUTHENTICATED|SD_RESOLVED_CONFIDENTIAL)
 
 typedef enum DnsCacheItemType DnsCacheItemType;
@@ -886,6 +895,22 @@ static DnsCacheItem *dns_cache_get_by_key_follow_cname_dname_nsec(DnsCache *c, D
         if (i && i->type == DNS_CACHE_NXDOMAIN)
                 return i;
 
+        /* Also check all ancestors of the name: an authenticated NXDOMAIN for an ancestor means the whole
+         * subtree below it doesn't exist either (RFC 8020, and in the DNSSEC-validated case RFC 8198
+         * "aggressive use"). We insist on an authenticated entry here, since plenty of middleboxes hand out
+         * NXDOMAIN for names that do have children. This saves an upstream round trip for each unique
+         * sibling name queried below a domain we already know doesn't exist. */
+        for (const char *a = n;;) {
+                r = dns_name_parent(&a);
+                if (r <= 0)
+                        break;
+
+                i = hashmap_get(c->by_key, &DNS_RESOURCE_KEY_CONST(k->class, DNS_TYPE_ANY, a));
+                if (i && i->type == DNS_CACHE_NXDOMAIN &&
+                    FLAGS_SET(i->query_flags, SD_RESOLVED_AUTHENTICATED))
+                        return i;
+        }
+
         if (dns_type_may_redirect(k->type)) {
                 /* Check if we have a CNAME record instead */
                 i = hashmap_get(c->by_key, &DNS_RESOURCE_KEY_CONST(k->class, DNS_TYPE_CNAME, n));
@@ -1306,6 +1331,205 @@ int dns_cache_export_shared_to_packet(DnsCache *cache, DnsPacket *p) {
         return 0;
 }
 
+static int dns_cache_write_packet(FILE *f, DnsPacket *p, unsigned ancount) {
+        uint16_t size;
+
+        assert(f);
+        assert(p);
+
+        DNS_PACKET_HEADER(p)->ancount = htobe16(ancount);
+
+        /* Frame each message with a 16 bit size field, as on DNS stream transports (RFC 1035, section 4.2.2) */
+        size = htobe16((uint16_t) p->size);
+
+        if (fwrite(&size, 1, sizeof(size), f) != sizeof(size))
+                return -EIO;
+        if (fwrite(DNS_PACKET_DATA(p), 1, p->size, f) != p->size)
+                return -EIO;
+
+        return 0;
+}
+
+int dns_cache_save(DnsCache *cache, const char *path) {
+        _cleanup_(dns_packet_unrefp) DnsPacket *p = NULL;
+        _cleanup_(unlink_and_freep) char *temp_path = NULL;
+        _cleanup_fclose_ FILE *f = NULL;
+        unsigned ancount = 0, n = 0;
+        DnsCacheItem *i;
+        usec_t t;
+        int r;
+
+        assert(cache);
+        assert(path);
+
+        /* Serializes all positive cache entries to a file, as a sequence of wire format DNS messages with
+         * the TTLs rewritten to what's left of them at the time of saving. Negative entries are not
+         * persisted: they are cheap to re-acquire and tied to SOA data we don't save. */
+
+        t = now(clock_boottime_or_monotonic());
+
+        HASHMAP_FOREACH(i, cache->by_key) {
+                DnsCacheItem *j;
+
+                LIST_FOREACH(by_key, j, i) {
+                        _cleanup_(dns_resource_record_unrefp) DnsResourceRecord *copy = NULL;
+                        usec_t left;
+
+                        if (j->type != DNS_CACHE_POSITIVE || !j->rr)
+                                continue;
+
+                        /* mDNS data announced by other hosts is not ours to replay */
+                        if (j->shared_owner)
+                                continue;
+
+                        left = usec_sub_unsigned(j->until, t);
+                        if (left < CACHE_PERSIST_TTL_MIN_USEC)
+                                continue;
+
+                        if (!f) {
+                                r = fopen_temporary(path, &f, &temp_path);
+                                if (r < 0)
+                                        return r;
+
+                                (void) fchmod(fileno(f), 0644);
+                        }
+
+                        if (!p) {
+                                r = dns_packet_new(&p, DNS_PROTOCOL_DNS, 0, DNS_PACKET_SIZE_MAX);
+                                if (r < 0)
+                                        return r;
+                        }
+
+                        copy = dns_resource_record_copy(j->rr);
+                        if (!copy)
+                                return -ENOMEM;
+
+                        copy->ttl = (uint32_t) (left / USEC_PER_SEC);
+
+                        r = dns_packet_append_rr(p, copy, 0, NULL, NULL);
+                        if (r == -EMSGSIZE && ancount > 0) {
+                                /* The current message is full, flush it and start the next one */
+                                r = dns_cache_write_packet(f, p, ancount);
+                                if (r < 0)
+                                        return r;
+
+                                p = dns_packet_unref(p);
+                                ancount = 0;
+
+                                r = dns_packet_new(&p, DNS_PROTOCOL_DNS, 0, DNS_PACKET_SIZE_MAX);
+                                if (r < 0)
+                                        return r;
+
+                                r = dns_packet_append_rr(p, copy, 0, NULL, NULL);
+                        }
+                        if (r < 0) {
+                                log_debug_errno(r, "Failed to serialize cache entry, ignoring: %m");
+                                continue;
+                        }
+
+                        ancount++;
+                        n++;
+                }
+        }
+
+        if (n == 0) {
+                /* Nothing worth saving, but make sure no stale file sticks around either */
+                (void) unlink(path);
+                return 0;
+        }
+
+        r = dns_cache_write_packet(f, p, ancount);
+        if (r < 0)
+                return r;
+
+        r = fflush_and_check(f);
+        if (r < 0)
+                return r;
+
+        if (rename(temp_path, path) < 0)
+                return -errno;
+
+        return (int) n;
+}
+
+int dns_cache_load(DnsCache *cache, const char *path) {
+        _cleanup_fclose_ FILE *f = NULL;
+        unsigned n = 0;
+        int r;
+
+        assert(cache);
+        assert(path);
+
+        f = fopen(path, "re");
+        if (!f) {
+                if (errno == ENOENT)
+                        return 0;
+
+                return -errno;
+        }
+
+        for (;;) {
+                _cleanup_(dns_packet_unrefp) DnsPacket *p = NULL;
+                _cleanup_free_ uint8_t *buf = NULL;
+                uint16_t size;
+                size_t k;
+
+                k = fread(&size, 1, sizeof(size), f);
+                if (k == 0 && feof(f))
+                        break;
+                if (k != sizeof(size))
+                        return -EBADMSG;
+
+                size = be16toh(size);
+                if (size < DNS_PACKET_HEADER_SIZE)
+                        return -EBADMSG;
+
+                buf = malloc(size);
+                if (!buf)
+                        return -ENOMEM;
+
+                if (fread(buf, 1, size, f) != size)
+                        return -EBADMSG;
+
+                r = dns_packet_new(&p, DNS_PROTOCOL_DNS, size, DNS_PACKET_SIZE_MAX);
+                if (r < 0)
+                        return r;
+
+                memcpy(DNS_PACKET_HEADER(p), buf, DNS_PACKET_HEADER_SIZE);
+
+                r = dns_packet_append_blob(p, buf + DNS_PACKET_HEADER_SIZE, size - DNS_PACKET_HEADER_SIZE, NULL);
+                if (r < 0)
+                        return r;
+
+                r = dns_packet_extract(p);
+                if (r < 0)
+                        return r;
+
+                if (dns_answer_isempty(p->answer))
+                        continue;
+
+                /* Note that restored entries count as neither authenticated nor confidential, regardless of
+                 * how they were acquired originally: we can't prove that anymore. */
+                r = dns_cache_put(cache,
+                                  DNS_CACHE_MODE_YES,
+                                  NULL,
+                                  DNS_RCODE_SUCCESS,
+                                  p->answer,
+                                  NULL,
+                                  0,
+                                  _DNSSEC_RESULT_INVALID,
+                                  0,
+                                  AF_UNSPEC,
+                                  &(union in_addr_union) {});
+                if (r < 0)
+                        log_debug_errno(r, "Failed to restore cache entries, ignoring: %m");
+                else
+                        n += dns_answer_size(p->answer);
+        }
+
+        return (int) n;
+}
+
 void dns_cache_dump(DnsCache *cache, FILE *f) {
         DnsCacheItem *i;
 
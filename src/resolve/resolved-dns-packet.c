@@ -1445,6 +1445,7 @@ int dns_packet_read_name(
         _cleanup_(rewind_dns_packet) DnsPacketRewinder rewinder = REWINDER_INIT(p);
         size_t after_rindex = 0, jump_barrier = p->rindex;
         _cleanup_free_ char *name = NULL;
+        char buf[DNS_HOSTNAME_MAX + DNS_LABEL_ESCAPED_MAX + 2];
         bool first = true;
         size_t n = 0;
         int r;
@@ -1452,6 +1453,11 @@ int dns_packet_read_name(
         if (p->refuse_compression)
                 allow_compression = false;
 
+        /* Assemble the name in a stack buffer first and allocate the result in one go at the end, instead
+         * of growing a heap buffer label by label. Valid names fit easily: the wire format limits them to
+         * 255 octets, i.e. DNS_HOSTNAME_MAX in escaped form; refuse names our buffer can't hold, they are
+         * bogus anyway. */
+
         for (;;) {
                 uint8_t c, d;
 
@@ -1470,15 +1476,15 @@ int dns_packet_read_name(
                         if (r < 0)
                                 return r;
 
-                        if (!GREEDY_REALLOC(name, n + !first + DNS_LABEL_ESCAPED_MAX))
-                                return -ENOMEM;
+                        if (n + !first + DNS_LABEL_ESCAPED_MAX > sizeof(buf))
+                                return -EBADMSG;
 
                         if (first)
                                 first = false;
                         else
-                                name[n++] = '.';
+                                buf[n++] = '.';
 
-                        r = dns_label_escape(label, c, name + n, DNS_LABEL_ESCAPED_MAX);
+                        r = dns_label_escape(label, c, buf + n, DNS_LABEL_ESCAPED_MAX);
                         if (r < 0)
                                 return r;
 
@@ -1506,11 +1512,10 @@ int dns_packet_read_name(
                         return -EBADMSG;
         }
 
-        if (!GREEDY_REALLOC(name, n + 1))
+        name = memdup_suffix0(buf, n);
+        if (!name)
                 return -ENOMEM;
 
-        name[n] = 0;
-
         if (after_rindex != 0)
                 p->rindex= after_rindex;
 
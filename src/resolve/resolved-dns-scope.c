@@ -25,6 +25,23 @@
 #define MULTICAST_RESEND_TIMEOUT_MIN_USEC (100 * USEC_PER_MSEC)
 #define MULTICAST_RESEND_TIMEOUT_MAX_USEC (1 * USEC_PER_SEC)
 
+static char* dns_scope_cache_path(DnsScope *s) {
+        char *p;
+
+        assert(s);
+
+        /* Returns the path the scope's cache is persisted at across service restarts. Only classic unicast
+         * DNS scopes do that, the multicast protocols re-acquire their data from the network anyway. */
+
+        if (s->protocol != DNS_PROTOCOL_DNS)
+                return NULL;
+
+        if (asprintf(&p, "/run/systemd/resolve/cache.%s", s->link ? s->link->ifname : "global") < 0)
+                return NULL;
+
+        return p;
+}
+
 int dns_scope_new(Manager *m, DnsScope **ret, Link *l, DnsProtocol protocol, int family) {
         DnsScope *s;
 
@@ -68,6 +85,25 @@ int dns_scope_new(Manager *m, DnsScope **ret, Link *l, DnsProtocol protocol, int
         dns_scope_llmnr_membership(s, true);
         dns_scope_mdns_membership(s, true);
 
+        /* Restore the cache a previous incarnation of this scope saved on shutdown, so that a service
+         * restart doesn't turn into an upstream query storm. The file is consumed either way, so that we
+         * never load the same snapshot twice. */
+        if (protocol == DNS_PROTOCOL_DNS && m->enable_cache != DNS_CACHE_MODE_NO) {
+                _cleanup_free_ char *path = dns_scope_cache_path(s);
+
+                if (path) {
+                        int k;
+
+                        k = dns_cache_load(&s->cache, path);
+                        if (k < 0)
+                                log_debug_errno(k, "Failed to restore cache of scope on link %s, ignoring: %m", l ? l->ifname : "*");
+                        else if (k > 0)
+                                log_debug("Restored %i cache entries for scope on link %s.", k, l ? l->ifname : "*");
+
+                        (void) unlink(path);
+                }
+        }
+
         log_debug("New scope on link %s, protocol %s, family %s", l ? l->ifname : "*", dns_protocol_to_string(protocol), family == AF_UNSPEC ? "*" : af_to_name(family));
 
         /* Enforce ratelimiting for the multicast protocols */
@@ -115,6 +151,19 @@ DnsScope* dns_scope_free(DnsScope *s) {
 
         sd_event_source_disable_unref(s->announce_event_source);
 
+        /* Save the positive cache entries, so that the next incarnation of this scope can pick them up */
+        if (s->protocol == DNS_PROTOCOL_DNS && s->manager->enable_cache != DNS_CACHE_MODE_NO) {
+                _cleanup_free_ char *path = dns_scope_cache_path(s);
+
+                if (path) {
+                        int k;
+
+                        k = dns_cache_save(&s->cache, path);
+                        if (k < 0)
+                                log_debug_errno(k, "Failed to save cache of scope on link %s, ignoring: %m", s->link ? s->link->ifname : "*");
+                }
+        }
+
         dns_cache_flush(&s->cache);
         dns_zone_flush(&s->zone);
 
@@ -1001,6 +1050,11 @@ void dns_scope_process_query(DnsScope *s, DnsStream *stream, DnsPacket *p) {
                         return;
         }
 
+        /* We publish nothing on this scope, hence we can neither answer the query nor be party to a
+         * conflict — don't bother parsing the packet. */
+        if (dns_zone_is_empty(&s->zone))
+                return;
+
         r = dns_packet_extract(p);
         if (r < 0) {
                 log_debug_errno(r, "Failed to extract resource records from incoming packet: %m");
@@ -290,6 +290,16 @@ void dns_server_packet_received(DnsServer *s, int protocol, DnsServerFeatureLeve
                 s->received_udp_fragment_max = fragsize;
 }
 
+void dns_server_packet_rtt(DnsServer *s, usec_t rtt) {
+        assert(s);
+
+        /* Classic exponential smoothing with gain 1/8, as in TCP's SRTT estimation */
+        if (s->rtt_smoothed == 0)
+                s->rtt_smoothed = rtt;
+        else
+                s->rtt_smoothed = (7 * s->rtt_smoothed + rtt) / 8;
+}
+
 void dns_server_packet_lost(DnsServer *s, int protocol, DnsServerFeatureLevel level) {
         assert(s);
         assert(s->manager);
@@ -76,6 +76,8 @@ struct DnsServer {
 
         size_t received_udp_fragment_max;   /* largest packet or fragment (without IP/UDP header) we saw so far */
 
+        usec_t rtt_smoothed;                /* exponentially smoothed UDP round trip time, 0 if unknown yet */
+
         unsigned n_failed_udp;
         unsigned n_failed_tcp;
         unsigned n_failed_tls;
@@ -119,6 +121,7 @@ void dns_server_unlink(DnsServer *s);
 void dns_server_move_back_and_unmark(DnsServer *s);
 
 void dns_server_packet_received(DnsServer *s, int protocol, DnsServerFeatureLevel level, size_t fragsize);
+void dns_server_packet_rtt(DnsServer *s, usec_t rtt);
 void dns_server_packet_lost(DnsServer *s, int protocol, DnsServerFeatureLevel level);
 void dns_server_packet_truncated(DnsServer *s, DnsServerFeatureLevel level);
 void dns_server_packet_rrsig_missing(DnsServer *s, DnsServerFeatureLevel level);
@@ -20,6 +20,11 @@
 /* On the extra stubs, use a more conservative choice */
 #define ADVERTISE_EXTRA_DATAGRAM_SIZE_MAX DNS_PACKET_UNICAST_SIZE_LARGE_MAX
 
+/* Maximum number of UDP queries to pull off a stub socket per event loop wakeup. Draining a few in one go
+ * saves an epoll_wait() round-trip per packet under load, while the cap keeps a query flood from starving
+ * the other event sources. */
+#define STUB_PACKETS_PER_WAKEUP 16U
+
 static int manager_dns_stub_fd_extra(Manager *m, DnsStubListenerExtra *l, int type);
 static int manager_dns_stub_fd(Manager *m, int family, const union in_addr_union *listen_address, int type);
 
@@ -894,6 +899,12 @@ static void dns_stub_process_query(Manager *m, DnsStubListenerExtra *l, DnsStrea
                 return;
         }
 
+        /* Note on duplicate query bursts: we deliberately don't coalesce or memoize at this layer, beyond
+         * suppressing identical retransmits from the same client below. Each client packet needs its own
+         * DnsQuery anyway (its own id, EDNS parameters and reply route), but concurrent lookups for the
+         * same key share one wire transaction via dns_scope_find_transaction(), which fans the answer out
+         * to all attached queries, and answered keys are served from the regular cache without any network
+         * traffic — resolved is single-threaded, there are no cache locks to avoid. */
         queries_by_packet = l ? &l->queries_by_packet : &m->stub_queries_by_packet;
         existing = hashmap_get(*queries_by_packet, p);
         if (existing && dns_packet_equal(existing->request_packet, p)) {
@@ -1008,19 +1019,22 @@ static void dns_stub_process_query(Manager *m, DnsStubListenerExtra *l, DnsStrea
 }
 
 static int on_dns_stub_packet_internal(sd_event_source *s, int fd, uint32_t revents, Manager *m, DnsStubListenerExtra *l) {
-        _cleanup_(dns_packet_unrefp) DnsPacket *p = NULL;
         int r;
 
-        r = manager_recv(m, fd, DNS_PROTOCOL_DNS, &p);
-        if (r <= 0)
-                return r;
+        for (unsigned i = 0; i < STUB_PACKETS_PER_WAKEUP; i++) {
+                _cleanup_(dns_packet_unrefp) DnsPacket *p = NULL;
 
-        if (dns_packet_validate_query(p) > 0) {
-                log_debug("Got DNS stub UDP query packet for id %u", DNS_PACKET_ID(p));
+                r = manager_recv(m, fd, DNS_PROTOCOL_DNS, &p);
+                if (r <= 0)
+                        return r;
 
-                dns_stub_process_query(m, l, NULL, p);
-        } else
-                log_debug("Invalid DNS stub UDP packet, ignoring.");
+                if (dns_packet_validate_query(p) > 0) {
+                        log_debug("Got DNS stub UDP query packet for id %u", DNS_PACKET_ID(p));
+
+                        dns_stub_process_query(m, l, NULL, p);
+                } else
+                        log_debug("Invalid DNS stub UDP packet, ignoring.");
+        }
 
         return 0;
 }
@@ -14,10 +14,14 @@
 #include "resolved-dnstls.h"
 #include "resolved-llmnr.h"
 #include "string-table.h"
+#include "tracepoint-util.h"
 
 #define TRANSACTIONS_MAX 4096
 #define TRANSACTION_TCP_TIMEOUT_USEC (10U*USEC_PER_SEC)
 
+/* Lower bound for the RTT-derived UDP retry timeout, so that jittery links don't make us retry wildly */
+#define TRANSACTION_UDP_TIMEOUT_MIN_USEC (250U*USEC_PER_MSEC)
+
 /* After how much time to repeat classic DNS requests */
 #define DNS_TIMEOUT_USEC (SD_RESOLVED_QUERY_TIMEOUT_USEC / DNS_TRANSACTION_ATTEMPTS_MAX)
 
@@ -424,6 +428,12 @@ void dns_transaction_complete(DnsTransaction *t, DnsTransactionState state) {
                   (FLAGS_SET(t->answer_query_flags, SD_RESOLVED_AUTHENTICATED) ? "authenticated" : "unsigned"),
                   FLAGS_SET(t->answer_query_flags, SD_RESOLVED_CONFIDENTIAL) ? "confidential" : "non-confidential");
 
+        TRACE_POINT(resolved, transaction_complete,
+                    t->id,
+                    dns_resource_key_to_string(dns_transaction_key(t), key_str, sizeof key_str),
+                    dns_protocol_to_string(t->scope->protocol),
+                    st);
+
         t->state = state;
 
         dns_transaction_close_connection(t, true);
@@ -1341,6 +1351,12 @@ void dns_transaction_process_reply(DnsTransaction *t, DnsPacket *p, bool encrypt
                  * size/fragment size we got. Which is useful for announcing the EDNS(0) packet size we can
                  * receive to our server. */
                 dns_server_packet_received(t->server, p->ipproto, t->current_feature_level, dns_packet_size_unfragmented(p));
+
+                /* Also feed the round trip time of this reply into the server's RTT estimate, which we use
+                 * for scheduling quicker retries. Only for UDP, on a stream the connection setup would skew
+                 * the numbers. */
+                if (p->ipproto == IPPROTO_UDP && p->timestamp >= t->start_usec)
+                        dns_server_packet_rtt(t->server, p->timestamp - t->start_usec);
         }
 
         /* See if we know things we didn't know before that indicate we better restart the lookup immediately. */
@@ -1572,6 +1588,14 @@ static usec_t transaction_get_resend_timeout(DnsTransaction *t) {
                 if (t->stream)
                         return TRANSACTION_TCP_TIMEOUT_USEC;
 
+                /* If we have an RTT estimate for this server, time out after a generous multiple of it
+                 * instead of the fixed default, so that on packet loss we retry — possibly against another
+                 * server — after a couple of expected round trips already rather than after seconds. A
+                 * spuriously early retry only costs a duplicate packet, the late reply is discarded
+                 * anyway. */
+                if (t->server && t->server->rtt_smoothed > 0)
+                        return CLAMP(10 * t->server->rtt_smoothed, TRANSACTION_UDP_TIMEOUT_MIN_USEC, DNS_TIMEOUT_USEC);
+
                 return DNS_TIMEOUT_USEC;
 
         case DNS_PROTOCOL_MDNS:
@@ -1956,6 +1980,11 @@ int dns_transaction_go(DnsTransaction *t) {
                   af_to_name_short(t->scope->family),
                   yes_no(!FLAGS_SET(t->query_flags, SD_RESOLVED_NO_VALIDATE)));
 
+        TRACE_POINT(resolved, transaction_start,
+                    t->id,
+                    dns_resource_key_to_string(dns_transaction_key(t), key_str, sizeof key_str),
+                    dns_protocol_to_string(t->scope->protocol));
+
         if (!t->initial_jitter_scheduled &&
             IN_SET(t->scope->protocol, DNS_PROTOCOL_LLMNR, DNS_PROTOCOL_MDNS)) {
                 usec_t jitter, accuracy;
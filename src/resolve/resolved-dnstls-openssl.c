@@ -48,6 +48,28 @@ static int dnstls_flush_write_buffer(DnsStream *stream) {
         return 0;
 }
 
+static int dnstls_on_new_session(SSL *s, SSL_SESSION *session) {
+        DnsStream *stream;
+
+        assert(s);
+        assert(session);
+
+        /* Cache the newest session for the server this stream talks to, so that the next connection can be
+         * resumed. With TLS 1.3 the session tickets only arrive after the handshake has completed, hence
+         * this needs to be done from the new session callback and cannot be left to stream shutdown. Also,
+         * each TLS 1.3 ticket is intended for a single resumption, so always replace what we have. */
+
+        stream = SSL_get_app_data(s);
+        if (!stream || !stream->server)
+                return 0;
+
+        if (stream->server->dnstls_data.session)
+                SSL_SESSION_free(stream->server->dnstls_data.session);
+
+        stream->server->dnstls_data.session = session;
+        return 1;
+}
+
 int dnstls_stream_connect_tls(DnsStream *stream, DnsServer *server) {
         _cleanup_(BIO_freep) BIO *rb = NULL, *wb = NULL;
         _cleanup_(SSL_freep) SSL *s = NULL;
@@ -74,6 +96,9 @@ int dnstls_stream_connect_tls(DnsStream *stream, DnsServer *server) {
 
         SSL_set_connect_state(s);
         r = SSL_set_session(s, server->dnstls_data.session);
+        if (r == 0)
+                return -EIO;
+        r = SSL_set_app_data(s, stream);
         if (r == 0)
                 return -EIO;
         SSL_set_bio(s, TAKE_PTR(rb), TAKE_PTR(wb));
@@ -227,21 +252,13 @@ int dnstls_stream_on_io(DnsStream *stream, uint32_t revents) {
 
 int dnstls_stream_shutdown(DnsStream *stream, int error) {
         int ssl_error, r;
-        SSL_SESSION *s;
 
         assert(stream);
         assert(stream->encrypted);
         assert(stream->dnstls_data.ssl);
 
-        if (stream->server) {
-                s = SSL_get1_session(stream->dnstls_data.ssl);
-                if (s) {
-                        if (stream->server->dnstls_data.session)
-                                SSL_SESSION_free(stream->server->dnstls_data.session);
-
-                        stream->server->dnstls_data.session = s;
-                }
-        }
+        /* Note: the session is cached from dnstls_on_new_session() as tickets arrive, not here: a session
+         * grabbed with SSL_get1_session() at shutdown time would often lack a usable TLS 1.3 ticket. */
 
         if (error == ETIMEDOUT) {
                 ERR_clear_error();
@@ -418,6 +435,11 @@ int dnstls_manager_init(Manager *manager) {
 
         (void) SSL_CTX_set_options(manager->dnstls_data.ctx, SSL_OP_NO_COMPRESSION);
 
+        /* Client session caching, with the sessions handed to us via the callback rather than an internal
+         * store, since we cache them per DnsServer */
+        SSL_CTX_set_session_cache_mode(manager->dnstls_data.ctx, SSL_SESS_CACHE_CLIENT|SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(manager->dnstls_data.ctx, dnstls_on_new_session);
+
         r = SSL_CTX_set_default_verify_paths(manager->dnstls_data.ctx);
         if (r == 0)
                 return log_warning_errno(SYNTHETIC_ERRNO(EIO),
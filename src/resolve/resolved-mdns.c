@@ -241,6 +241,12 @@ static int mdns_scope_process_query(DnsScope *s, DnsPacket *p) {
         assert(s);
         assert(p);
 
+        /* We publish nothing on this scope, hence we can neither answer the query nor lose a tiebreak —
+         * don't bother parsing the packet. On hosts with many links this runs for every multicast query
+         * from every peer on every link. */
+        if (dns_zone_is_empty(&s->zone))
+                return 0;
+
         r = dns_packet_extract(p);
         if (r < 0)
                 return log_debug_errno(r, "Failed to extract resource records from incoming packet: %m");
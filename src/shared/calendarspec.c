@@ -1210,19 +1210,27 @@ static int tm_within_bounds(struct tm *tm, bool utc) {
         return cmp == 0;
 }
 
-static bool matches_weekday(int weekdays_bits, const struct tm *tm, bool utc) {
+static int weekday_distance(int weekdays_bits, const struct tm *tm, bool utc) {
         struct tm t;
         int k;
 
+        /* Returns the number of days from the specified day until the next day whose weekday is covered by
+         * the bitmask, i.e. 0 if the day matches already. This way callers can jump ahead in one step
+         * instead of retrying the whole calculation (with its various mktime() calls) once per day. */
+
         if (weekdays_bits < 0 || weekdays_bits >= BITS_WEEKDAYS)
-                return true;
+                return 0;
 
         t = *tm;
         if (mktime_or_timegm(&t, utc) < 0)
-                return false;
+                return -EINVAL;
 
         k = t.tm_wday == 0 ? 6 : t.tm_wday - 1;
-        return (weekdays_bits & (1 << k));
+        for (int i = 0; i < 7; i++)
+                if (weekdays_bits & (1 << ((k + i) % 7)))
+                        return i;
+
+        assert_not_reached(); /* at least one bit is set, per the check above */
 }
 
 /* A safety valve: if we get stuck in the calculation, return an error.
@@ -1291,8 +1299,13 @@ static int find_next(const CalendarSpec *spec, struct tm *tm, usec_t *usec) {
                 if (r == 0)
                         continue;
 
-                if (!matches_weekday(spec->weekdays_bits, &c, spec->utc)) {
-                        c.tm_mday++;
+                r = weekday_distance(spec->weekdays_bits, &c, spec->utc);
+                if (r != 0) {
+                        /* Jump directly to the next day with a matching weekday. If mktime() failed on us
+                         * advance by a single day, as before, and let the next iteration sort it out. The
+                         * days skipped don't match the weekday mask, hence cannot be candidates; the month
+                         * and day components are revalidated from the top after the jump. */
+                        c.tm_mday += r < 0 ? 1 : r;
                         c.tm_hour = c.tm_min = c.tm_sec = tm_usec = 0;
                         continue;
                 }
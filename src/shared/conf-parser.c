@@ -155,6 +155,49 @@ static int next_assignment(
         return 0;
 }
 
+/* Append a pre-lexed assignment to a CompiledConfigFile */
+static int compiled_config_file_add_line(
+                CompiledConfigFile *c,
+                const char *section,
+                unsigned section_line,
+                unsigned line,
+                const char *lvalue,
+                const char *rvalue) {
+
+        _cleanup_free_ char *s = NULL, *lv = NULL, *rv = NULL;
+
+        assert(c);
+        assert(lvalue);
+        assert(rvalue);
+
+        if (!GREEDY_REALLOC(c->lines, c->n_lines + 1))
+                return -ENOMEM;
+
+        if (section) {
+                s = strdup(section);
+                if (!s)
+                        return -ENOMEM;
+        }
+
+        lv = strdup(lvalue);
+        if (!lv)
+                return -ENOMEM;
+
+        rv = strdup(rvalue);
+        if (!rv)
+                return -ENOMEM;
+
+        c->lines[c->n_lines++] = (CompiledConfigLine) {
+                .section = TAKE_PTR(s),
+                .section_line = section_line,
+                .line = line,
+                .lvalue = TAKE_PTR(lv),
+                .rvalue = TAKE_PTR(rv),
+        };
+
+        return 0;
+}
+
 /* Parse a single logical line */
 static int parse_line(
                 const char* unit,
@@ -168,13 +211,14 @@ static int parse_line(
                 unsigned *section_line,
                 bool *section_ignored,
                 char *l, /* is modified */
+                CompiledConfigFile *compiled,
                 void *userdata) {
 
         char *e;
 
         assert(filename);
         assert(line > 0);
-        assert(lookup);
+        assert(lookup || compiled);
         assert(l);
 
         l = strstrip(l);
@@ -250,6 +294,15 @@ static int parse_line(
         *e = 0;
         e++;
 
+        if (compiled)
+                /* We are only pre-lexing: record the split assignment instead of dispatching it. */
+                return compiled_config_file_add_line(compiled,
+                                                     *section,
+                                                     *section_line,
+                                                     line,
+                                                     strstrip(l),
+                                                     strstrip(e));
+
         return next_assignment(unit,
                                filename,
                                line,
@@ -263,8 +316,9 @@ static int parse_line(
                                userdata);
 }
 
-/* Go through the file and parse each line */
-int config_parse(
+/* Go through the file and process each line, either dispatching assignments into the lookup table, or, if
+ * 'compiled' is non-NULL, recording them there for later replay. */
+static int config_parse_full(
                 const char *unit,
                 const char *filename,
                 FILE *f,
@@ -272,18 +326,21 @@ int config_parse(
                 ConfigItemLookup lookup,
                 const void *table,
                 ConfigParseFlags flags,
+                CompiledConfigFile *compiled,
                 void *userdata,
                 struct stat *ret_stat) {
 
-        _cleanup_free_ char *section = NULL, *continuation = NULL;
+        _cleanup_free_ char *section = NULL, *continuation = NULL, *contents = NULL;
         _cleanup_fclose_ FILE *ours = NULL;
         unsigned line = 0, section_line = 0;
         bool section_ignored = false, bom_seen = false;
+        size_t size;
+        char *q, *contents_end;
         struct stat st;
         int r, fd;
 
         assert(filename);
-        assert(lookup);
+        assert(lookup || compiled);
 
         if (!f) {
                 f = ours = fopen(filename, "re");
@@ -316,25 +373,48 @@ int config_parse(
         } else
                 st = (struct stat) {};
 
-        for (;;) {
-                _cleanup_free_ char *buf = NULL;
+        /* Pull in the whole file in one go and split it into lines in place, instead of reading it line by
+         * line through stdio. This sizes the buffer from fstat() and copies each byte only once, which is
+         * measurably cheaper when chewing through large drop-in trees. */
+        r = read_full_stream_full(f, filename, UINT64_MAX, SIZE_MAX, 0, &contents, &size);
+        if (r < 0) {
+                if (FLAGS_SET(flags, CONFIG_PARSE_WARN))
+                        log_error_errno(r, "%s: Error while reading configuration file: %m", filename);
+
+                return r;
+        }
+
+        q = contents;
+        contents_end = contents + size;
+
+        while (q < contents_end) {
                 bool escaped = false;
-                char *l, *p, *e;
+                char *buf, *eol, *l, *p, *e;
 
-                r = read_line(f, LONG_LINE_MAX, &buf);
-                if (r == 0)
-                        break;
-                if (r == -ENOBUFS) {
-                        if (flags & CONFIG_PARSE_WARN)
-                                log_error_errno(r, "%s:%u: Line too long", filename, line);
+                /* A line ends at the first \n, \r or NUL; mirroring read_line(), the pairings \r\n and \n\r
+                 * as well as a directly following NUL count as part of the same end-of-line marker. */
+                buf = q;
+                eol = buf + strcspn(buf, NEWLINE);
 
-                        return r;
+                q = eol;
+                if (q < contents_end) {
+                        char c = *q;
+
+                        *q++ = '\0';
+
+                        if (IN_SET(c, '\n', '\r')) {
+                                if (q < contents_end && IN_SET(*q, '\n', '\r') && *q != c)
+                                        q++;
+                                if (q < contents_end && *q == '\0')
+                                        q++;
+                        }
                 }
-                if (r < 0) {
-                        if (FLAGS_SET(flags, CONFIG_PARSE_WARN))
-                                log_error_errno(r, "%s:%u: Error while reading configuration file: %m", filename, line);
 
-                        return r;
+                if ((size_t) (eol - buf) >= LONG_LINE_MAX) {
+                        if (flags & CONFIG_PARSE_WARN)
+                                log_error("%s:%u: Line too long", filename, line);
+
+                        return -ENOBUFS;
                 }
 
                 line++;
@@ -404,6 +484,7 @@ int config_parse(
                                &section_line,
                                &section_ignored,
                                p,
+                               compiled,
                                userdata);
                 if (r < 0) {
                         if (flags & CONFIG_PARSE_WARN)
@@ -426,6 +507,7 @@ int config_parse(
                                &section_line,
                                &section_ignored,
                                continuation,
+                               compiled,
                                userdata);
                 if (r < 0) {
                         if (flags & CONFIG_PARSE_WARN)
@@ -440,6 +522,107 @@ int config_parse(
         return 1;
 }
 
+int config_parse(
+                const char *unit,
+                const char *filename,
+                FILE *f,
+                const char *sections,
+                ConfigItemLookup lookup,
+                const void *table,
+                ConfigParseFlags flags,
+                void *userdata,
+                struct stat *ret_stat) {
+
+        return config_parse_full(unit, filename, f, sections, lookup, table, flags, NULL, userdata, ret_stat);
+}
+
+CompiledConfigFile* compiled_config_file_free(CompiledConfigFile *c) {
+        if (!c)
+                return NULL;
+
+        for (size_t i = 0; i < c->n_lines; i++) {
+                free(c->lines[i].section);
+                free(c->lines[i].lvalue);
+                free(c->lines[i].rvalue);
+        }
+
+        free(c->lines);
+        free(c->path);
+        return mfree(c);
+}
+
+DEFINE_HASH_OPS_WITH_VALUE_DESTRUCTOR(
+                compiled_config_file_hash_ops,
+                char, path_hash_func, path_compare,
+                CompiledConfigFile, compiled_config_file_free);
+
+int config_compile(
+                const char *unit,
+                const char *filename,
+                FILE *f,
+                const char *sections,
+                ConfigParseFlags flags,
+                CompiledConfigFile **ret) {
+
+        _cleanup_(compiled_config_file_freep) CompiledConfigFile *c = NULL;
+        int r;
+
+        assert(filename);
+        assert(ret);
+
+        c = new0(CompiledConfigFile, 1);
+        if (!c)
+                return -ENOMEM;
+
+        c->path = strdup(filename);
+        if (!c->path)
+                return -ENOMEM;
+
+        r = config_parse_full(unit, filename, f, sections, NULL, NULL, flags, c, NULL, &c->st);
+        if (r <= 0) /* error, or the file vanished */
+                return r;
+
+        *ret = TAKE_PTR(c);
+        return 1;
+}
+
+int config_replay(
+                const CompiledConfigFile *compiled,
+                const char *unit,
+                ConfigItemLookup lookup,
+                const void *table,
+                ConfigParseFlags flags,
+                void *userdata) {
+
+        int r;
+
+        assert(compiled);
+        assert(lookup);
+
+        for (size_t i = 0; i < compiled->n_lines; i++) {
+                const CompiledConfigLine *cl = compiled->lines + i;
+
+                r = next_assignment(unit,
+                                    compiled->path,
+                                    cl->line,
+                                    lookup,
+                                    table,
+                                    cl->section,
+                                    cl->section_line,
+                                    cl->lvalue,
+                                    cl->rvalue,
+                                    flags,
+                                    userdata);
+                if (r < 0) {
+                        if (flags & CONFIG_PARSE_WARN)
+                                log_warning_errno(r, "%s:%u: Failed to parse file: %m", compiled->path, cl->line);
+                        return r;
+                }
+        }
+
+        return 1;
+}
+
 static int hashmap_put_stats_by_path(Hashmap **stats_by_path, const char *path, const struct stat *st) {
         _cleanup_free_ struct stat *st_copy = NULL;
         _cleanup_free_ char *path_copy = NULL;
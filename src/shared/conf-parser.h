@@ -82,6 +82,49 @@ int config_item_table_lookup(const void *table, const char *section, const char
  * ConfigPerfItem tables */
 int config_item_perf_lookup(const void *table, const char *section, const char *lvalue, ConfigParserCallback *ret_func, int *ret_ltype, void **ret_data, void *userdata);
 
+/* A single pre-lexed assignment: the section it appeared in and the already split and stripped
+ * lvalue/rvalue pair. */
+typedef struct CompiledConfigLine {
+        char *section;          /* owned by the CompiledConfigFile */
+        unsigned section_line;
+        unsigned line;
+        char *lvalue;
+        char *rvalue;
+} CompiledConfigLine;
+
+/* The pre-lexed form of a whole configuration file: all comment stripping, continuation joining, section
+ * tracking and key/value splitting already applied, but no setting callbacks invoked yet. Such an object may
+ * be "replayed" into a parser table any number of times, which is considerably cheaper than re-reading and
+ * re-lexing the file. The stat data taken at compilation time is included so that caches can validate
+ * entries against the file on disk. */
+typedef struct CompiledConfigFile {
+        char *path;
+        struct stat st;
+        CompiledConfigLine *lines;
+        size_t n_lines;
+} CompiledConfigFile;
+
+CompiledConfigFile* compiled_config_file_free(CompiledConfigFile *c);
+DEFINE_TRIVIAL_CLEANUP_FUNC(CompiledConfigFile*, compiled_config_file_free);
+
+extern const struct hash_ops compiled_config_file_hash_ops; /* path → CompiledConfigFile */
+
+int config_compile(
+                const char *unit,
+                const char *filename,
+                FILE *f,
+                const char *sections,       /* nulstr */
+                ConfigParseFlags flags,
+                CompiledConfigFile **ret);
+
+int config_replay(
+                const CompiledConfigFile *compiled,
+                const char *unit,
+                ConfigItemLookup lookup,
+                const void *table,
+                ConfigParseFlags flags,
+                void *userdata);
+
 int config_parse(
                 const char *unit,
                 const char *filename,
@@ -37,7 +37,10 @@
 #include "user-util.h"
 #include "xattr-util.h"
 
-#define COPY_BUFFER_SIZE (16U*1024U)
+/* Buffer size for the userspace read()/write() fallback. Only used when reflinks, copy_file_range(),
+ * sendfile() and splice() all are unavailable for a file, hence size it generously: fewer, larger syscalls
+ * are what matters in that degenerate case. */
+#define COPY_BUFFER_SIZE (64U*1024U)
 
 /* A safety net for descending recursively into file system trees to copy. On Linux PATH_MAX is 4096, which means the
  * deepest valid path one can build is around 2048, which we hence use as a safety net here, to not spin endlessly in
@@ -119,12 +122,29 @@ static int create_hole(int fd, off_t size) {
         if (end < 0)
                 return -errno;
 
-        /* If we're not at the end of the target file, try to punch a hole in the existing space using fallocate(). */
+        /* If we're not at the end of the target file, try to punch a hole in the existing space using
+         * fallocate(). On block devices the kernel implements this as an efficient zero-out. If the file
+         * system or device doesn't support punching holes write out literal zeros instead, so that the
+         * target always reads back as zeros where the source had a hole, regardless of what was stored
+         * there before. */
 
         if (offset < end &&
-            fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, MIN(size, end - offset)) < 0 &&
-            !ERRNO_IS_NOT_SUPPORTED(errno))
-                return -errno;
+            fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, MIN(size, end - offset)) < 0) {
+
+                if (!ERRNO_IS_NOT_SUPPORTED(errno))
+                        return -errno;
+
+                for (off_t woffset = offset, wend = offset + MIN(size, end - offset); woffset < wend; ) {
+                        static const uint8_t buffer[COPY_BUFFER_SIZE] = {};
+                        ssize_t n;
+
+                        n = pwrite(fd, buffer, MIN((off_t) sizeof(buffer), wend - woffset), woffset);
+                        if (n < 0)
+                                return -errno;
+
+                        woffset += n;
+                }
+        }
 
         if (end - offset >= size) {
                 /* If we've created the full hole, set the file pointer to the end of the hole we created and exit. */
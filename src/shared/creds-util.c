@@ -718,7 +718,8 @@ int decrypt_credential_and_warn(
                 const void *input,
                 size_t input_size,
                 void **ret,
-                size_t *ret_size) {
+                size_t *ret_size,
+                usec_t *ret_not_after) {
 
         _cleanup_(erase_and_freep) void *host_key = NULL, *tpm2_key = NULL, *plaintext = NULL;
         _cleanup_(EVP_CIPHER_CTX_freep) EVP_CIPHER_CTX *context = NULL;
@@ -954,6 +955,9 @@ int decrypt_credential_and_warn(
         if (ret_size)
                 *ret_size = plaintext_size - hs;
 
+        if (ret_not_after)
+                *ret_not_after = le64toh(m->not_after);
+
         return 0;
 }
 
@@ -967,7 +971,7 @@ int encrypt_credential_and_warn(sd_id128_t with_key, const char *name, usec_t ti
         return log_error_errno(SYNTHETIC_ERRNO(EOPNOTSUPP), "Support for encrypted credentials not available.");
 }
 
-int decrypt_credential_and_warn(const char *validate_name, usec_t validate_timestamp, const char *tpm2_device, const void *input, size_t input_size, void **ret, size_t *ret_size) {
+int decrypt_credential_and_warn(const char *validate_name, usec_t validate_timestamp, const char *tpm2_device, const void *input, size_t input_size, void **ret, size_t *ret_size, usec_t *ret_not_after) {
         return log_error_errno(SYNTHETIC_ERRNO(EOPNOTSUPP), "Support for encrypted credentials not available.");
 }
 
@@ -1548,7 +1548,10 @@ int dissect_image(
                 if (!p->found)
                         continue;
 
-                if (!p->fstype && p->node) {
+                /* Don't bother probing the superblocks of Verity hash or signature partitions: their
+                 * contents are consumed via device-mapper and libcryptsetup and never mounted, and each
+                 * probe costs us opening and reading the partition device. */
+                if (!p->fstype && p->node && !PARTITION_DESIGNATOR_IS_VERITY(i)) {
                         r = probe_filesystem(p->node, &p->fstype);
                         if (r < 0 && r != -EUCLEAN)
                                 return r;
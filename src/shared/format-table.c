@@ -82,6 +82,9 @@ typedef struct TableData {
         char *url;                  /* A URL to use for a clickable hyperlink */
         char *formatted;            /* A cached textual representation of the cell data, before ellipsation/alignment */
 
+        size_t measured_width;      /* cached console width (longest line) of the formatted text, SIZE_MAX if not measured yet */
+        size_t measured_height;     /* cached number of lines of the formatted text */
+
         union {
                 uint8_t data[0];    /* data is generic array */
                 bool boolean;
@@ -396,6 +399,7 @@ static TableData *table_data_new(
 
         d->n_ref = 1;
         d->type = type;
+        d->measured_width = d->measured_height = SIZE_MAX;
         d->minimum_width = minimum_width;
         d->maximum_width = maximum_width;
         d->weight = weight;
@@ -750,6 +754,7 @@ int table_set_uppercase(Table *t, TableCell *cell, bool b) {
                 return 0;
 
         d->formatted = mfree(d->formatted);
+        d->measured_width = d->measured_height = SIZE_MAX;
         d->uppercase = b;
         return 1;
 }
@@ -1396,6 +1401,9 @@ static const char *table_data_format(Table *t, TableData *d, bool avoid_uppercas
             (d->type != TABLE_STRV_WRAPPED || d->formatted_for_width == column_width))
                 return d->formatted;
 
+        /* We are about to (re)generate the formatted text, hence any cached measurement of it is stale */
+        d->measured_width = d->measured_height = SIZE_MAX;
+
         switch (d->type) {
         case TABLE_EMPTY:
                 return strempty(t->empty_string);
@@ -1865,9 +1873,28 @@ static int table_data_requested_width_height(
                 t = truncated;
         }
 
-        r = console_width_height(t, &width, &height);
-        if (r < 0)
-                return r;
+        /* Measuring the console width walks the whole string, and the layout loop does so for every cell
+         * in every pass — with deduplicated cell data shared across many rows on top. Hence cache the
+         * result. TABLE_STRV_WRAPPED reformats depending on the column width (the cache is invalidated
+         * on reformatting, but measuring through it would be pointless), TABLE_EMPTY shows the table's
+         * changeable empty-string marker, and truncated text is specific to this call — don't cache
+         * those. */
+        if (truncation_applied || IN_SET(d->type, TABLE_STRV_WRAPPED, TABLE_EMPTY)) {
+                r = console_width_height(t, &width, &height);
+                if (r < 0)
+                        return r;
+        } else {
+                if (d->measured_width == SIZE_MAX) {
+                        r = console_width_height(t, &d->measured_width, &d->measured_height);
+                        if (r < 0) {
+                                d->measured_width = d->measured_height = SIZE_MAX;
+                                return r;
+                        }
+                }
+
+                width = d->measured_width;
+                height = d->measured_height;
+        }
 
         if (d->maximum_width != SIZE_MAX && width > d->maximum_width)
                 width = d->maximum_width;
@@ -77,18 +77,28 @@ static int trie_children_cmp(const struct trie_child_entry *a, const struct trie
 
 static int node_add_child(struct trie *trie, struct trie_node *node, struct trie_node *node_child, uint8_t c) {
         struct trie_child_entry *child;
+        size_t idx;
 
-        /* extend array, add new entry, sort for bisection */
+        /* extend array, insert new entry at the sorted position, so that bisection keeps working */
         child = reallocarray(node->children, node->children_count + 1, sizeof(struct trie_child_entry));
         if (!child)
                 return -ENOMEM;
 
         node->children = child;
-        trie->children_count++;
-        node->children[node->children_count].c = c;
-        node->children[node->children_count].child = node_child;
+
+        idx = node->children_count;
+        while (idx > 0 && node->children[idx-1].c > c)
+                idx--;
+
+        memmove(node->children + idx + 1, node->children + idx,
+                (node->children_count - idx) * sizeof(struct trie_child_entry));
+        node->children[idx] = (struct trie_child_entry) {
+                .c = c,
+                .child = node_child,
+        };
+
         node->children_count++;
-        typesafe_qsort(node->children, node->children_count, trie_children_cmp);
+        trie->children_count++;
         trie->nodes_count++;
 
         return 0;
@@ -137,6 +147,7 @@ static int trie_node_add_value(struct trie *trie, struct trie_node *node,
                                const char *filename, uint16_t file_priority, uint32_t line_number, bool compat) {
         ssize_t k, v, fn = 0;
         struct trie_value_entry *val;
+        size_t idx;
 
         k = strbuf_add_string(trie->strings, key, strlen(key));
         if (k < 0)
@@ -169,13 +180,21 @@ static int trie_node_add_value(struct trie *trie, struct trie_node *node,
                 }
         }
 
-        /* extend array, add new entry, sort for bisection */
+        /* extend array, insert new entry at the sorted position, so that bisection keeps working */
         val = reallocarray(node->values, node->values_count + 1, sizeof(struct trie_value_entry));
         if (!val)
                 return -ENOMEM;
         trie->values_count++;
         node->values = val;
-        node->values[node->values_count] = (struct trie_value_entry) {
+
+        idx = node->values_count;
+        while (idx > 0 && strcmp(trie->strings->buf + node->values[idx-1].key_off,
+                                 trie->strings->buf + k) > 0)
+                idx--;
+
+        memmove(node->values + idx + 1, node->values + idx,
+                (node->values_count - idx) * sizeof(struct trie_value_entry));
+        node->values[idx] = (struct trie_value_entry) {
                 .key_off = k,
                 .value_off = v,
                 .filename_off = fn,
@@ -183,7 +202,6 @@ static int trie_node_add_value(struct trie *trie, struct trie_node *node,
                 .line_number = line_number,
         };
         node->values_count++;
-        typesafe_qsort_r(node->values, node->values_count, trie_values_cmp, trie);
         return 0;
 }
 
@@ -14,6 +14,7 @@
 #include "fd-util.h"
 #include "fileio.h"
 #include "float.h"
+#include "hashmap.h"
 #include "hexdecoct.h"
 #include "json-internal.h"
 #include "json.h"
@@ -2415,6 +2416,22 @@ static int json_parse_string(const char **p, char **ret) {
 
         for (;;) {
                 int len;
+                size_t run;
+
+                /* Fast path: copy over a whole run of plain characters, i.e. printable ASCII that needs
+                 * no unescaping nor UTF-8 validation, in one go instead of one character at a time. This
+                 * is a simple classification loop that compilers are able to vectorize. */
+                for (run = 0; (signed char) c[run] >= ' ' && c[run] != 0x7f && !IN_SET(c[run], '"', '\\'); run++)
+                        ;
+                if (run > 0) {
+                        if (!GREEDY_REALLOC(s, n + run + 1))
+                                return -ENOMEM;
+
+                        memcpy(s + n, c, run);
+                        n += run;
+                        c += run;
+                        continue;
+                }
 
                 /* Check for EOF */
                 if (*c == 0)
@@ -2851,6 +2868,7 @@ static int json_parse_internal(
         unsigned line_buffer = 0, column_buffer = 0;
         void *tokenizer_state = NULL;
         JsonStack *stack = NULL;
+        Hashmap *key_cache = NULL;
         const char *p;
         int r;
 
@@ -2874,6 +2892,7 @@ static int json_parse_internal(
         for (;;) {
                 _cleanup_(json_variant_unrefp) JsonVariant *add = NULL;
                 _cleanup_free_ char *string = NULL;
+                bool reused_key = false, new_key = false;
                 unsigned line_token, column_token;
                 JsonStack *current;
                 JsonValue value;
@@ -3033,9 +3052,21 @@ static int json_parse_internal(
                                 goto finish;
                         }
 
-                        r = json_variant_new_string(&add, string);
-                        if (r < 0)
-                                goto finish;
+                        if (IN_SET(current->expect, EXPECT_OBJECT_FIRST_KEY, EXPECT_OBJECT_NEXT_KEY)) {
+                                /* Object keys tend to repeat a lot in large documents (think of an array
+                                 * of thousands of objects that all carry the same fields), hence share a
+                                 * single variant per distinct key within this parse run, instead of
+                                 * allocating each occurrence separately. */
+                                add = json_variant_ref(hashmap_get(key_cache, string));
+                                reused_key = add;
+                                new_key = !add;
+                        }
+
+                        if (!add) {
+                                r = json_variant_new_string(&add, string);
+                                if (r < 0)
+                                        goto finish;
+                        }
 
                         if (current->expect == EXPECT_TOPLEVEL)
                                 current->expect = EXPECT_END;
@@ -3166,7 +3197,18 @@ static int json_parse_internal(
                         if (FLAGS_SET(flags, JSON_PARSE_SENSITIVE))
                                 json_variant_sensitive(add);
 
-                        (void) json_variant_set_source(&add, source, line_token, column_token);
+                        /* A reused key variant keeps the source location of its first occurrence;
+                         * setting a new one would just copy the variant and defeat the sharing. */
+                        if (!reused_key)
+                                (void) json_variant_set_source(&add, source, line_token, column_token);
+
+                        if (new_key && json_variant_is_regular(add)) {
+                                r = hashmap_ensure_put(&key_cache, &string_hash_ops, (void*) json_variant_string(add), add);
+                                if (r < 0)
+                                        goto finish;
+
+                                json_variant_ref(add);
+                        }
 
                         if (!GREEDY_REALLOC(current->elements, current->n_elements + 1)) {
                                 r = -ENOMEM;
@@ -3190,6 +3232,7 @@ finish:
                 json_stack_release(stack + i);
 
         free(stack);
+        hashmap_free_with_destructor(key_cache, json_variant_unref);
 
         return r;
 }
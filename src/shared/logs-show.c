@@ -174,6 +174,11 @@ static int parse_fieldv(const void *data, size_t length, const ParseFieldVec *fi
                 const ParseFieldVec *f = &fields[i];
                 int r;
 
+                /* Quick first byte filter, so that fields matching none of the candidates — the common case
+                 * — don't pay for a memcmp() per candidate */
+                if (length < f->field_len || *(const char*) data != f->field[0])
+                        continue;
+
                 r = parse_field(data, length, f->field, f->field_len, f->target, f->target_len);
                 if (r < 0)
                         return r;
@@ -979,6 +984,216 @@ static int update_json_data_split(
         return update_json_data(h, flags, name, eq + 1, size - fieldlen - 1);
 }
 
+struct json_raw_field {
+        char *name;
+        size_t n_values;
+        struct iovec values[];
+};
+
+static int update_json_raw_field(Hashmap *h, const char *name, const void *value, size_t size) {
+        struct json_raw_field *d;
+        void *copy;
+        int r;
+
+        assert(h);
+        assert(name);
+
+        d = hashmap_get(h, name);
+        if (d) {
+                struct json_raw_field *w;
+
+                w = realloc(d, offsetof(struct json_raw_field, values) + sizeof(struct iovec) * (d->n_values + 1));
+                if (!w)
+                        return log_oom();
+
+                d = w;
+                assert_se(hashmap_update(h, d->name, d) >= 0);
+        } else {
+                _cleanup_free_ char *n = NULL;
+
+                n = strdup(name);
+                if (!n)
+                        return log_oom();
+
+                d = malloc0(offsetof(struct json_raw_field, values) + sizeof(struct iovec));
+                if (!d)
+                        return log_oom();
+
+                r = hashmap_put(h, n, d);
+                if (r < 0) {
+                        free(d);
+                        return log_error_errno(r, "Failed to insert JSON name into hashmap: %m");
+                }
+
+                d->name = TAKE_PTR(n);
+        }
+
+        /* The pointers handed out by sd_journal_enumerate_data() are only valid until the next
+         * enumeration call — compressed objects in particular share a per-file decompression buffer —
+         * hence take a copy of the value before we move on to the next field. */
+        copy = memdup_suffix0(value, size);
+        if (!copy)
+                return log_oom();
+
+        d->values[d->n_values++] = IOVEC_MAKE(copy, size);
+        return 0;
+}
+
+/* Streaming fast path for the compact JSON output modes: writes the entry straight from the journal
+ * data with escape-on-write, instead of first building a JsonVariant tree and serializing that. The
+ * pretty printing, SSE framing and color modes keep using the generic formatter below. */
+static int output_json_stream(
+                FILE *f,
+                sd_journal *j,
+                OutputMode mode,
+                OutputFlags flags,
+                const Set *output_fields) {
+
+        char sid[SD_ID128_STRING_MAX], usec_realtime[DECIMAL_STR_MAX(usec_t)], usec_monotonic[DECIMAL_STR_MAX(usec_t)];
+        _cleanup_free_ char *cursor = NULL;
+        uint64_t realtime, monotonic;
+        struct json_raw_field *d;
+        Hashmap *h = NULL;
+        sd_id128_t boot_id;
+        bool first = true;
+        int r;
+
+        assert(f);
+        assert(j);
+
+        (void) sd_journal_set_data_threshold(j, flags & OUTPUT_SHOW_ALL ? 0 : JSON_THRESHOLD);
+
+        r = sd_journal_get_realtime_usec(j, &realtime);
+        if (r < 0)
+                return log_error_errno(r, "Failed to get realtime timestamp: %m");
+
+        r = sd_journal_get_monotonic_usec(j, &monotonic, &boot_id);
+        if (r < 0)
+                return log_error_errno(r, "Failed to get monotonic timestamp: %m");
+
+        r = sd_journal_get_cursor(j, &cursor);
+        if (r < 0)
+                return log_error_errno(r, "Failed to get cursor: %m");
+
+        h = hashmap_new(&string_hash_ops);
+        if (!h)
+                return log_oom();
+
+        r = update_json_raw_field(h, "__CURSOR", cursor, strlen(cursor));
+        if (r < 0)
+                goto finish;
+
+        xsprintf(usec_realtime, USEC_FMT, realtime);
+        r = update_json_raw_field(h, "__REALTIME_TIMESTAMP", usec_realtime, strlen(usec_realtime));
+        if (r < 0)
+                goto finish;
+
+        xsprintf(usec_monotonic, USEC_FMT, monotonic);
+        r = update_json_raw_field(h, "__MONOTONIC_TIMESTAMP", usec_monotonic, strlen(usec_monotonic));
+        if (r < 0)
+                goto finish;
+
+        sd_id128_to_string(boot_id, sid);
+        r = update_json_raw_field(h, "_BOOT_ID", sid, strlen(sid));
+        if (r < 0)
+                goto finish;
+
+        for (;;) {
+                const void *data;
+                size_t size, fieldlen;
+                const char *eq;
+                char *name;
+
+                r = sd_journal_enumerate_data(j, &data, &size);
+                if (r == -EBADMSG) {
+                        log_debug_errno(r, "Skipping message we can't read: %m");
+                        r = 0;
+                        goto finish;
+                }
+                if (r < 0) {
+                        log_error_errno(r, "Failed to read journal: %m");
+                        goto finish;
+                }
+                if (r == 0)
+                        break;
+
+                if (memory_startswith(data, size, "_BOOT_ID="))
+                        continue;
+
+                eq = memchr(data, '=', MIN(size, JSON_THRESHOLD));
+                if (!eq)
+                        continue;
+
+                fieldlen = eq - (const char*) data;
+                if (!journal_field_valid(data, fieldlen, true)) {
+                        r = log_error_errno(SYNTHETIC_ERRNO(EINVAL), "Invalid field.");
+                        goto finish;
+                }
+
+                name = strndupa_safe(data, fieldlen);
+                if (output_fields && !set_contains(output_fields, name))
+                        continue;
+
+                r = update_json_raw_field(h, name, eq + 1, size - fieldlen - 1);
+                if (r < 0)
+                        goto finish;
+        }
+
+        if (mode == OUTPUT_JSON_SEQ)
+                fputc('\x1e', f); /* ASCII Record Separator, see RFC 7464 */
+
+        fputc('{', f);
+
+        HASHMAP_FOREACH(d, h) {
+                assert(d->n_values > 0);
+
+                if (!first)
+                        fputc(',', f);
+                first = false;
+
+                json_escape(f, d->name, strlen(d->name), flags);
+                fputc(':', f);
+
+                if (d->n_values > 1)
+                        fputc('[', f);
+
+                for (size_t i = 0; i < d->n_values; i++) {
+                        if (i > 0)
+                                fputc(',', f);
+
+                        /* Same rules as in update_json_data(): overly long fields are output as null,
+                         * and non-UTF-8 data as an array of bytes. */
+                        if (!(flags & OUTPUT_SHOW_ALL) && strlen(d->name) + 1 + d->values[i].iov_len >= JSON_THRESHOLD)
+                                fputs("null", f);
+                        else if (!utf8_is_printable(d->values[i].iov_base, d->values[i].iov_len)) {
+                                fputc('[', f);
+                                for (size_t k = 0; k < d->values[i].iov_len; k++)
+                                        fprintf(f, k == 0 ? "%u" : ",%u", ((const uint8_t*) d->values[i].iov_base)[k]);
+                                fputc(']', f);
+                        } else
+                                json_escape(f, d->values[i].iov_base, d->values[i].iov_len, flags);
+                }
+
+                if (d->n_values > 1)
+                        fputc(']', f);
+        }
+
+        fputs("}\n", f);
+        r = 0;
+
+finish:
+        while ((d = hashmap_steal_first(h))) {
+                for (size_t i = 0; i < d->n_values; i++)
+                        free(d->values[i].iov_base);
+                free(d->name);
+                free(d);
+        }
+
+        hashmap_free(h);
+
+        return r;
+}
+
 static int output_json(
                 FILE *f,
                 sd_journal *j,
@@ -1001,6 +1216,11 @@ static int output_json(
 
         assert(j);
 
+        /* The compact modes can be written directly from the journal data, without building an
+         * intermediate variant tree first. */
+        if (IN_SET(mode, OUTPUT_JSON, OUTPUT_JSON_SEQ) && !FLAGS_SET(flags, OUTPUT_COLOR))
+                return output_json_stream(f, j, mode, flags, output_fields);
+
         (void) sd_journal_set_data_threshold(j, flags & OUTPUT_SHOW_ALL ? 0 : JSON_THRESHOLD);
 
         r = sd_journal_get_realtime_usec(j, &realtime);
@@ -1413,6 +1633,12 @@ int add_matches_for_unit(sd_journal *j, const char *unit) {
         assert(j);
         assert(unit);
 
+        /* Note that these matches are not as expensive as they may look: each data object in a journal
+         * file carries its own chain of entry arrays, so iterating with a match set never scans entries of
+         * unrelated units — it bisects within the entry lists of the matched field values only. The cost
+         * of tailing grows with the number of disjunctions below, since each term needs its own cursor,
+         * not with the overall journal size. */
+
         m1 = strjoina("_SYSTEMD_UNIT=", unit);
         m2 = strjoina("COREDUMP_UNIT=", unit);
         m3 = strjoina("UNIT=", unit);
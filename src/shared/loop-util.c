@@ -399,6 +399,119 @@ static int attach_empty_file(int loop, int nr) {
         return 0;
 }
 
+static bool loop_reuse_enabled(void) {
+        static int cached = -1;
+
+        if (cached < 0)
+                cached = getenv_bool("SYSTEMD_LOOP_REUSE") != 0; /* Turn off by setting $SYSTEMD_LOOP_REUSE=0 */
+
+        return cached;
+}
+
+static int loop_device_open_existing(
+                const struct stat *backing,
+                uint32_t loop_flags,
+                LoopDevice **ret) {
+
+        _cleanup_(sd_device_enumerator_unrefp) sd_device_enumerator *e = NULL;
+        sd_device *dev;
+        int r;
+
+        assert(backing);
+        assert(ret);
+
+        /* Scans for a loopback device that is already attached to the specified backing inode with
+         * compatible parameters, and returns a reference to it, or -ENXIO if there is none. We only do this
+         * for read-only whole-file devices: those are immutable and thus interchangeable, while anything
+         * writable must remain private to its allocator. */
+
+        r = sd_device_enumerator_new(&e);
+        if (r < 0)
+                return r;
+
+        r = sd_device_enumerator_add_match_subsystem(e, "block", true);
+        if (r < 0)
+                return r;
+
+        r = sd_device_enumerator_add_match_sysname(e, "loop*");
+        if (r < 0)
+                return r;
+
+        FOREACH_DEVICE(e, dev) {
+                _cleanup_close_ int fd = -1;
+                _cleanup_free_ char *p = NULL;
+                struct loop_info64 info;
+                uint64_t diskseq = 0;
+                const char *node;
+                struct stat st;
+                LoopDevice *d;
+
+                if (sd_device_get_devname(dev, &node) < 0)
+                        continue;
+
+                fd = open(node, O_CLOEXEC|O_NONBLOCK|O_NOCTTY|O_RDONLY);
+                if (fd < 0)
+                        continue;
+
+                /* This fails for unbound devices and for partitions, which conveniently filters out both */
+                if (ioctl(fd, LOOP_GET_STATUS64, &info) < 0)
+                        continue;
+
+#if HAVE_VALGRIND_MEMCHECK_H
+                /* Valgrind currently doesn't know LOOP_GET_STATUS64. Remove this once it does */
+                VALGRIND_MAKE_MEM_DEFINED(&info, sizeof(info));
+#endif
+
+                if (info.lo_device != (uint64_t) backing->st_dev ||
+                    info.lo_inode != (uint64_t) backing->st_ino ||
+                    info.lo_offset != 0 ||
+                    info.lo_sizelimit != 0)
+                        continue;
+
+                /* Only reuse devices the kernel won't write to, and insist that a partition scan has taken
+                 * place in case our caller asks for one. */
+                if (!FLAGS_SET(info.lo_flags, LO_FLAGS_READ_ONLY))
+                        continue;
+                if (FLAGS_SET(loop_flags, LO_FLAGS_PARTSCAN) && !FLAGS_SET(info.lo_flags, LO_FLAGS_PARTSCAN))
+                        continue;
+
+                if (fstat(fd, &st) < 0)
+                        return -errno;
+                if (!S_ISBLK(st.st_mode))
+                        continue;
+
+                r = loop_get_diskseq(fd, &diskseq);
+                if (r < 0 && r != -EOPNOTSUPP)
+                        return r;
+
+                p = strdup(node);
+                if (!p)
+                        return -ENOMEM;
+
+                d = new(LoopDevice, 1);
+                if (!d)
+                        return -ENOMEM;
+
+                *d = (LoopDevice) {
+                        .fd = TAKE_FD(fd),
+                        .nr = info.lo_number,
+                        .node = TAKE_PTR(p),
+                        .relinquished = true, /* It's not allocated by us, don't destroy it when this object is freed */
+                        .devno = st.st_rdev,
+                        .diskseq = diskseq,
+                        .uevent_seqnum_not_before = UINT64_MAX,
+                        .timestamp_not_before = USEC_INFINITY,
+                };
+
+                log_debug("Reusing existing loopback device %s.", d->node);
+
+                *ret = d;
+                return d->fd;
+        }
+
+        return -ENXIO;
+}
+
 static int loop_device_make_internal(
                 int fd,
                 int open_flags,
@@ -478,6 +591,20 @@ static int loop_device_make_internal(
                 r = stat_verify_regular(&st);
                 if (r < 0)
                         return r;
+
+                /* Similar: if we are supposed to attach the whole file read-only, check whether some
+                 * existing read-only loopback device already covers the very same inode, and reference that
+                 * instead of allocating another device. Read-only devices backed by the same data are
+                 * interchangeable, and services that attach the same disk image (e.g. a system extension
+                 * shared by many units) would otherwise each tie up their own loopback device and trigger
+                 * their own udev probing run for it. */
+                if (open_flags == O_RDONLY && offset == 0 && IN_SET(size, 0, UINT64_MAX) && loop_reuse_enabled()) {
+                        r = loop_device_open_existing(&st, loop_flags, ret);
+                        if (r >= 0)
+                                return r;
+                        if (r != -ENXIO)
+                                log_debug_errno(r, "Failed to check for reusable loopback device, ignoring: %m");
+                }
         }
 
         f_flags = fcntl(fd, F_GETFL);
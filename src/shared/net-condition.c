@@ -4,6 +4,7 @@
 
 #include "condition.h"
 #include "env-util.h"
+#include "glob-util.h"
 #include "log.h"
 #include "net-condition.h"
 #include "netif-util.h"
@@ -28,6 +29,7 @@ void net_match_clear(NetMatch *match) {
         match->wlan_iftype = strv_free(match->wlan_iftype);
         match->ssid = strv_free(match->ssid);
         match->bssid = set_free(match->bssid);
+        match->ifname_set = set_free(match->ifname_set);
 }
 
 bool net_match_is_empty(const NetMatch *match) {
@@ -47,6 +49,36 @@ bool net_match_is_empty(const NetMatch *match) {
                 set_isempty(match->bssid);
 }
 
+int net_match_compile(NetMatch *match) {
+        char * const *p;
+        int r;
+
+        assert(match);
+
+        /* Precomputes derived lookup structures after all [Match] settings (including drop-ins) have
+         * been parsed. Currently this turns Name= into a hash lookup if all patterns are plain
+         * interface names: that's by far the most common way .network and .link files are written, and
+         * it avoids running a chain of fnmatch() calls on every file for every link event. Patterns
+         * using globs or exclusions keep the generic code path. */
+
+        match->ifname_set = set_free(match->ifname_set);
+
+        if (strv_isempty(match->ifname))
+                return 0;
+
+        STRV_FOREACH(p, match->ifname)
+                if (**p == '!' || string_is_glob(*p))
+                        return 0;
+
+        STRV_FOREACH(p, match->ifname) {
+                r = set_put_strdup(&match->ifname_set, *p);
+                if (r < 0)
+                        return r;
+        }
+
+        return 0;
+}
+
 static bool net_condition_test_strv(char * const *patterns, const char *string) {
         char * const *p;
         bool match = false, has_positive_rule = false;
@@ -75,13 +107,27 @@ static bool net_condition_test_strv(char * const *patterns, const char *string)
         return has_positive_rule ? match : true;
 }
 
-static bool net_condition_test_ifname(char * const *patterns, const char *ifname, char * const *alternative_names) {
-        if (net_condition_test_strv(patterns, ifname))
+static bool net_condition_test_ifname(const NetMatch *match, const char *ifname, char * const *alternative_names) {
+        char * const *p;
+
+        if (match->ifname_set) {
+                /* Compiled by net_match_compile(): all patterns are literal names. */
+
+                if (ifname && set_contains(match->ifname_set, ifname))
+                        return true;
+
+                STRV_FOREACH(p, alternative_names)
+                        if (set_contains(match->ifname_set, *p))
+                                return true;
+
+                return false;
+        }
+
+        if (net_condition_test_strv(match->ifname, ifname))
                 return true;
 
-        char * const *p;
         STRV_FOREACH(p, alternative_names)
-                if (net_condition_test_strv(patterns, *p))
+                if (net_condition_test_strv(match->ifname, *p))
                         return true;
 
         return false;
@@ -135,16 +181,11 @@ int net_match_config(
                 const char *ssid,
                 const struct ether_addr *bssid) {
 
-        _cleanup_free_ char *iftype_str = NULL;
-        const char *path = NULL;
-
         assert(match);
 
-        if (net_get_type_string(device, iftype, &iftype_str) == -ENOMEM)
-                return -ENOMEM;
-
-        if (device)
-                (void) sd_device_get_property_value(device, "ID_PATH", &path);
+        /* This runs in a loop over all configured .network (or .link) files for each interface event,
+         * hence resolve the type string and the ID_PATH property lazily, only when a file actually
+         * matches on them. */
 
         if (match->hw_addr && (!hw_addr || !set_contains(match->hw_addr, hw_addr)))
                 return false;
@@ -154,19 +195,33 @@ int net_match_config(
              !set_contains(match->permanent_hw_addr, permanent_hw_addr)))
                 return false;
 
-        if (!net_condition_test_strv(match->path, path))
-                return false;
+        if (!strv_isempty(match->path)) {
+                const char *path = NULL;
+
+                if (device)
+                        (void) sd_device_get_property_value(device, "ID_PATH", &path);
+
+                if (!net_condition_test_strv(match->path, path))
+                        return false;
+        }
 
         if (!net_condition_test_strv(match->driver, driver))
                 return false;
 
-        if (!net_condition_test_strv(match->iftype, iftype_str))
-                return false;
+        if (!strv_isempty(match->iftype)) {
+                _cleanup_free_ char *iftype_str = NULL;
+
+                if (net_get_type_string(device, iftype, &iftype_str) == -ENOMEM)
+                        return -ENOMEM;
+
+                if (!net_condition_test_strv(match->iftype, iftype_str))
+                        return false;
+        }
 
         if (!net_condition_test_strv(match->kind, kind))
                 return false;
 
-        if (!net_condition_test_ifname(match->ifname, ifname, alternative_names))
+        if (!net_condition_test_ifname(match, ifname, alternative_names))
                 return false;
 
         if (!net_condition_test_property(match->property, device))
@@ -22,10 +22,14 @@ typedef struct NetMatch {
         char **wlan_iftype;
         char **ssid;
         Set *bssid;
+
+        /* Derived by net_match_compile(), not set by the parsers. */
+        Set *ifname_set;
 } NetMatch;
 
 void net_match_clear(NetMatch *match);
 bool net_match_is_empty(const NetMatch *match);
+int net_match_compile(NetMatch *match);
 
 int net_match_config(
                 const NetMatch *match,
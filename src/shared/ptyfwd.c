@@ -25,6 +25,11 @@
 #include "terminal-util.h"
 #include "time-util.h"
 
+/* The pump buffer size. A kernel pty buffers several pages, and LINE_MAX sized reads made
+ * throughput-bound console output (e.g. a log-happy container boot) pay a wakeup and a read/write
+ * syscall pair per 2K of output. */
+#define PTY_BUFFER_SIZE (16U*1024U)
+
 struct PTYForward {
         sd_event *event;
 
@@ -65,7 +70,10 @@ struct PTYForward {
         bool last_char_set:1;
         char last_char;
 
-        char in_buffer[LINE_MAX], out_buffer[LINE_MAX];
+        bool last_winsize_valid:1;
+        struct winsize last_winsize;
+
+        char in_buffer[PTY_BUFFER_SIZE], out_buffer[PTY_BUFFER_SIZE];
         size_t in_buffer_full, out_buffer_full;
 
         usec_t escape_timestamp;
@@ -130,34 +138,52 @@ static int pty_forward_done(PTYForward *f, int rcode) {
 }
 
 static bool look_for_escape(PTYForward *f, const char *buffer, size_t n) {
-        const char *p;
+        const char *p = buffer;
 
         assert(f);
         assert(buffer);
         assert(n > 0);
 
-        for (p = buffer; p < buffer + n; p++) {
+        /* Check for ^]. We search for the escape character with memchr() rather than inspecting every byte
+         * one-by-one: any byte other than ^] simply resets the counter, hence a run of regular bytes (i.e.
+         * almost all input, in particular bulk pastes) only matters as a single state reset. */
 
-                /* Check for ^] */
-                if (*p == 0x1D) {
-                        usec_t nw = now(CLOCK_MONOTONIC);
+        for (;;) {
+                const char *e;
 
-                        if (f->escape_counter == 0 || nw > f->escape_timestamp + ESCAPE_USEC)  {
-                                f->escape_timestamp = nw;
-                                f->escape_counter = 1;
-                        } else {
-                                (f->escape_counter)++;
-
-                                if (f->escape_counter >= 3)
-                                        return true;
+                e = memchr(p, 0x1D, buffer + n - p);
+                if (!e) {
+                        /* Trailing regular bytes reset the state */
+                        if (p < buffer + n) {
+                                f->escape_timestamp = 0;
+                                f->escape_counter = 0;
                         }
-                } else {
+
+                        return false;
+                }
+
+                if (e > p) {
+                        /* Regular bytes before this ^] reset the state */
                         f->escape_timestamp = 0;
                         f->escape_counter = 0;
                 }
-        }
 
-        return false;
+                usec_t nw = now(CLOCK_MONOTONIC);
+
+                if (f->escape_counter == 0 || nw > f->escape_timestamp + ESCAPE_USEC)  {
+                        f->escape_timestamp = nw;
+                        f->escape_counter = 1;
+                } else {
+                        (f->escape_counter)++;
+
+                        if (f->escape_counter >= 3)
+                                return true;
+                }
+
+                p = e + 1;
+                if (p >= buffer + n)
+                        return false;
+        }
 }
 
 static bool ignore_vhangup(PTYForward *f) {
@@ -206,9 +232,9 @@ static int shovel(PTYForward *f) {
                (f->master_readable && f->out_buffer_full <= 0) ||
                (f->stdout_writable && f->out_buffer_full > 0)) {
 
-                if (f->stdin_readable && f->in_buffer_full < LINE_MAX) {
+                if (f->stdin_readable && f->in_buffer_full < PTY_BUFFER_SIZE) {
 
-                        k = read(f->input_fd, f->in_buffer + f->in_buffer_full, LINE_MAX - f->in_buffer_full);
+                        k = read(f->input_fd, f->in_buffer + f->in_buffer_full, PTY_BUFFER_SIZE - f->in_buffer_full);
                         if (k < 0) {
 
                                 if (errno == EAGAIN)
@@ -261,9 +287,9 @@ static int shovel(PTYForward *f) {
                         }
                 }
 
-                if (f->master_readable && f->out_buffer_full < LINE_MAX) {
+                if (f->master_readable && f->out_buffer_full < PTY_BUFFER_SIZE) {
 
-                        k = read(f->master, f->out_buffer + f->out_buffer_full, LINE_MAX - f->out_buffer_full);
+                        k = read(f->master, f->out_buffer + f->out_buffer_full, PTY_BUFFER_SIZE - f->out_buffer_full);
                         if (k < 0) {
 
                                 /* Note that EIO on the master device
@@ -393,9 +419,17 @@ static int on_sigwinch_event(sd_event_source *e, const struct signalfd_siginfo *
         assert(e);
         assert(e == f->sigwinch_event_source);
 
-        /* The window size changed, let's forward that. */
-        if (ioctl(f->output_fd, TIOCGWINSZ, &ws) >= 0)
-                (void) ioctl(f->master, TIOCSWINSZ, &ws);
+        /* The window size changed, let's forward that. Interactive resizes deliver a burst of SIGWINCH
+         * events, typically all for the same final size; skip the pty ioctl (and thus the SIGWINCH storm
+         * into the session) when the size didn't actually change since we last propagated it. */
+        if (ioctl(f->output_fd, TIOCGWINSZ, &ws) >= 0 &&
+            (!f->last_winsize_valid ||
+             f->last_winsize.ws_row != ws.ws_row ||
+             f->last_winsize.ws_col != ws.ws_col))
+                if (ioctl(f->master, TIOCSWINSZ, &ws) >= 0) {
+                        f->last_winsize = ws;
+                        f->last_winsize_valid = true;
+                }
 
         return 0;
 }
@@ -481,7 +515,10 @@ int pty_forward_new(
                         .ws_col = columns(),
                 };
 
-        (void) ioctl(master, TIOCSWINSZ, &ws);
+        if (ioctl(master, TIOCSWINSZ, &ws) >= 0) {
+                f->last_winsize = ws;
+                f->last_winsize_valid = true;
+        }
 
         if (!(flags & PTY_FORWARD_READ_ONLY)) {
                 assert(f->input_fd >= 0);
@@ -674,6 +711,9 @@ int pty_forward_set_width_height(PTYForward *f, unsigned width, unsigned height)
         if (ioctl(f->master, TIOCSWINSZ, &ws) < 0)
                 return -errno;
 
+        f->last_winsize = ws;
+        f->last_winsize_valid = true;
+
         /* Make sure we ignore SIGWINCH window size events from now on */
         f->sigwinch_event_source = sd_event_source_unref(f->sigwinch_event_source);
 
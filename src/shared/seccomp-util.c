@@ -2,12 +2,15 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
+#include <linux/filter.h>
 #include <linux/seccomp.h>
 #include <stddef.h>
 #include <sys/mman.h>
 #include <sys/prctl.h>
 #include <sys/shm.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 /* include missing_syscall_def.h earlier to make __SNR_foo mapped to __NR_foo. */
 #include "missing_syscall_def.h"
@@ -17,12 +20,15 @@
 #include "alloc-util.h"
 #include "env-util.h"
 #include "errno-list.h"
+#include "fd-util.h"
 #include "macro.h"
+#include "memfd-util.h"
 #include "nsflags.h"
 #include "nulstr-util.h"
 #include "process-util.h"
 #include "seccomp-util.h"
 #include "set.h"
+#include "sort-util.h"
 #include "string-util.h"
 #include "strv.h"
 
@@ -1065,6 +1071,59 @@ int seccomp_load_syscall_filter_set(uint32_t default_action, const SyscallFilter
         return 0;
 }
 
+static int seccomp_build_syscall_filter_for_arch(
+                uint32_t arch,
+                uint32_t default_action,
+                Hashmap *filter,
+                uint32_t action,
+                bool log_missing,
+                scmp_filter_ctx *ret) {
+
+        _cleanup_(seccomp_releasep) scmp_filter_ctx seccomp = NULL;
+        void *syscall_id, *val;
+        int r;
+
+        assert(ret);
+
+        r = seccomp_init_for_arch(&seccomp, arch, default_action);
+        if (r < 0)
+                return r;
+
+        HASHMAP_FOREACH_KEY(val, syscall_id, filter) {
+                uint32_t a = action;
+                int id = PTR_TO_INT(syscall_id) - 1;
+                int error = PTR_TO_INT(val);
+
+                if (error == SECCOMP_ERROR_NUMBER_KILL)
+                        a = scmp_act_kill_process();
+#ifdef SCMP_ACT_LOG
+                else if (action == SCMP_ACT_LOG)
+                        a = SCMP_ACT_LOG;
+#endif
+                else if (error >= 0)
+                        a = SCMP_ACT_ERRNO(error);
+
+                r = seccomp_rule_add_exact(seccomp, a, id, 0);
+                if (r < 0) {
+                        /* If the system call is not known on this architecture, then that's
+                         * fine, let's ignore it */
+                        _cleanup_free_ char *n = NULL;
+                        bool ignore;
+
+                        n = seccomp_syscall_resolve_num_arch(SCMP_ARCH_NATIVE, id);
+                        ignore = r == -EDOM;
+                        if (!ignore || log_missing)
+                                log_debug_errno(r, "Failed to add rule for system call %s() / %d%s: %m",
+                                                strna(n), id, ignore ? ", ignoring" : "");
+                        if (!ignore)
+                                return r;
+                }
+        }
+
+        *ret = TAKE_PTR(seccomp);
+        return 0;
+}
+
 int seccomp_load_syscall_filter_set_raw(uint32_t default_action, Hashmap* filter, uint32_t action, bool log_missing) {
         uint32_t arch;
         int r;
@@ -1077,45 +1136,13 @@ int seccomp_load_syscall_filter_set_raw(uint32_t default_action, Hashmap* filter
 
         SECCOMP_FOREACH_LOCAL_ARCH(arch) {
                 _cleanup_(seccomp_releasep) scmp_filter_ctx seccomp = NULL;
-                void *syscall_id, *val;
 
                 log_debug("Operating on architecture: %s", seccomp_arch_to_string(arch));
 
-                r = seccomp_init_for_arch(&seccomp, arch, default_action);
+                r = seccomp_build_syscall_filter_for_arch(arch, default_action, filter, action, log_missing, &seccomp);
                 if (r < 0)
                         return r;
 
-                HASHMAP_FOREACH_KEY(val, syscall_id, filter) {
-                        uint32_t a = action;
-                        int id = PTR_TO_INT(syscall_id) - 1;
-                        int error = PTR_TO_INT(val);
-
-                        if (error == SECCOMP_ERROR_NUMBER_KILL)
-                                a = scmp_act_kill_process();
-#ifdef SCMP_ACT_LOG
-                        else if (action == SCMP_ACT_LOG)
-                                a = SCMP_ACT_LOG;
-#endif
-                        else if (error >= 0)
-                                a = SCMP_ACT_ERRNO(error);
-
-                        r = seccomp_rule_add_exact(seccomp, a, id, 0);
-                        if (r < 0) {
-                                /* If the system call is not known on this architecture, then that's
-                                 * fine, let's ignore it */
-                                _cleanup_free_ char *n = NULL;
-                                bool ignore;
-
-                                n = seccomp_syscall_resolve_num_arch(SCMP_ARCH_NATIVE, id);
-                                ignore = r == -EDOM;
-                                if (!ignore || log_missing)
-                                        log_debug_errno(r, "Failed to add rule for system call %s() / %d%s: %m",
-                                                        strna(n), id, ignore ? ", ignoring" : "");
-                                if (!ignore)
-                                        return r;
-                        }
-                }
-
                 r = seccomp_load(seccomp);
                 if (ERRNO_IS_SECCOMP_FATAL(r))
                         return r;
@@ -1127,6 +1154,182 @@ int seccomp_load_syscall_filter_set_raw(uint32_t default_action, Hashmap* filter
         return 0;
 }
 
+struct SeccompCompiledFilter {
+        /* One raw BPF program per (local) architecture, ready for SECCOMP_SET_MODE_FILTER */
+        struct sock_fprog *programs;
+        size_t n_programs;
+};
+
+SeccompCompiledFilter* seccomp_compiled_filter_free(SeccompCompiledFilter *f) {
+        if (!f)
+                return NULL;
+
+        for (size_t i = 0; i < f->n_programs; i++)
+                free(f->programs[i].filter);
+
+        free(f->programs);
+        return mfree(f);
+}
+
+static int seccomp_compiled_filter_add(SeccompCompiledFilter *f, scmp_filter_ctx seccomp) {
+        _cleanup_free_ struct sock_filter *insns = NULL;
+        _cleanup_close_ int fd = -1;
+        struct stat st;
+        ssize_t k;
+        size_t n;
+        int r;
+
+        assert(f);
+        assert(seccomp);
+
+        /* Extracts the BPF program from a prepared libseccomp context and appends it to the compiled
+         * filter. libseccomp can only export to an fd, so bounce the program through a memfd. */
+
+        fd = memfd_new("seccomp-bpf");
+        if (fd < 0)
+                return fd;
+
+        r = seccomp_export_bpf(seccomp, fd);
+        if (r < 0)
+                return r;
+
+        if (fstat(fd, &st) < 0)
+                return -errno;
+
+        if (st.st_size <= 0 || (uint64_t) st.st_size % sizeof(struct sock_filter) != 0)
+                return -EINVAL;
+
+        n = (size_t) st.st_size / sizeof(struct sock_filter);
+        if (n > USHRT_MAX) /* BPF_MAXINSNS is far lower than this, but let the kernel do the precise check */
+                return -E2BIG;
+
+        insns = new(struct sock_filter, n);
+        if (!insns)
+                return -ENOMEM;
+
+        k = pread(fd, insns, (size_t) st.st_size, 0);
+        if (k < 0)
+                return -errno;
+        if (k != st.st_size)
+                return -EIO;
+
+        if (!GREEDY_REALLOC(f->programs, f->n_programs + 1))
+                return -ENOMEM;
+
+        f->programs[f->n_programs++] = (struct sock_fprog) {
+                .len = (unsigned short) n,
+                .filter = TAKE_PTR(insns),
+        };
+
+        return 0;
+}
+
+int seccomp_compile_syscall_filter_set_raw(uint32_t default_action, Hashmap* filter, uint32_t action, bool log_missing, SeccompCompiledFilter **ret) {
+        _cleanup_(seccomp_compiled_filter_freep) SeccompCompiledFilter *f = NULL;
+        uint32_t arch;
+        int r;
+
+        assert(ret);
+
+        /* Like seccomp_load_syscall_filter_set_raw(), but instead of installing the filters compiles
+         * them into raw BPF programs, to be installed (possibly many times, e.g. once per spawned
+         * service) with seccomp_load_compiled_filter() later on. Note that the programs don't carry
+         * load-time flags, hence this must not be used when e.g. SCMP_FLTATR_CTL_LOG is in effect. */
+
+        f = new0(SeccompCompiledFilter, 1);
+        if (!f)
+                return -ENOMEM;
+
+        if (hashmap_isempty(filter) && default_action == SCMP_ACT_ALLOW) {
+                *ret = TAKE_PTR(f);
+                return 0;
+        }
+
+        SECCOMP_FOREACH_LOCAL_ARCH(arch) {
+                _cleanup_(seccomp_releasep) scmp_filter_ctx seccomp = NULL;
+
+                r = seccomp_build_syscall_filter_for_arch(arch, default_action, filter, action, log_missing, &seccomp);
+                if (r < 0)
+                        return r;
+
+                r = seccomp_compiled_filter_add(f, seccomp);
+                if (r < 0)
+                        return r;
+        }
+
+        *ret = TAKE_PTR(f);
+        return 0;
+}
+
+int seccomp_load_compiled_filter(const SeccompCompiledFilter *f) {
+        assert(f);
+
+        /* Installs pre-compiled programs, with the same per-architecture error semantics as
+         * seccomp_load_syscall_filter_set_raw(): a failure to install one of the programs is only
+         * propagated for "real" errors. This is what libseccomp's seccomp_load() boils down to with
+         * the NNP fiddling turned off and no load-time flags. */
+
+        for (size_t i = 0; i < f->n_programs; i++)
+                if (prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &f->programs[i]) < 0) {
+                        if (ERRNO_IS_SECCOMP_FATAL(errno))
+                                return -errno;
+                        log_debug_errno(errno, "Failed to install compiled system call filter, skipping: %m");
+                }
+
+        return 0;
+}
+
+typedef struct SyscallFilterEntry {
+        int id;
+        int error;
+} SyscallFilterEntry;
+
+static int syscall_filter_entry_compare(const SyscallFilterEntry *a, const SyscallFilterEntry *b) {
+        return CMP(a->id, b->id);
+}
+
+int seccomp_filter_set_raw_make_key(uint32_t default_action, Hashmap *filter, uint32_t action, char **ret) {
+        _cleanup_free_ SyscallFilterEntry *entries = NULL;
+        _cleanup_free_ char *key = NULL;
+        void *syscall_id, *val;
+        size_t n = 0;
+        int r;
+
+        assert(ret);
+
+        /* Generates a string that identifies a syscall filter set: two filter sets with the same key
+         * compile to the same BPF programs. Since the hashmap enumeration order is not stable, the
+         * entries are sorted by syscall id first. */
+
+        entries = new(SyscallFilterEntry, hashmap_size(filter) + 1);
+        if (!entries)
+                return -ENOMEM;
+
+        HASHMAP_FOREACH_KEY(val, syscall_id, filter)
+                entries[n++] = (SyscallFilterEntry) {
+                        .id = PTR_TO_INT(syscall_id) - 1,
+                        .error = PTR_TO_INT(val),
+                };
+
+        typesafe_qsort(entries, n, syscall_filter_entry_compare);
+
+        if (asprintf(&key, "%" PRIu32 ":%" PRIu32, default_action, action) < 0)
+                return -ENOMEM;
+
+        for (size_t i = 0; i < n; i++) {
+                r = strextendf(&key, " %i:%i", entries[i].id, entries[i].error);
+                if (r < 0)
+                        return r;
+        }
+
+        *ret = TAKE_PTR(key);
+        return 0;
+}
+
+DEFINE_HASH_OPS_FULL(seccomp_compiled_filter_hash_ops,
+                     char, string_hash_func, string_compare_func, free,
+                     SeccompCompiledFilter, seccomp_compiled_filter_free);
+
 int seccomp_parse_syscall_filter(
                 const char *name,
                 int errno_num,
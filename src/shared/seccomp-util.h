@@ -76,6 +76,20 @@ int seccomp_add_syscall_filter_item(
 int seccomp_load_syscall_filter_set(uint32_t default_action, const SyscallFilterSet *set, uint32_t action, bool log_missing);
 int seccomp_load_syscall_filter_set_raw(uint32_t default_action, Hashmap* set, uint32_t action, bool log_missing);
 
+/* A syscall filter set compiled down to raw BPF programs, one per local architecture. Compiling is
+ * expensive (it's where libseccomp does its work), installing the result is cheap, hence this is
+ * worthwhile whenever the same filter is to be installed repeatedly. */
+typedef struct SeccompCompiledFilter SeccompCompiledFilter;
+
+SeccompCompiledFilter* seccomp_compiled_filter_free(SeccompCompiledFilter *f);
+DEFINE_TRIVIAL_CLEANUP_FUNC(SeccompCompiledFilter*, seccomp_compiled_filter_free);
+
+int seccomp_compile_syscall_filter_set_raw(uint32_t default_action, Hashmap* filter, uint32_t action, bool log_missing, SeccompCompiledFilter **ret);
+int seccomp_load_compiled_filter(const SeccompCompiledFilter *f);
+int seccomp_filter_set_raw_make_key(uint32_t default_action, Hashmap *filter, uint32_t action, char **ret);
+
+extern const struct hash_ops seccomp_compiled_filter_hash_ops; /* char* key → SeccompCompiledFilter* */
+
 typedef enum SeccompParseFlags {
         SECCOMP_PARSE_INVERT     = 1 << 0,
         SECCOMP_PARSE_ALLOW_LIST = 1 << 1,
@@ -45,6 +45,8 @@ int parse_sleep_config(SleepConfig **ret_sleep_config) {
         if (!sc)
                 return log_oom();
 
+        sc->hibernate_image_size = UINT64_MAX;
+
         const ConfigTableItem items[] = {
                 { "Sleep", "AllowSuspend",              config_parse_tristate, 0, &allow_suspend                  },
                 { "Sleep", "AllowHibernation",          config_parse_tristate, 0, &allow_hibernate                },
@@ -59,6 +61,7 @@ int parse_sleep_config(SleepConfig **ret_sleep_config) {
                 { "Sleep", "HybridSleepState",          config_parse_strv,     0, sc->states + SLEEP_HYBRID_SLEEP },
 
                 { "Sleep", "HibernateDelaySec",         config_parse_sec,      0, &sc->hibernate_delay_sec        },
+                { "Sleep", "HibernateImageSize",        config_parse_iec_uint64, 0, &sc->hibernate_image_size     },
                 {}
         };
 
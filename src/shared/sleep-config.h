@@ -18,6 +18,7 @@ typedef struct SleepConfig {
         char **modes[_SLEEP_OPERATION_MAX];
         char **states[_SLEEP_OPERATION_MAX];
         usec_t hibernate_delay_sec;
+        uint64_t hibernate_image_size; /* UINT64_MAX means: leave the kernel default alone */
 } SleepConfig;
 
 SleepConfig* free_sleep_config(SleepConfig *sc);
@@ -32,8 +32,11 @@ TSS2_RC (*sym_Esys_Load)(ESYS_CONTEXT *esysContext, ESYS_TR parentHandle, ESYS_T
 TSS2_RC (*sym_Esys_PCR_Read)(ESYS_CONTEXT *esysContext, ESYS_TR shandle1,ESYS_TR shandle2, ESYS_TR shandle3, const TPML_PCR_SELECTION *pcrSelectionIn, UINT32 *pcrUpdateCounter, TPML_PCR_SELECTION **pcrSelectionOut, TPML_DIGEST **pcrValues);
 TSS2_RC (*sym_Esys_PolicyGetDigest)(ESYS_CONTEXT *esysContext, ESYS_TR policySession, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3, TPM2B_DIGEST **policyDigest) = NULL;
 TSS2_RC (*sym_Esys_PolicyPCR)(ESYS_CONTEXT *esysContext, ESYS_TR policySession, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3, const TPM2B_DIGEST *pcrDigest, const TPML_PCR_SELECTION *pcrs) = NULL;
+TSS2_RC (*sym_Esys_ReadPublic)(ESYS_CONTEXT *esysContext, ESYS_TR objectHandle, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3, TPM2B_PUBLIC **outPublic, TPM2B_NAME **name, TPM2B_NAME **qualifiedName) = NULL;
 TSS2_RC (*sym_Esys_StartAuthSession)(ESYS_CONTEXT *esysContext, ESYS_TR tpmKey, ESYS_TR bind, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3, const TPM2B_NONCE *nonceCaller, TPM2_SE sessionType, const TPMT_SYM_DEF *symmetric, TPMI_ALG_HASH authHash, ESYS_TR *sessionHandle) = NULL;
 TSS2_RC (*sym_Esys_Startup)(ESYS_CONTEXT *esysContext, TPM2_SU startupType) = NULL;
+TSS2_RC (*sym_Esys_TR_Close)(ESYS_CONTEXT *esys_context, ESYS_TR *rsrc_handle) = NULL;
+TSS2_RC (*sym_Esys_TR_FromTPMPublic)(ESYS_CONTEXT *esysContext, TPM2_HANDLE tpm_handle, ESYS_TR optionalSession1, ESYS_TR optionalSession2, ESYS_TR optionalSession3, ESYS_TR *object) = NULL;
 TSS2_RC (*sym_Esys_Unseal)(ESYS_CONTEXT *esysContext, ESYS_TR itemHandle, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3, TPM2B_SENSITIVE_DATA **outData) = NULL;
 
 const char* (*sym_Tss2_RC_Decode)(TSS2_RC rc) = NULL;
@@ -60,8 +63,11 @@ int dlopen_tpm2(void) {
                         DLSYM_ARG(Esys_PCR_Read),
                         DLSYM_ARG(Esys_PolicyGetDigest),
                         DLSYM_ARG(Esys_PolicyPCR),
+                        DLSYM_ARG(Esys_ReadPublic),
                         DLSYM_ARG(Esys_StartAuthSession),
                         DLSYM_ARG(Esys_Startup),
+                        DLSYM_ARG(Esys_TR_Close),
+                        DLSYM_ARG(Esys_TR_FromTPMPublic),
                         DLSYM_ARG(Esys_Unseal));
         if (r < 0)
                 return r;
@@ -129,6 +135,21 @@ static ESYS_TR flush_context_verbose(ESYS_CONTEXT *c, ESYS_TR handle) {
         return ESYS_TR_NONE;
 }
 
+static ESYS_TR release_primary(ESYS_CONTEXT *c, ESYS_TR handle, bool persistent) {
+
+        /* Releases a primary key handle again. If it refers to a transient object we created ourselves,
+         * flush it from the TPM. If it refers to a persistent object (i.e. the SRK) there's nothing to
+         * flush on the TPM side, we just drop our ESAPI metadata for it. */
+
+        if (!persistent)
+                return flush_context_verbose(c, handle);
+
+        if (c && handle != ESYS_TR_NONE)
+                sym_Esys_TR_Close(c, &handle);
+
+        return ESYS_TR_NONE;
+}
+
 static int tpm2_init(const char *device, struct tpm2_context *ret) {
         _cleanup_(Esys_Finalize_wrapper) ESYS_CONTEXT *c = NULL;
         _cleanup_free_ TSS2_TCTI_CONTEXT *tcti = NULL;
@@ -257,11 +278,71 @@ static int tpm2_credit_random(ESYS_CONTEXT *c) {
         return 0;
 }
 
+#define SRK_HANDLE UINT32_C(0x81000001)
+
+static int tpm2_get_srk(
+                ESYS_CONTEXT *c,
+                ESYS_TR *ret_primary,
+                TPMI_ALG_PUBLIC *ret_alg) {
+
+        _cleanup_(Esys_Freep) TPM2B_PUBLIC *public = NULL;
+        ESYS_TR primary = ESYS_TR_NONE;
+        TSS2_RC rc;
+
+        assert(c);
+        assert(ret_primary);
+
+        /* Checks if a storage root key has been provisioned at the conventional persistent handle
+         * 0x81000001 (see TCG's "TPM v2.0 Provisioning Guidance", section 7.8), and if so returns a
+         * reference to it. Deriving a primary key with CreatePrimary is by far the most expensive part of
+         * each seal and unseal operation (the TPM redoes the key generation math every time, which on
+         * common discrete chips takes hundreds of ms for ECC and many seconds for RSA), while referencing a
+         * persistent object is a cheap handle lookup. Returns > 0 if the SRK was found, 0 if not. */
+
+        rc = sym_Esys_TR_FromTPMPublic(
+                        c,
+                        SRK_HANDLE,
+                        ESYS_TR_NONE,
+                        ESYS_TR_NONE,
+                        ESYS_TR_NONE,
+                        &primary);
+        if (rc != TSS2_RC_SUCCESS) {
+                log_debug("No SRK found at persistent handle 0x%" PRIx32 ": %s", SRK_HANDLE, sym_Tss2_RC_Decode(rc));
+                return 0;
+        }
+
+        if (ret_alg) {
+                rc = sym_Esys_ReadPublic(
+                                c,
+                                primary,
+                                ESYS_TR_NONE,
+                                ESYS_TR_NONE,
+                                ESYS_TR_NONE,
+                                &public,
+                                NULL,
+                                NULL);
+                if (rc != TSS2_RC_SUCCESS) {
+                        log_debug("Failed to read public area of SRK, ignoring it: %s", sym_Tss2_RC_Decode(rc));
+                        sym_Esys_TR_Close(c, &primary);
+                        return 0;
+                }
+
+                *ret_alg = public->publicArea.type;
+        }
+
+        log_debug("Using SRK found at persistent handle 0x%" PRIx32 ".", SRK_HANDLE);
+
+        *ret_primary = primary;
+        return 1;
+}
+
 static int tpm2_make_primary(
                 ESYS_CONTEXT *c,
                 ESYS_TR *ret_primary,
                 TPMI_ALG_PUBLIC alg,
-                TPMI_ALG_PUBLIC *ret_alg) {
+                bool use_srk,
+                TPMI_ALG_PUBLIC *ret_alg,
+                bool *ret_persistent) {
 
         static const TPM2B_SENSITIVE_CREATE primary_sensitive = {};
         static const TPM2B_PUBLIC primary_template_ecc = {
@@ -308,6 +389,25 @@ static int tpm2_make_primary(
         ESYS_TR primary = ESYS_TR_NONE;
         TSS2_RC rc;
         usec_t ts;
+        int r;
+
+        /* If the TPM has been provisioned with a persistent SRK, prefer that over deriving an equivalent
+         * transient primary key ourselves: the result is functionally the same (a restricted storage key
+         * rooted in the owner hierarchy), but we skip the expensive CreatePrimary operation. */
+        if (use_srk) {
+                r = tpm2_get_srk(c, &primary, ret_alg ? &alg : NULL);
+                if (r < 0)
+                        return r;
+                if (r > 0) {
+                        *ret_primary = primary;
+                        if (ret_alg)
+                                *ret_alg = alg;
+                        if (ret_persistent)
+                                *ret_persistent = true;
+
+                        return 0;
+                }
+        }
 
         log_debug("Creating primary key on TPM.");
 
@@ -379,6 +479,8 @@ static int tpm2_make_primary(
         *ret_primary = primary;
         if (ret_alg)
                 *ret_alg = alg;
+        if (ret_persistent)
+                *ret_persistent = false;
 
         return 0;
 }
@@ -738,6 +840,7 @@ int tpm2_seal(
         _cleanup_free_ void *blob = NULL, *hash = NULL;
         TPM2B_SENSITIVE_CREATE hmac_sensitive;
         ESYS_TR primary = ESYS_TR_NONE;
+        bool primary_persistent = false;
         TPMI_ALG_PUBLIC primary_alg;
         TPM2B_PUBLIC hmac_template;
         TPMI_ALG_HASH pcr_bank;
@@ -778,7 +881,7 @@ int tpm2_seal(
         if (r < 0)
                 return r;
 
-        r = tpm2_make_primary(c.esys_context, &primary, 0, &primary_alg);
+        r = tpm2_make_primary(c.esys_context, &primary, 0, /* use_srk= */ true, &primary_alg, &primary_persistent);
         if (r < 0)
                 return r;
 
@@ -910,7 +1013,7 @@ int tpm2_seal(
         r = 0;
 
 finish:
-        primary = flush_context_verbose(c.esys_context, primary);
+        primary = release_primary(c.esys_context, primary, primary_persistent);
         return r;
 }
 
@@ -928,6 +1031,7 @@ int tpm2_unseal(
 
         _cleanup_(tpm2_context_destroy) struct tpm2_context c = {};
         ESYS_TR primary = ESYS_TR_NONE, session = ESYS_TR_NONE, hmac_key = ESYS_TR_NONE;
+        bool primary_persistent = false;
         _cleanup_(Esys_Freep) TPM2B_SENSITIVE_DATA* unsealed = NULL;
         _cleanup_(Esys_Freep) TPM2B_DIGEST *policy_digest = NULL;
         _cleanup_(erase_and_freep) char *secret = NULL;
@@ -989,7 +1093,7 @@ int tpm2_unseal(
                 return log_error_errno(SYNTHETIC_ERRNO(EPERM),
                                        "Current policy digest does not match stored policy digest, cancelling TPM2 authentication attempt.");
 
-        r = tpm2_make_primary(c.esys_context, &primary, primary_alg, NULL);
+        r = tpm2_make_primary(c.esys_context, &primary, primary_alg, /* use_srk= */ true, NULL, &primary_persistent);
         if (r < 0)
                 return r;
 
@@ -1004,6 +1108,28 @@ int tpm2_unseal(
                         &private,
                         &public,
                         &hmac_key);
+        if (rc != TSS2_RC_SUCCESS && primary_persistent) {
+                /* The blob might predate SRK support and have been sealed to the deterministic transient
+                 * primary key instead. Retry with that before giving up. */
+                log_debug("Failed to load HMAC key under SRK, retrying under transient primary key: %s",
+                          sym_Tss2_RC_Decode(rc));
+
+                primary = release_primary(c.esys_context, primary, primary_persistent);
+
+                r = tpm2_make_primary(c.esys_context, &primary, primary_alg, /* use_srk= */ false, NULL, &primary_persistent);
+                if (r < 0)
+                        goto finish;
+
+                rc = sym_Esys_Load(
+                                c.esys_context,
+                                primary,
+                                ESYS_TR_PASSWORD,
+                                ESYS_TR_NONE,
+                                ESYS_TR_NONE,
+                                &private,
+                                &public,
+                                &hmac_key);
+        }
         if (rc != TSS2_RC_SUCCESS) {
                 r = log_error_errno(SYNTHETIC_ERRNO(ENOTRECOVERABLE),
                                     "Failed to load HMAC key in TPM: %s", sym_Tss2_RC_Decode(rc));
@@ -1041,7 +1167,7 @@ int tpm2_unseal(
         r = 0;
 
 finish:
-        primary = flush_context_verbose(c.esys_context, primary);
+        primary = release_primary(c.esys_context, primary, primary_persistent);
         session = flush_context_verbose(c.esys_context, session);
         hmac_key = flush_context_verbose(c.esys_context, hmac_key);
         return r;
@@ -433,7 +433,9 @@ static int userdb_start_query(
                         return -ENOMEM;
         }
 
-        /* First, let's talk to the multiplexer, if we can */
+        /* First, let's talk to the multiplexer, if we can. It lets us get away with a single connection per
+         * lookup: it fans out to all other services and to NSS on our behalf, so that we don't have to open
+         * one socket per service here. */
         if ((flags & (USERDB_AVOID_MULTIPLEXER|USERDB_EXCLUDE_DYNAMIC_USER|USERDB_EXCLUDE_NSS|USERDB_EXCLUDE_DROPIN|USERDB_DONT_SYNTHESIZE)) == 0 &&
             !strv_contains(except, "io.systemd.Multiplexer") &&
             (!only || strv_contains(only, "io.systemd.Multiplexer"))) {
@@ -28,6 +28,12 @@
 #define VARLINK_BUFFER_MAX (16U*1024U*1024U)
 #define VARLINK_READ_SIZE (64U*1024U)
 
+/* Maximum number of processing steps (read, parse, dispatch, write, …) to execute in one
+ * varlink_process() invocation. Each queued message takes about three steps to dispatch, hence this
+ * allows draining several pipelined calls on a single event loop iteration, while keeping the batch
+ * bounded so a chatty peer cannot starve other event sources. */
+#define VARLINK_PROCESS_STEPS_MAX 24U
+
 typedef enum VarlinkState {
         /* Client side states */
         VARLINK_IDLE_CLIENT,
@@ -922,67 +928,82 @@ fail:
         return r;
 }
 
-int varlink_process(Varlink *v) {
+static int varlink_process_one(Varlink *v) {
         int r;
 
-        assert_return(v, -EINVAL);
-
-        if (v->state == VARLINK_DISCONNECTED)
-                return varlink_log_errno(v, SYNTHETIC_ERRNO(ENOTCONN), "Not connected.");
-
-        varlink_ref(v);
+        assert(v);
 
         r = varlink_write(v);
         if (r < 0)
                 varlink_log_errno(v, r, "Write failed: %m");
         if (r != 0)
-                goto finish;
+                return r;
 
         r = varlink_dispatch_reply(v);
         if (r < 0)
                 varlink_log_errno(v, r, "Reply dispatch failed: %m");
         if (r != 0)
-                goto finish;
+                return r;
 
         r = varlink_dispatch_method(v);
         if (r < 0)
                 varlink_log_errno(v, r, "Method dispatch failed: %m");
         if (r != 0)
-                goto finish;
+                return r;
 
         r = varlink_parse_message(v);
         if (r < 0)
                 varlink_log_errno(v, r, "Message parsing failed: %m");
         if (r != 0)
-                goto finish;
+                return r;
 
         r = varlink_read(v);
         if (r < 0)
                 varlink_log_errno(v, r, "Read failed: %m");
         if (r != 0)
-                goto finish;
+                return r;
 
         r = varlink_test_disconnect(v);
         assert(r >= 0);
         if (r != 0)
-                goto finish;
+                return r;
 
         r = varlink_dispatch_disconnect(v);
         assert(r >= 0);
         if (r != 0)
-                goto finish;
+                return r;
 
         r = varlink_test_timeout(v);
         assert(r >= 0);
         if (r != 0)
-                goto finish;
+                return r;
 
-        r = varlink_dispatch_timeout(v);
-        assert(r >= 0);
-        if (r != 0)
-                goto finish;
+        return varlink_dispatch_timeout(v);
+}
+
+int varlink_process(Varlink *v) {
+        int r = 0;
+
+        assert_return(v, -EINVAL);
+
+        if (v->state == VARLINK_DISCONNECTED)
+                return varlink_log_errno(v, SYNTHETIC_ERRNO(ENOTCONN), "Not connected.");
+
+        varlink_ref(v);
+
+        /* Execute a bounded batch of processing steps in one go, so that several pipelined method calls
+         * queued up in the input buffer are dispatched on a single event loop iteration, instead of one
+         * step per iteration via the deferred event source. */
+        for (unsigned i = 0; i < VARLINK_PROCESS_STEPS_MAX; i++) {
+                r = varlink_process_one(v);
+                if (r <= 0)
+                        break;
+
+                if (v->state == VARLINK_DISCONNECTED)
+                        /* A callback might have closed the connection, don't process any further */
+                        break;
+        }
 
-finish:
         if (r >= 0 && v->defer_event_source) {
                 int q;
 
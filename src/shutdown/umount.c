@@ -13,6 +13,7 @@
 #include <sys/swap.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <unistd.h>
 
 #if HAVE_VALGRIND_MEMCHECK_H
@@ -508,127 +509,208 @@ static bool nonunmountable_path(const char *path) {
                 || path_startswith(path, "/run/initramfs");
 }
 
-static int remount_with_timeout(MountPoint *m, int umount_log_level) {
-        pid_t pid;
-        int r;
+/* Maximum number of unmount workers forked at the same time */
+#define UMOUNT_MAX_WORKERS 16U
 
-        BLOCK_SIGNALS(SIGCHLD);
+/* Exit codes of the unmount workers */
+enum {
+        UMOUNT_WORKER_UMOUNTED = EXIT_SUCCESS, /* umount succeeded, the mount table changed */
+        UMOUNT_WORKER_FAILED   = EXIT_FAILURE, /* remount or umount failed */
+        UMOUNT_WORKER_NOTHING  = 2,            /* nothing to unmount (e.g. we only remounted read-only) */
+};
 
+static int umount_worker(const MountPoint *m, int umount_log_level) {
         assert(m);
 
-        /* Due to the possibility of a remount operation hanging, we fork a child process and set a
-         * timeout. If the timeout lapses, the assumption is that the particular remount failed. */
-        r = safe_fork("(sd-remount)", FORK_RESET_SIGNALS|FORK_CLOSE_ALL_FDS|FORK_LOG|FORK_REOPEN_LOG, &pid);
-        if (r < 0)
-                return r;
-        if (r == 0) {
+        if (m->try_remount_ro) {
+                /* We always try to remount directories read-only first, before we go on and umount
+                 * them.
+                 *
+                 * Mount points can be stacked. If a mount point is stacked below / or /usr, we
+                 * cannot umount or remount it directly, since there is no way to refer to the
+                 * underlying mount. There's nothing we can do about it for the general case, but we
+                 * can do something about it if it is aliased somewhere else via a bind mount. If we
+                 * explicitly remount the super block of that alias read-only we hence should be
+                 * relatively safe regarding keeping a dirty fs we cannot otherwise see. */
                 log_info("Remounting '%s' read-only with options '%s'.", m->path, strempty(m->remount_options));
 
-                /* Start the mount operation here in the child */
-                r = mount(NULL, m->path, NULL, m->remount_flags, m->remount_options);
-                if (r < 0)
+                if (mount(NULL, m->path, NULL, m->remount_flags, m->remount_options) < 0) {
                         log_full_errno(umount_log_level, errno, "Failed to remount '%s' read-only: %m", m->path);
 
-                _exit(r < 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+                        /* Remount failed, but try unmounting anyway, unless this is a mount point
+                         * we want to skip. */
+                        if (nonunmountable_path(m->path))
+                                return UMOUNT_WORKER_FAILED;
+                }
         }
 
-        r = wait_for_terminate_with_timeout(pid, DEFAULT_TIMEOUT_USEC);
-        if (r == -ETIMEDOUT) {
-                log_error_errno(r, "Remounting '%s' timed out, issuing SIGKILL to PID " PID_FMT ".", m->path, pid);
-                (void) kill(pid, SIGKILL);
-        } else if (r == -EPROTO)
-                log_debug_errno(r, "Remounting '%s' failed abnormally, child process " PID_FMT " aborted or exited non-zero.", m->path, pid);
-        else if (r < 0)
-                log_error_errno(r, "Remounting '%s' failed unexpectedly, couldn't wait for child process " PID_FMT ": %m", m->path, pid);
+        /* Skip / and /usr since we cannot unmount that anyway, since we are running from it. They
+         * have already been remounted ro. */
+        if (nonunmountable_path(m->path))
+                return UMOUNT_WORKER_NOTHING;
 
-        return r;
+        log_info("Unmounting '%s'.", m->path);
+
+        /* Using MNT_FORCE causes some filesystems (e.g. FUSE and NFS and other network
+         * filesystems) to abort any pending requests and return -EIO rather than blocking
+         * indefinitely. If the filesysten is "busy", this may allow processes to die, thus making
+         * the filesystem less busy so the unmount might succeed (rather than return EBUSY). */
+        if (umount2(m->path, MNT_FORCE) < 0) {
+                log_full_errno(umount_log_level, errno, "Failed to unmount %s: %m", m->path);
+                return UMOUNT_WORKER_FAILED;
+        }
+
+        return UMOUNT_WORKER_UMOUNTED;
 }
 
-static int umount_with_timeout(MountPoint *m, int umount_log_level) {
-        pid_t pid;
-        int r;
+static void umount_batch_wait(pid_t *pids, MountPoint **mounts, size_t n, bool *changed, int *n_failed) {
+        usec_t until;
 
-        BLOCK_SIGNALS(SIGCHLD);
+        assert(pids || n == 0);
+        assert(mounts || n == 0);
+        assert(changed);
+        assert(n_failed);
 
-        assert(m);
+        /* Waits for a batch of unmount workers, running concurrently against a shared deadline. A batch
+         * hence takes at most DEFAULT_TIMEOUT_USEC in total, not a multiple of it, no matter how many of
+         * its workers hang. Assumes SIGCHLD is blocked, see the comment on
+         * wait_for_terminate_with_timeout(). */
 
-        /* Due to the possibility of a umount operation hanging, we fork a child process and set a
-         * timeout. If the timeout lapses, the assumption is that the particular umount failed. */
-        r = safe_fork("(sd-umount)", FORK_RESET_SIGNALS|FORK_CLOSE_ALL_FDS|FORK_LOG|FORK_REOPEN_LOG, &pid);
-        if (r < 0)
-                return r;
-        if (r == 0) {
-                log_info("Unmounting '%s'.", m->path);
-
-                /* Start the mount operation here in the child Using MNT_FORCE
-                 * causes some filesystems (e.g. FUSE and NFS and other network
-                 * filesystems) to abort any pending requests and return -EIO
-                 * rather than blocking indefinitely. If the filesysten is
-                 * "busy", this may allow processes to die, thus making the
-                 * filesystem less busy so the unmount might succeed (rather
-                 * than return EBUSY). */
-                r = umount2(m->path, MNT_FORCE);
-                if (r < 0)
-                        log_full_errno(umount_log_level, errno, "Failed to unmount %s: %m", m->path);
+        until = usec_add(now(CLOCK_MONOTONIC), DEFAULT_TIMEOUT_USEC);
 
-                _exit(r < 0 ? EXIT_FAILURE : EXIT_SUCCESS);
-        }
+        for (;;) {
+                bool pending = false;
+                struct timespec ts;
+                sigset_t mask;
+                usec_t t;
+
+                /* Reap before waiting for SIGCHLD: standard signals coalesce, hence a worker that exited
+                 * while we processed its sibling would otherwise make us wait for a signal that never
+                 * comes. */
+                for (size_t i = 0; i < n; i++) {
+                        siginfo_t si = {};
+
+                        if (pids[i] <= 0)
+                                continue;
 
-        r = wait_for_terminate_with_timeout(pid, DEFAULT_TIMEOUT_USEC);
-        if (r == -ETIMEDOUT) {
-                log_error_errno(r, "Unmounting '%s' timed out, issuing SIGKILL to PID " PID_FMT ".", m->path, pid);
-                (void) kill(pid, SIGKILL);
-        } else if (r == -EPROTO)
-                log_debug_errno(r, "Unmounting '%s' failed abnormally, child process " PID_FMT " aborted or exited non-zero.", m->path, pid);
-        else if (r < 0)
-                log_error_errno(r, "Unmounting '%s' failed unexpectedly, couldn't wait for child process " PID_FMT ": %m", m->path, pid);
+                        if (waitid(P_PID, pids[i], &si, WEXITED|WNOHANG) == 0 && si.si_pid == pids[i]) {
+                                if (si.si_code == CLD_EXITED && si.si_status == UMOUNT_WORKER_UMOUNTED)
+                                        *changed = true;
+                                else if (si.si_code != CLD_EXITED || si.si_status != UMOUNT_WORKER_NOTHING) {
+                                        if (si.si_code != CLD_EXITED)
+                                                log_debug("Unmount worker for '%s' (PID " PID_FMT ") terminated abnormally.",
+                                                          mounts[i]->path, pids[i]);
+                                        (*n_failed)++;
+                                }
 
-        return r;
+                                pids[i] = 0;
+                                continue;
+                        }
+
+                        pending = true;
+                }
+
+                if (!pending)
+                        return;
+
+                t = now(CLOCK_MONOTONIC);
+                if (t >= until) {
+                        for (size_t i = 0; i < n; i++) {
+                                if (pids[i] <= 0)
+                                        continue;
+
+                                log_error("Unmounting '%s' timed out, issuing SIGKILL to PID " PID_FMT ".",
+                                          mounts[i]->path, pids[i]);
+                                (void) kill(pids[i], SIGKILL);
+                                (void) waitid(P_PID, pids[i], &(siginfo_t) {}, WEXITED);
+                                pids[i] = 0;
+                                (*n_failed)++;
+                        }
+
+                        return;
+                }
+
+                assert_se(sigemptyset(&mask) == 0);
+                assert_se(sigaddset(&mask, SIGCHLD) == 0);
+                (void) sigtimedwait(&mask, NULL, timespec_store(&ts, until - t));
+        }
 }
 
 /* This includes remounting readonly, which changes the kernel mount options.  Therefore the list passed to
  * this function is invalidated, and should not be reused. */
 static int mount_points_list_umount(MountPoint **head, bool *changed, int umount_log_level) {
-        MountPoint *m;
+        _cleanup_free_ MountPoint **mounts = NULL;
+        _cleanup_free_ unsigned *generation = NULL;
+        unsigned max_generation = 0;
+        size_t n = 0, k = 0;
         int n_failed = 0;
+        MountPoint *m;
 
         assert(head);
         assert(changed);
 
-        LIST_FOREACH(mount_point, m, *head) {
-                if (m->try_remount_ro) {
-                        /* We always try to remount directories read-only first, before we go on and umount
-                         * them.
-                         *
-                         * Mount points can be stacked. If a mount point is stacked below / or /usr, we
-                         * cannot umount or remount it directly, since there is no way to refer to the
-                         * underlying mount. There's nothing we can do about it for the general case, but we
-                         * can do something about it if it is aliased somewhere else via a bind mount. If we
-                         * explicitly remount the super block of that alias read-only we hence should be
-                         * relatively safe regarding keeping a dirty fs we cannot otherwise see.
-                         *
-                         * Since the remount can hang in the instance of remote filesystems, we remount
-                         * asynchronously and skip the subsequent umount if it fails. */
-                        if (remount_with_timeout(m, umount_log_level) < 0) {
-                                /* Remount failed, but try unmounting anyway,
-                                 * unless this is a mount point we want to skip. */
-                                if (nonunmountable_path(m->path)) {
-                                        n_failed++;
-                                        continue;
-                                }
+        LIST_FOREACH(mount_point, m, *head)
+                n++;
+        if (n == 0)
+                return 0;
+
+        mounts = new(MountPoint*, n);
+        generation = new0(unsigned, n);
+        if (!mounts || !generation)
+                return log_oom();
+
+        LIST_FOREACH(mount_point, m, *head)
+                mounts[k++] = m;
+
+        /* The list is ordered newest mount first, and a mount point may only be unmounted once everything
+         * mounted at or below its path is gone. Partition the list into generations accordingly: each entry
+         * must wait for the generation of the newer mounts it depends on, while everything within one
+         * generation is independent and can be processed in parallel. This way a single hung (network)
+         * file system stalls neither the unrelated mount points next to it nor costs a full timeout
+         * period of its own. */
+        for (size_t i = 0; i < n; i++)
+                for (size_t j = 0; j < i; j++)
+                        if (path_startswith(mounts[j]->path, mounts[i]->path)) {
+                                generation[i] = MAX(generation[i], generation[j] + 1);
+                                max_generation = MAX(max_generation, generation[i]);
                         }
-                }
 
-                /* Skip / and /usr since we cannot unmount that anyway, since we are running from it. They
-                 * have already been remounted ro. */
-                if (nonunmountable_path(m->path))
-                        continue;
+        BLOCK_SIGNALS(SIGCHLD);
 
-                /* Trying to umount */
-                if (umount_with_timeout(m, umount_log_level) < 0)
-                        n_failed++;
-                else
-                        *changed = true;
+        for (unsigned g = 0; g <= max_generation; g++) {
+                MountPoint *batch[UMOUNT_MAX_WORKERS];
+                pid_t batch_pids[UMOUNT_MAX_WORKERS];
+                size_t n_batch = 0;
+
+                for (size_t i = 0; i < n; i++) {
+                        pid_t pid;
+                        int r;
+
+                        if (generation[i] != g)
+                                continue;
+
+                        /* Due to the possibility of a remount or umount operation hanging, each mount point
+                         * is processed in a forked child, a batch at a time. */
+                        r = safe_fork("(sd-umount)", FORK_RESET_SIGNALS|FORK_CLOSE_ALL_FDS|FORK_LOG|FORK_REOPEN_LOG, &pid);
+                        if (r < 0) {
+                                log_full_errno(umount_log_level, r, "Failed to fork unmount worker for '%s': %m", mounts[i]->path);
+                                n_failed++;
+                                continue;
+                        }
+                        if (r == 0)
+                                _exit(umount_worker(mounts[i], umount_log_level));
+
+                        batch[n_batch] = mounts[i];
+                        batch_pids[n_batch] = pid;
+                        n_batch++;
+
+                        if (n_batch >= UMOUNT_MAX_WORKERS) {
+                                umount_batch_wait(batch_pids, batch, n_batch, changed, &n_failed);
+                                n_batch = 0;
+                        }
+                }
+
+                umount_batch_wait(batch_pids, batch, n_batch, changed, &n_failed);
         }
 
         return n_failed;
@@ -224,6 +224,19 @@ static int execute(
                                 return log_error_errno(r, "Failed to prepare for hibernation: %m");
                 }
 
+                /* Optionally cap the hibernation image size. The kernel shrinks memory (dropping page cache
+                 * and swapping out anonymous pages) until the image fits, hence a lower cap directly cuts
+                 * the amount of data written out, which dominates hibernation time on large-memory
+                 * machines. */
+                if (sleep_config->hibernate_image_size != UINT64_MAX) {
+                        char size_str[DECIMAL_STR_MAX(uint64_t)];
+
+                        xsprintf(size_str, "%" PRIu64, sleep_config->hibernate_image_size);
+                        r = write_string_file("/sys/power/image_size", size_str, WRITE_STRING_FILE_DISABLE_BUFFER);
+                        if (r < 0)
+                                log_warning_errno(r, "Failed to write image size to /sys/power/image_size, ignoring: %m");
+                }
+
                 r = write_mode(modes);
                 if (r < 0)
                         return log_error_errno(r, "Failed to write mode to /sys/power/disk: %m");;
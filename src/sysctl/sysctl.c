@@ -1,6 +1,7 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
 #include <errno.h>
+#include <fcntl.h>
 #include <getopt.h>
 #include <limits.h>
 #include <stdbool.h>
@@ -97,10 +98,10 @@ static Option *option_new(
         return TAKE_PTR(o);
 }
 
-static int sysctl_write_or_warn(const char *key, const char *value, bool ignore_failure) {
+static int sysctl_write_or_warn(int proc_sys_fd, const char *key, const char *value, bool ignore_failure) {
         int r;
 
-        r = sysctl_write(key, value);
+        r = sysctl_write_at(proc_sys_fd, key, value);
         if (r < 0) {
                 /* If the sysctl is not available in the kernel or we are running with reduced privileges and
                  * cannot write it, then log about the issue, and proceed without failing. (EROFS is treated
@@ -118,9 +119,19 @@ static int sysctl_write_or_warn(const char *key, const char *value, bool ignore_
 }
 
 static int apply_all(OrderedHashmap *sysctl_options) {
+        _cleanup_close_ int proc_sys_fd = -1;
         Option *option;
         int r = 0;
 
+        if (ordered_hashmap_isempty(sysctl_options))
+                return 0;
+
+        /* Open /proc/sys once, and resolve all keys relative to it, so that the kernel doesn't have to walk
+         * the full path from the root for each of the (possibly very many) sysctls we apply. */
+        proc_sys_fd = open("/proc/sys", O_CLOEXEC|O_DIRECTORY|O_PATH);
+        if (proc_sys_fd < 0)
+                return log_error_errno(errno, "Failed to open /proc/sys/: %m");
+
         ORDERED_HASHMAP_FOREACH(option, sysctl_options) {
                 int k;
 
@@ -165,13 +176,13 @@ static int apply_all(OrderedHashmap *sysctl_options) {
                                         continue;
                                 }
 
-                                k = sysctl_write_or_warn(key, option->value, option->ignore_failure);
+                                k = sysctl_write_or_warn(proc_sys_fd, key, option->value, option->ignore_failure);
                                 if (r == 0)
                                         r = k;
                         }
 
                 } else {
-                        k = sysctl_write_or_warn(option->key, option->value, option->ignore_failure);
+                        k = sysctl_write_or_warn(proc_sys_fd, option->key, option->value, option->ignore_failure);
                         if (r == 0)
                                 r = k;
                 }
@@ -32,6 +32,7 @@
 #include "process-util.h"
 #include "sort-util.h"
 #include "stat-util.h"
+#include "strv.h"
 #include "terminal-util.h"
 #include "user-util.h"
 #include "verbs.h"
@@ -798,6 +799,95 @@ static int verb_merge(int argc, char **argv, void *userdata) {
         return merge(images);
 }
 
+static int merge_is_up_to_date(Hashmap *images) {
+        usec_t merged_at = USEC_INFINITY;
+        _cleanup_strv_free_ char **want = NULL;
+        bool any_merged = false;
+        Image *img;
+        char **h;
+        int r;
+
+        assert(images);
+
+        /* Checks whether the overlays currently mounted already reflect the installed set of extension
+         * images, in which case "refresh" doesn't have to tear everything down just to rebuild the very
+         * same stack. We can only reason about content changes via the mtime of image files, hence only
+         * file-backed images qualify for the shortcut. Returns > 0 if the merge is up-to-date. */
+
+        if (hashmap_isempty(images))
+                return 0;
+
+        HASHMAP_FOREACH(img, images) {
+                if (!IN_SET(img->type, IMAGE_RAW, IMAGE_BLOCK))
+                        return 0; /* Directory-based extensions don't propagate changes deep in the tree
+                                   * into the top-level mtime, we cannot cheaply detect changes for them. */
+
+                if (!timestamp_is_set(img->mtime))
+                        return 0;
+
+                r = strv_extend(&want, img->name);
+                if (r < 0)
+                        return log_oom();
+        }
+
+        /* merge_subprocess() sorts the extension list the same way before writing it out */
+        typesafe_qsort(want, strv_length(want), strverscmp_improvedp);
+
+        STRV_FOREACH(h, arg_hierarchies) {
+                _cleanup_free_ char *resolved = NULL, *f = NULL, *buf = NULL;
+                _cleanup_strv_free_ char **have = NULL;
+                struct stat st;
+
+                r = chase_symlinks(*h, arg_root, CHASE_PREFIX_ROOT, &resolved, NULL);
+                if (r == -ENOENT)
+                        continue;
+                if (r < 0)
+                        return log_error_errno(r, "Failed to resolve path to hierarchy '%s%s': %m", strempty(arg_root), *h);
+
+                r = is_our_mount_point(resolved);
+                if (r < 0)
+                        return r;
+                if (r == 0)
+                        continue;
+
+                f = path_join(resolved, ".systemd-sysext/extensions");
+                if (!f)
+                        return log_oom();
+
+                r = read_full_file(f, &buf, NULL);
+                if (r < 0) {
+                        log_debug_errno(r, "Failed to read '%s', assuming merge is stale: %m", f);
+                        return 0;
+                }
+
+                r = strv_split_newlines_full(&have, buf, 0);
+                if (r < 0)
+                        return log_error_errno(r, "Failed to parse '%s': %m", f);
+
+                if (!strv_equal(have, want))
+                        return 0;
+
+                /* The hierarchy's top-level mtime marks the point the merge was established, see
+                 * merge_hierarchy(). */
+                if (lstat(resolved, &st) < 0)
+                        return log_error_errno(errno, "Failed to stat '%s': %m", resolved);
+
+                merged_at = MIN(merged_at, timespec_load(&st.st_mtim));
+                any_merged = true;
+        }
+
+        if (!any_merged)
+                return 0;
+
+        /* Every merged hierarchy was built from exactly the installed set of extensions. Hence the merge is
+         * only stale if some image file was modified since it was established. */
+        HASHMAP_FOREACH(img, images)
+                if (img->mtime >= merged_at)
+                        return 0;
+
+        return 1;
+}
+
 static int verb_refresh(int argc, char **argv, void *userdata) {
         _cleanup_(hashmap_freep) Hashmap *images = NULL;
         int r;
@@ -809,6 +899,14 @@ static int verb_refresh(int argc, char **argv, void *userdata) {
         if (r < 0)
                 return r;
 
+        r = merge_is_up_to_date(images);
+        if (r < 0)
+                return r;
+        if (r > 0) {
+                log_info("Installed extensions already match the merged state, skipping refresh.");
+                return 0;
+        }
+
         r = merge(images); /* Returns > 0 if it did something, i.e. a new overlayfs is mounted now. When it
                             * does so it implicitly unmounts any overlayfs placed there before. Returns == 0
                             * if it did nothing, i.e. no extension images found. In this case the old
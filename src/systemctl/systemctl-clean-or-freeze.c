@@ -15,7 +15,9 @@ int verb_clean_or_freeze(int argc, char *argv[], void *userdata) {
         const char *method;
         sd_bus *bus;
 
-        r = acquire_bus(BUS_FULL, &bus);
+        /* We only need the full bus when we are to wait for the operation to complete, since watching unit
+         * state requires signal matches via the broker. Otherwise talk to the manager directly. */
+        r = acquire_bus(arg_no_block ? BUS_MANAGER : BUS_FULL, &bus);
         if (r < 0)
                 return r;
 
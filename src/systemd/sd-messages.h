@@ -120,6 +120,9 @@ _SD_BEGIN_DECLARATIONS;
 #define SD_MESSAGE_SPAWN_FAILED           SD_ID128_MAKE(64,12,57,65,1c,1b,4e,c9,a8,62,4d,7a,40,a9,e1,e7)
 #define SD_MESSAGE_SPAWN_FAILED_STR       SD_ID128_MAKE_STR(64,12,57,65,1c,1b,4e,c9,a8,62,4d,7a,40,a9,e1,e7)
 
+#define SD_MESSAGE_UNIT_EXEC_TIMING       SD_ID128_MAKE(81,8c,81,85,5d,ac,4d,40,b4,4d,66,59,10,58,d7,1c)
+#define SD_MESSAGE_UNIT_EXEC_TIMING_STR   SD_ID128_MAKE_STR(81,8c,81,85,5d,ac,4d,40,b4,4d,66,59,10,58,d7,1c)
+
 #define SD_MESSAGE_UNIT_PROCESS_EXIT      SD_ID128_MAKE(98,e3,22,20,3f,7a,4e,d2,90,d0,9f,e0,3c,09,fe,15)
 #define SD_MESSAGE_UNIT_PROCESS_EXIT_STR  SD_ID128_MAKE_STR(98,e3,22,20,3f,7a,4e,d2,90,d0,9f,e0,3c,09,fe,15)
 
@@ -0,0 +1,189 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "alloc-util.h"
+#include "escape.h"
+#include "extract-word.h"
+#include "hashmap.h"
+#include "json.h"
+#include "random-util.h"
+#include "siphash24.h"
+#include "string-util.h"
+#include "strv.h"
+#include "tests.h"
+#include "time-util.h"
+
+/* Microbenchmarks for hot primitives in src/basic/ and src/shared/. Each benchmark runs a fixed number of
+ * iterations and emits one machine readable JSON record on stdout, so that release-to-release comparisons
+ * can be scripted instead of bisected by hand. Iteration counts are sized to finish well within the default
+ * test timeout even on slow machines; the absolute numbers only carry meaning relative to other runs on the
+ * same hardware. */
+
+/* Sunk results, so that the compiler cannot elide the benchmarked loops */
+static volatile uint64_t sink;
+
+static void report(const char *name, uint64_t iterations, usec_t elapsed) {
+        _cleanup_(json_variant_unrefp) JsonVariant *v = NULL;
+
+        elapsed = MAX(elapsed, USEC_PER_MSEC / 1000); /* avoid division by zero */
+
+        assert_se(json_build(&v, JSON_BUILD_OBJECT(
+                                             JSON_BUILD_PAIR("name", JSON_BUILD_STRING(name)),
+                                             JSON_BUILD_PAIR("iterations", JSON_BUILD_UNSIGNED(iterations)),
+                                             JSON_BUILD_PAIR("ns_per_op", JSON_BUILD_REAL(elapsed * 1000.0 / iterations)),
+                                             JSON_BUILD_PAIR("ops_per_sec", JSON_BUILD_REAL(iterations / ((double) elapsed / USEC_PER_SEC))))) >= 0);
+
+        json_variant_dump(v, JSON_FORMAT_NEWLINE, stdout, NULL);
+}
+
+TEST(benchmark_siphash24) {
+        static const uint8_t key[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+        const uint64_t n = 1000000;
+        uint8_t buf[256];
+        uint64_t x = 0;
+        usec_t t;
+
+        random_bytes(buf, sizeof(buf));
+
+        t = now(CLOCK_MONOTONIC);
+        for (uint64_t i = 0; i < n; i++) {
+                buf[0] = (uint8_t) i;
+                x ^= siphash24(buf, sizeof(buf), key);
+        }
+        t = usec_sub_unsigned(now(CLOCK_MONOTONIC), t);
+
+        sink = x;
+        report("siphash24-256b", n, t);
+}
+
+TEST(benchmark_hashmap) {
+        _cleanup_hashmap_free_ Hashmap *h = NULL;
+        const uint64_t n = 100000, lookups = 1000000;
+        uint64_t x = 0;
+        usec_t t;
+
+        h = hashmap_new(NULL);
+        assert_se(h);
+
+        t = now(CLOCK_MONOTONIC);
+        for (uint64_t i = 0; i < n; i++)
+                assert_se(hashmap_put(h, UINT_TO_PTR(i + 1), UINT_TO_PTR(i + 1)) >= 0);
+        t = usec_sub_unsigned(now(CLOCK_MONOTONIC), t);
+
+        report("hashmap-put", n, t);
+
+        t = now(CLOCK_MONOTONIC);
+        for (uint64_t i = 0; i < lookups; i++)
+                x ^= PTR_TO_UINT(hashmap_get(h, UINT_TO_PTR(i % n + 1)));
+        t = usec_sub_unsigned(now(CLOCK_MONOTONIC), t);
+
+        sink = x;
+        report("hashmap-get", lookups, t);
+}
+
+TEST(benchmark_strv) {
+        _cleanup_free_ char *sample = NULL;
+        const uint64_t n = 20000;
+        usec_t t;
+
+        sample = strrep("example-word ", 64);
+        assert_se(sample);
+
+        t = now(CLOCK_MONOTONIC);
+        for (uint64_t i = 0; i < n; i++) {
+                _cleanup_strv_free_ char **l = NULL;
+                _cleanup_free_ char *j = NULL;
+
+                l = strv_split(sample, WHITESPACE);
+                assert_se(l);
+
+                j = strv_join(l, " ");
+                assert_se(j);
+        }
+        t = usec_sub_unsigned(now(CLOCK_MONOTONIC), t);
+
+        report("strv-split-join", n, t);
+}
+
+TEST(benchmark_escape) {
+        _cleanup_free_ char *sample = NULL, *escaped = NULL;
+        const uint64_t n = 50000;
+        usec_t t;
+
+        sample = strrep("some text with\ttabs, \"quotes\", \\ and the occasional high bit \360\237\222\276\n", 8);
+        assert_se(sample);
+
+        t = now(CLOCK_MONOTONIC);
+        for (uint64_t i = 0; i < n; i++) {
+                _cleanup_free_ char *e = NULL;
+
+                e = cescape(sample);
+                assert_se(e);
+
+                if (i == 0)
+                        escaped = TAKE_PTR(e);
+        }
+        t = usec_sub_unsigned(now(CLOCK_MONOTONIC), t);
+
+        report("cescape", n, t);
+
+        t = now(CLOCK_MONOTONIC);
+        for (uint64_t i = 0; i < n; i++) {
+                _cleanup_free_ char *u = NULL;
+
+                assert_se(cunescape(escaped, 0, &u) >= 0);
+        }
+        t = usec_sub_unsigned(now(CLOCK_MONOTONIC), t);
+
+        report("cunescape", n, t);
+}
+
+TEST(benchmark_extract_word) {
+        _cleanup_free_ char *sample = NULL;
+        const uint64_t n = 20000;
+        uint64_t words = 0;
+        usec_t t;
+
+        sample = strrep("one two \"three four\" five\\ six ", 16);
+        assert_se(sample);
+
+        t = now(CLOCK_MONOTONIC);
+        for (uint64_t i = 0; i < n; i++) {
+                const char *p = sample;
+
+                for (;;) {
+                        _cleanup_free_ char *word = NULL;
+                        int r;
+
+                        r = extract_first_word(&p, &word, NULL, EXTRACT_UNQUOTE);
+                        assert_se(r >= 0);
+                        if (r == 0)
+                                break;
+
+                        words++;
+                }
+        }
+        t = usec_sub_unsigned(now(CLOCK_MONOTONIC), t);
+
+        report("extract-first-word", words, t);
+}
+
+TEST(benchmark_json_parse) {
+        static const char doc[] =
+                "{\"name\":\"benchmark\",\"enabled\":true,\"count\":4711,\"ratio\":0.25,"
+                "\"tags\":[\"one\",\"two\",\"three\",\"four\"],"
+                "\"nested\":{\"a\":[1,2,3,4,5,6,7,8],\"b\":null,\"c\":\"text with \\u00e4 escapes\\n\"}}";
+        const uint64_t n = 50000;
+        usec_t t;
+
+        t = now(CLOCK_MONOTONIC);
+        for (uint64_t i = 0; i < n; i++) {
+                _cleanup_(json_variant_unrefp) JsonVariant *v = NULL;
+
+                assert_se(json_parse(doc, 0, &v, NULL, NULL) >= 0);
+        }
+        t = usec_sub_unsigned(now(CLOCK_MONOTONIC), t);
+
+        report("json-parse", n, t);
+}
+
+DEFINE_TEST_MAIN(LOG_INFO);
@@ -391,4 +391,125 @@ TEST(config_parse) {
                 test_config_parse_one(i, config_file[i]);
 }
 
+static void test_config_compile_replay_one(unsigned i, const char *s) {
+        _cleanup_(compiled_config_file_freep) CompiledConfigFile *compiled = NULL;
+        _cleanup_(unlink_tempfilep) char name[] = "/tmp/test-conf-parser.XXXXXX";
+        _cleanup_fclose_ FILE *f = NULL;
+        _cleanup_free_ char *direct = NULL, *replayed = NULL;
+        int r, k;
+
+        const ConfigTableItem direct_items[] = {
+                { "Section", "setting1",  config_parse_string,   0, &direct},
+                {}
+        };
+        const ConfigTableItem replay_items[] = {
+                { "Section", "setting1",  config_parse_string,   0, &replayed},
+                {}
+        };
+
+        log_info("== %s[%i] ==", __func__, i);
+
+        assert_se(fmkostemp_safe(name, "r+", &f) == 0);
+        assert_se(fwrite(s, strlen(s), 1, f) == 1);
+        assert_se(fflush(f) == 0);
+
+        r = config_parse(NULL, name, NULL,
+                         "Section\0"
+                         "-NoWarnSection\0",
+                         config_item_table_lookup, direct_items,
+                         CONFIG_PARSE_WARN,
+                         NULL,
+                         NULL);
+
+        /* Compiling must fail and succeed exactly where direct parsing does */
+        k = config_compile(NULL, name, NULL,
+                           "Section\0"
+                           "-NoWarnSection\0",
+                           CONFIG_PARSE_WARN,
+                           &compiled);
+        assert_se(k == r);
+        if (k <= 0) {
+                assert_se(!compiled);
+                return;
+        }
+
+        /* Replaying works off the pre-lexed data only, hence removing the file underneath it must not
+         * matter. */
+        assert_se(unlink(name) == 0);
+
+        assert_se(config_replay(compiled, NULL,
+                                config_item_table_lookup, replay_items,
+                                CONFIG_PARSE_WARN,
+                                NULL) == 1);
+
+        assert_se(streq_ptr(direct, replayed));
+}
+
+TEST(config_compile_replay) {
+        for (unsigned i = 0; i < ELEMENTSOF(config_file); i++)
+                test_config_compile_replay_one(i, config_file[i]);
+}
+
+TEST(config_parse_exotic_eol) {
+        /* All of read_line()'s end-of-line markers, in one file: CRLF, LFCR, lone CR, and NUL directly
+         * following a line break. Both the direct path and compile+replay must agree on the result. */
+        static const char contents[] =
+                "[Section]\r\n"
+                "setting1=1\\\r\n"
+                "2\r\n"
+                "\0"
+                "setting2=a\n\r"
+                "setting3=b\r"
+                "setting4=c";
+
+        _cleanup_(compiled_config_file_freep) CompiledConfigFile *compiled = NULL;
+        _cleanup_(unlink_tempfilep) char name[] = "/tmp/test-conf-parser.XXXXXX";
+        _cleanup_fclose_ FILE *f = NULL;
+        _cleanup_free_ char *setting1 = NULL, *setting2 = NULL, *setting3 = NULL, *setting4 = NULL;
+
+        const ConfigTableItem direct_items[] = {
+                { "Section", "setting1",  config_parse_string,   0, &setting1},
+                { "Section", "setting2",  config_parse_string,   0, &setting2},
+                { "Section", "setting3",  config_parse_string,   0, &setting3},
+                { "Section", "setting4",  config_parse_string,   0, &setting4},
+                {}
+        };
+
+        assert_se(fmkostemp_safe(name, "r+", &f) == 0);
+        assert_se(fwrite(contents, sizeof(contents) - 1, 1, f) == 1);
+        assert_se(fflush(f) == 0);
+
+        assert_se(config_parse(NULL, name, NULL,
+                               "Section\0",
+                               config_item_table_lookup, direct_items,
+                               CONFIG_PARSE_WARN,
+                               NULL,
+                               NULL) == 1);
+
+        assert_se(streq_ptr(setting1, "1 2"));
+        assert_se(streq_ptr(setting2, "a"));
+        assert_se(streq_ptr(setting3, "b"));
+        assert_se(streq_ptr(setting4, "c"));
+
+        assert_se(config_compile(NULL, name, NULL,
+                                 "Section\0",
+                                 CONFIG_PARSE_WARN,
+                                 &compiled) == 1);
+
+        setting1 = mfree(setting1);
+        setting2 = mfree(setting2);
+        setting3 = mfree(setting3);
+        setting4 = mfree(setting4);
+
+        assert_se(config_replay(compiled, NULL,
+                                config_item_table_lookup, direct_items,
+                                CONFIG_PARSE_WARN,
+                                NULL) == 1);
+
+        assert_se(streq_ptr(setting1, "1 2"));
+        assert_se(streq_ptr(setting2, "a"));
+        assert_se(streq_ptr(setting3, "b"));
+        assert_se(streq_ptr(setting4, "c"));
+}
+
 DEFINE_TEST_MAIN(LOG_INFO);
@@ -0,0 +1,92 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "string-intern.h"
+#include "string-util.h"
+#include "tests.h"
+
+TEST(string_intern) {
+        const char *a, *b, *c;
+
+        assert_se(string_intern(NULL) == NULL);
+        assert_se(string_intern_ref(NULL) == NULL);
+        assert_se(string_intern_unref(NULL) == NULL);
+
+        assert_se(string_intern_pool_size() == 0);
+
+        a = string_intern("foobar");
+        assert_se(a);
+        assert_se(streq(a, "foobar"));
+        assert_se(string_intern_pool_size() == 1);
+
+        /* Interning an equal string yields the very same pointer */
+        b = string_intern("foobar");
+        assert_se(b == a);
+        assert_se(string_intern_pool_size() == 1);
+
+        c = string_intern("waldo");
+        assert_se(c);
+        assert_se(c != a);
+        assert_se(streq(c, "waldo"));
+        assert_se(string_intern_pool_size() == 2);
+
+        /* Dropping one of two refs keeps the entry alive */
+        assert_se(string_intern_unref(b) == NULL);
+        assert_se(string_intern_pool_size() == 2);
+        assert_se(streq(a, "foobar"));
+
+        /* Extra refs can be taken via the pointer itself */
+        assert_se(string_intern_ref(a) == a);
+        assert_se(string_intern_unref(a) == NULL);
+
+        /* Dropping the last ref removes the entry */
+        assert_se(string_intern_unref(a) == NULL);
+        assert_se(string_intern_pool_size() == 1);
+
+        /* ... and re-interning it afterwards allocates it anew */
+        a = string_intern("foobar");
+        assert_se(a);
+        assert_se(streq(a, "foobar"));
+        assert_se(string_intern_pool_size() == 2);
+
+        /* The empty string is a valid pool entry, distinct from NULL */
+        b = string_intern("");
+        assert_se(b);
+        assert_se(isempty(b));
+        assert_se(string_intern_pool_size() == 3);
+        assert_se(string_intern("") == b);
+        assert_se(string_intern_unref(b) == NULL);
+        assert_se(string_intern_unref(b) == NULL);
+        assert_se(string_intern_pool_size() == 2);
+
+        assert_se(string_intern_unref(a) == NULL);
+        assert_se(string_intern_unref(c) == NULL);
+        assert_se(string_intern_pool_size() == 0);
+}
+
+TEST(string_intern_update) {
+        const char *p = NULL;
+
+        /* NULL → NULL is a NOP */
+        assert_se(string_intern_update(&p, NULL) == 0);
+        assert_se(p == NULL);
+
+        assert_se(string_intern_update(&p, "quux") == 1);
+        assert_se(streq(p, "quux"));
+        assert_se(string_intern_pool_size() == 1);
+
+        /* Updating to an equal string changes nothing */
+        assert_se(string_intern_update(&p, "quux") == 0);
+        assert_se(streq(p, "quux"));
+        assert_se(string_intern_pool_size() == 1);
+
+        /* Updating to a different string drops the old ref */
+        assert_se(string_intern_update(&p, "piff") == 1);
+        assert_se(streq(p, "piff"));
+        assert_se(string_intern_pool_size() == 1);
+
+        assert_se(string_intern_update(&p, NULL) == 1);
+        assert_se(p == NULL);
+        assert_se(string_intern_pool_size() == 0);
+}
+
+DEFINE_TEST_MAIN(LOG_INFO);
@@ -106,11 +106,17 @@ TEST(unit_name_replace_instance) {
 
 static void test_unit_name_from_path_one(const char *path, const char *suffix, const char *expected, int ret) {
         _cleanup_free_ char *t = NULL;
+        char buf[UNIT_NAME_MAX];
 
         assert_se(unit_name_from_path(path, suffix, &t) == ret);
         puts(strna(t));
         assert_se(streq_ptr(t, expected));
 
+        /* The allocation-free variant must agree */
+        assert_se(unit_name_from_path_buf(path, suffix, buf, sizeof(buf)) == ret);
+        if (ret >= 0)
+                assert_se(streq(buf, expected));
+
         if (t) {
                 _cleanup_free_ char *k = NULL;
                 assert_se(unit_name_to_path(t, &k) == 0);
@@ -129,6 +135,10 @@ TEST(unit_name_from_path) {
         test_unit_name_from_path_one("/foo/../bar", ".mount", NULL, -EINVAL);
         test_unit_name_from_path_one("/foo/./bar", ".mount", "foo-bar.mount", 0);
         test_unit_name_from_path_one("/waldoaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", ".mount", NULL, -ENAMETOOLONG);
+
+        /* A too small caller buffer is reported as -ENAMETOOLONG, too */
+        char small[8];
+        assert_se(unit_name_from_path_buf("/waldo/quuix", ".mount", small, sizeof(small)) == -ENAMETOOLONG);
 }
 
 static void test_unit_name_from_path_instance_one(const char *pattern, const char *path, const char *suffix, const char *expected, int ret) {
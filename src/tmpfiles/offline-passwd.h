@@ -5,5 +5,7 @@
 
 #include "hashmap.h"
 
+extern const struct hash_ops uid_gid_hash_ops;
+
 int name_to_uid_offline(const char *root, const char *user, uid_t *ret_uid, Hashmap **cache);
 int name_to_gid_offline(const char *root, const char *group, gid_t *ret_gid, Hashmap **cache);
@@ -192,10 +192,12 @@ static char *arg_replace = NULL;
 
 static OrderedHashmap *items = NULL, *globs = NULL;
 static Set *unix_sockets = NULL;
+static Hashmap *parents_cache = NULL;
 
 STATIC_DESTRUCTOR_REGISTER(items, ordered_hashmap_freep);
 STATIC_DESTRUCTOR_REGISTER(globs, ordered_hashmap_freep);
 STATIC_DESTRUCTOR_REGISTER(unix_sockets, set_freep);
+STATIC_DESTRUCTOR_REGISTER(parents_cache, hashmap_freep);
 STATIC_DESTRUCTOR_REGISTER(arg_include_prefixes, freep);
 STATIC_DESTRUCTOR_REGISTER(arg_exclude_prefixes, freep);
 STATIC_DESTRUCTOR_REGISTER(arg_root, freep);
@@ -951,9 +953,22 @@ shortcut:
         return label_fix(path, 0);
 }
 
+static void parent_fd_destroy(void *p) {
+        safe_close(PTR_TO_INT(p) - 1);
+}
+
+DEFINE_HASH_OPS_FULL(parents_cache_hash_ops,
+                     char, path_hash_func, path_compare, free,
+                     void, parent_fd_destroy);
+
+static void parents_cache_invalidate(void) {
+        parents_cache = hashmap_free(parents_cache);
+}
+
 static int path_open_parent_safe(const char *path) {
         _cleanup_free_ char *dn = NULL;
         int r, fd;
+        void *v;
 
         if (path_equal(path, "/") || !path_is_normalized(path))
                 return log_error_errno(SYNTHETIC_ERRNO(EINVAL),
@@ -964,11 +979,36 @@ static int path_open_parent_safe(const char *path) {
         if (!dn)
                 return log_oom();
 
+        /* Long item lists tend to put many entries into the same few directories, and chasing the same
+         * parent from the root over and over again dominates the syscall profile then. Hand out a dup of
+         * the fd we already chased for this parent, unless an item has removed or replaced something in
+         * the meantime, which flushes the cache (see parents_cache_invalidate()). */
+        v = hashmap_get(parents_cache, dn);
+        if (v) {
+                fd = fcntl(PTR_TO_INT(v) - 1, F_DUPFD_CLOEXEC, 3);
+                if (fd < 0)
+                        return log_error_errno(errno, "Failed to duplicate parent directory fd of '%s': %m", path);
+
+                return fd;
+        }
+
         r = chase_symlinks(dn, arg_root, CHASE_SAFE|CHASE_WARN, NULL, &fd);
         if (r < 0 && r != -ENOLINK)
                 return log_error_errno(r, "Failed to validate path %s: %m", path);
+        if (r < 0)
+                return r;
 
-        return r < 0 ? r : fd;
+        /* Stash a copy away for the next item; failing to do so is not a problem, the fd we return
+         * belongs to the caller either way. */
+        int copy = fcntl(fd, F_DUPFD_CLOEXEC, 3);
+        if (copy >= 0) {
+                if (hashmap_ensure_put(&parents_cache, &parents_cache_hash_ops, dn, INT_TO_PTR(copy + 1)) < 0)
+                        safe_close(copy);
+                else
+                        TAKE_PTR(dn);
+        }
+
+        return fd;
 }
 
 static int path_open_safe(const char *path) {
@@ -2198,6 +2238,11 @@ static int create_item(Item *i) {
 
         log_debug("Running create action for entry %c %s", (char) i->type, i->path);
 
+        /* These replace existing nodes of a different type when forced, which may change what previously
+         * resolved parent directory fds refer to, hence stop reusing them. */
+        if (i->append_or_force && IN_SET(i->type, CREATE_SYMLINK, CREATE_FIFO, CREATE_BLOCK_DEVICE, CREATE_CHAR_DEVICE, COPY_FILES))
+                parents_cache_invalidate();
+
         switch (i->type) {
 
         case IGNORE_PATH:
@@ -2435,6 +2480,10 @@ static int remove_item(Item *i) {
 
         log_debug("Running remove action for entry %c %s", (char) i->type, i->path);
 
+        /* Whatever we delete here might be (or contain) a directory we handed out an fd for, don't reuse
+         * those afterwards. */
+        parents_cache_invalidate();
+
         switch (i->type) {
 
         case TRUNCATE_DIRECTORY:
@@ -2549,6 +2598,9 @@ static int clean_item(Item *i) {
 
         log_debug("Running clean action for entry %c %s", (char) i->type, i->path);
 
+        /* Aging may remove empty directories, don't keep reusing fds of those. */
+        parents_cache_invalidate();
+
         switch (i->type) {
         case CREATE_DIRECTORY:
         case CREATE_SUBVOLUME:
@@ -2837,9 +2889,32 @@ static int find_uid(const char *user, uid_t *ret_uid, Hashmap **cache) {
         if (r >= 0)
                 return r;
 
-        /* Second: pass to NSS if we are running "online" */
-        if (!arg_root)
-                return get_user_creds(&user, ret_uid, NULL, NULL, NULL, 0);
+        /* Second: pass to NSS if we are running "online". Cache the answers in the same cache the offline
+         * path uses — item lists repeat the same few names a lot, and every miss potentially means a full
+         * NSS round trip to a remote directory service. */
+        if (!arg_root) {
+                _cleanup_free_ char *n = NULL;
+                void *found;
+
+                found = hashmap_get(*cache, user);
+                if (found) {
+                        *ret_uid = PTR_TO_UID(found);
+                        return 0;
+                }
+
+                n = strdup(user);
+                if (!n)
+                        return log_oom();
+
+                r = get_user_creds(&user, ret_uid, NULL, NULL, NULL, 0);
+                if (r < 0)
+                        return r;
+
+                if (hashmap_ensure_put(cache, &uid_gid_hash_ops, n, UID_TO_PTR(*ret_uid)) >= 0)
+                        TAKE_PTR(n);
+
+                return 0;
+        }
 
         /* Third, synthesize "root" unconditionally */
         if (streq(user, "root")) {
@@ -2862,9 +2937,30 @@ static int find_gid(const char *group, gid_t *ret_gid, Hashmap **cache) {
         if (r >= 0)
                 return r;
 
-        /* Second: pass to NSS if we are running "online" */
-        if (!arg_root)
-                return get_group_creds(&group, ret_gid, 0);
+        /* Second: pass to NSS if we are running "online", with the same caching as in find_uid() */
+        if (!arg_root) {
+                _cleanup_free_ char *n = NULL;
+                void *found;
+
+                found = hashmap_get(*cache, group);
+                if (found) {
+                        *ret_gid = PTR_TO_GID(found);
+                        return 0;
+                }
+
+                n = strdup(group);
+                if (!n)
+                        return log_oom();
+
+                r = get_group_creds(&group, ret_gid, 0);
+                if (r < 0)
+                        return r;
+
+                if (hashmap_ensure_put(cache, &uid_gid_hash_ops, n, GID_TO_PTR(*ret_gid)) >= 0)
+                        TAKE_PTR(n);
+
+                return 0;
+        }
 
         /* Third, synthesize "root" unconditionally */
         if (streq(group, "root")) {
@@ -3505,8 +3601,14 @@ static int parse_argv(int argc, char *argv[]) {
         return 1;
 }
 
-static int read_config_file(char **config_dirs, const char *fn, bool ignore_enoent, bool *invalid_config) {
-        _cleanup_(hashmap_freep) Hashmap *uid_cache = NULL, *gid_cache = NULL;
+static int read_config_file(
+                char **config_dirs,
+                const char *fn,
+                bool ignore_enoent,
+                bool *invalid_config,
+                Hashmap **uid_cache,
+                Hashmap **gid_cache) {
+
         _cleanup_fclose_ FILE *_f = NULL;
         _cleanup_free_ char *pp = NULL;
         unsigned v = 0;
@@ -3554,7 +3656,7 @@ static int read_config_file(char **config_dirs, const char *fn, bool ignore_enoe
                 if (IN_SET(*l, 0, '#'))
                         continue;
 
-                k = parse_line(fn, v, l, &invalid_line, &uid_cache, &gid_cache);
+                k = parse_line(fn, v, l, &invalid_line, uid_cache, gid_cache);
                 if (k < 0) {
                         if (invalid_line)
                                 /* Allow reporting with a special code if the caller requested this */
@@ -3611,12 +3713,12 @@ static int read_config_file(char **config_dirs, const char *fn, bool ignore_enoe
         return r;
 }
 
-static int parse_arguments(char **config_dirs, char **args, bool *invalid_config) {
+static int parse_arguments(char **config_dirs, char **args, bool *invalid_config, Hashmap **uid_cache, Hashmap **gid_cache) {
         char **arg;
         int r;
 
         STRV_FOREACH(arg, args) {
-                r = read_config_file(config_dirs, *arg, false, invalid_config);
+                r = read_config_file(config_dirs, *arg, false, invalid_config, uid_cache, gid_cache);
                 if (r < 0)
                         return r;
         }
@@ -3625,6 +3727,9 @@ static int parse_arguments(char **config_dirs, char **args, bool *invalid_config
 }
 
 static int read_config_files(char **config_dirs, char **args, bool *invalid_config) {
+        /* Resolved user/group names are cached across all configuration files, they repeat a lot and each
+         * fresh lookup is potentially an NSS round trip. */
+        _cleanup_(hashmap_freep) Hashmap *uid_cache = NULL, *gid_cache = NULL;
         _cleanup_strv_free_ char **files = NULL;
         _cleanup_free_ char *p = NULL;
         char **f;
@@ -3638,13 +3743,13 @@ static int read_config_files(char **config_dirs, char **args, bool *invalid_conf
                 if (p && path_equal(*f, p)) {
                         log_debug("Parsing arguments at position \"%s\"…", *f);
 
-                        r = parse_arguments(config_dirs, args, invalid_config);
+                        r = parse_arguments(config_dirs, args, invalid_config, &uid_cache, &gid_cache);
                         if (r < 0)
                                 return r;
                 } else
                         /* Just warn, ignore result otherwise.
                          * read_config_file() has some debug output, so no need to print anything. */
-                        (void) read_config_file(config_dirs, *f, true, invalid_config);
+                        (void) read_config_file(config_dirs, *f, true, invalid_config, &uid_cache, &gid_cache);
 
         return 0;
 }
@@ -3801,8 +3906,11 @@ static int run(int argc, char *argv[]) {
          */
         if (arg_replace || optind >= argc)
                 r = read_config_files(config_dirs, argv + optind, &invalid_config);
-        else
-                r = parse_arguments(config_dirs, argv + optind, &invalid_config);
+        else {
+                _cleanup_(hashmap_freep) Hashmap *uid_cache = NULL, *gid_cache = NULL;
+
+                r = parse_arguments(config_dirs, argv + optind, &invalid_config, &uid_cache, &gid_cache);
+        }
         if (r < 0)
                 return r;
 
@@ -170,7 +170,7 @@ static int agent_ask_password_tty(
         return r;
 }
 
-static int process_one_password_file(const char *filename) {
+static int process_one_password_file(const char *filename, Set **announced) {
         _cleanup_free_ char *socket_name = NULL, *message = NULL;
         bool accept_cached = false, echo = false, silent = false;
         uint64_t not_after = 0;
@@ -218,6 +218,12 @@ static int process_one_password_file(const char *filename) {
         case ACTION_WALL: {
                  _cleanup_free_ char *wall = NULL;
 
+                 /* When multiple questions are pending, each new one wakes us up and we rescan the whole
+                  * directory. Only forward each question to wall once, otherwise n parallel questions (e.g. a
+                  * boot with many encrypted disks) generate O(n²) wall messages. */
+                 if (set_contains(*announced, filename))
+                         return 0;
+
                  if (asprintf(&wall,
                               "Password entry required for \'%s\' (PID " PID_FMT ").\r\n"
                               "Please enter password with the systemd-tty-ask-password-agent tool.",
@@ -226,6 +232,10 @@ static int process_one_password_file(const char *filename) {
                          return log_oom();
 
                  (void) utmp_wall(wall, NULL, NULL, wall_tty_match, NULL);
+
+                 if (set_put_strdup(announced, filename) < 0)
+                         return log_oom();
+
                  return 0;
         }
         case ACTION_QUERY:
@@ -293,10 +303,13 @@ static int wall_tty_block(void) {
         return fd;
 }
 
-static int process_password_files(void) {
+static int process_password_files(Set **announced) {
+        _cleanup_set_free_ Set *seen = NULL;
         _cleanup_closedir_ DIR *d = NULL;
         int r = 0;
 
+        assert(announced);
+
         d = opendir("/run/systemd/ask-password");
         if (!d) {
                 if (errno == ENOENT)
@@ -322,11 +335,26 @@ static int process_password_files(void) {
                 if (!p)
                         return log_oom();
 
-                q = process_one_password_file(p);
+                if (arg_action == ACTION_WALL) {
+                        q = set_put_strdup(&seen, p);
+                        if (q < 0)
+                                return log_oom();
+                }
+
+                q = process_one_password_file(p, announced);
                 if (q < 0 && r == 0)
                         r = q;
         }
 
+        /* Forget about questions that disappeared, so that the set doesn't grow without bounds. */
+        if (arg_action == ACTION_WALL) {
+                char *name;
+
+                SET_FOREACH(name, *announced)
+                        if (!set_contains(seen, name))
+                                free(set_remove(*announced, name));
+        }
+
         return r;
 }
 
@@ -339,6 +367,7 @@ static int process_and_watch_password_files(bool watch) {
 
         _unused_ _cleanup_close_ int tty_block_fd = -1;
         _cleanup_close_ int notify = -1, signal_fd = -1;
+        _cleanup_set_free_ Set *announced = NULL;
         struct pollfd pollfd[_FD_MAX];
         sigset_t mask;
         int r;
@@ -372,7 +401,7 @@ static int process_and_watch_password_files(bool watch) {
         for (;;) {
                 usec_t timeout = USEC_INFINITY;
 
-                r = process_password_files();
+                r = process_password_files(&announced);
                 if (r < 0) {
                         if (r == -ECANCELED)
                                 /* Disable poll() timeout since at least one password has
@@ -282,6 +282,10 @@ int link_load_one(LinkConfigContext *ctx, const char *filename) {
                 return 0;
         }
 
+        r = net_match_compile(&config->match);
+        if (r < 0)
+                return r;
+
         if (IN_SET(config->mac_address_policy, MAC_ADDRESS_POLICY_PERSISTENT, MAC_ADDRESS_POLICY_RANDOM) &&
             config->hw_addr.length > 0)
                 log_warning("%s: MACAddress= in [Link] section will be ignored when MACAddressPolicy= "
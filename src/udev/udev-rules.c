@@ -22,6 +22,7 @@
 #include "parse-util.h"
 #include "path-util.h"
 #include "proc-cmdline.h"
+#include "sort-util.h"
 #include "stat-util.h"
 #include "strv.h"
 #include "strxcpyx.h"
@@ -167,6 +168,10 @@ struct UdevRuleLine {
         UdevRuleToken *current_token;
         LIST_HEAD(UdevRuleToken, tokens);
         LIST_FIELDS(UdevRuleLine, rule_lines);
+
+        /* Only accounted when stats are enabled, see udev_rules_enable_stats() */
+        usec_t elapsed;
+        uint64_t n_applied;
 };
 
 struct UdevRuleFile {
@@ -174,6 +179,10 @@ struct UdevRuleFile {
         UdevRuleLine *current_line;
         LIST_HEAD(UdevRuleLine, rule_lines);
         LIST_FIELDS(UdevRuleFile, rule_files);
+
+        /* Only accounted when stats are enabled, see udev_rules_enable_stats() */
+        usec_t elapsed;
+        uint64_t n_applied;
 };
 
 struct UdevRules {
@@ -183,6 +192,7 @@ struct UdevRules {
         Hashmap *known_groups;
         UdevRuleFile *current_file;
         LIST_HEAD(UdevRuleFile, rule_files);
+        bool stats_enabled;
 };
 
 /*** Logging helpers ***/
@@ -2535,7 +2545,19 @@ int udev_rules_apply_to_event(
         LIST_FOREACH(rule_files, file, rules->rule_files) {
                 rules->current_file = file;
                 LIST_FOREACH_SAFE(rule_lines, file->current_line, next_line, file->rule_lines) {
-                        r = udev_rule_apply_line_to_event(rules, event, timeout_usec, timeout_signal, properties_list, &next_line);
+                        if (rules->stats_enabled) {
+                                UdevRuleLine *line = file->current_line;
+                                usec_t ts = now(CLOCK_MONOTONIC);
+
+                                r = udev_rule_apply_line_to_event(rules, event, timeout_usec, timeout_signal, properties_list, &next_line);
+
+                                ts = usec_sub_unsigned(now(CLOCK_MONOTONIC), ts);
+                                line->elapsed += ts;
+                                line->n_applied++;
+                                file->elapsed += ts;
+                                file->n_applied++;
+                        } else
+                                r = udev_rule_apply_line_to_event(rules, event, timeout_usec, timeout_signal, properties_list, &next_line);
                         if (r < 0)
                                 return r;
                 }
@@ -2544,6 +2566,68 @@ int udev_rules_apply_to_event(
         return 0;
 }
 
+void udev_rules_enable_stats(UdevRules *rules) {
+        assert(rules);
+
+        /* Makes udev_rules_apply_to_event() accumulate wall clock time spent per rule line and per rule
+         * file, for "udevadm test --rule-stats". Off by default, so that the hot path in the daemon does
+         * not pay for two clock queries per rule line. */
+
+        rules->stats_enabled = true;
+}
+
+static int rule_file_elapsed_compare(UdevRuleFile * const *a, UdevRuleFile * const *b) {
+        return CMP((*b)->elapsed, (*a)->elapsed);
+}
+
+static int rule_line_elapsed_compare(UdevRuleLine * const *a, UdevRuleLine * const *b) {
+        return CMP((*b)->elapsed, (*a)->elapsed);
+}
+
+int udev_rules_dump_stats(UdevRules *rules, unsigned top_n) {
+        _cleanup_free_ UdevRuleFile **files = NULL;
+        _cleanup_free_ UdevRuleLine **lines = NULL;
+        size_t n_files = 0, n_lines = 0;
+        UdevRuleFile *file;
+        UdevRuleLine *line;
+
+        assert(rules);
+
+        LIST_FOREACH(rule_files, file, rules->rule_files) {
+                if (!GREEDY_REALLOC(files, n_files + 1))
+                        return log_oom();
+                files[n_files++] = file;
+
+                LIST_FOREACH(rule_lines, line, file->rule_lines) {
+                        if (line->n_applied == 0)
+                                continue;
+                        if (!GREEDY_REALLOC(lines, n_lines + 1))
+                                return log_oom();
+                        lines[n_lines++] = line;
+                }
+        }
+
+        typesafe_qsort(files, n_files, rule_file_elapsed_compare);
+        typesafe_qsort(lines, n_lines, rule_line_elapsed_compare);
+
+        printf("\nTime spent per rule file (time, lines applied, file):\n");
+        for (size_t i = 0; i < n_files; i++)
+                printf("%14s %10" PRIu64 "  %s\n",
+                       FORMAT_TIMESPAN(files[i]->elapsed, 1),
+                       files[i]->n_applied,
+                       files[i]->filename);
+
+        printf("\nMost expensive rule lines (time, times applied, location):\n");
+        for (size_t i = 0; i < MIN((size_t) top_n, n_lines); i++)
+                printf("%14s %10" PRIu64 "  %s:%u\n",
+                       FORMAT_TIMESPAN(lines[i]->elapsed, 1),
+                       lines[i]->n_applied,
+                       lines[i]->rule_file->filename,
+                       lines[i]->line_number);
+
+        return 0;
+}
+
 static int apply_static_dev_perms(const char *devnode, uid_t uid, gid_t gid, mode_t mode, char **tags) {
         char device_node[UDEV_PATH_SIZE], tags_dir[UDEV_PATH_SIZE], tag_symlink[UDEV_PATH_SIZE];
         _cleanup_free_ char *unescaped_filename = NULL;
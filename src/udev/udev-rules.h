@@ -22,6 +22,9 @@ int udev_rules_load(UdevRules **ret_rules, ResolveNameTiming resolve_name_timing
 UdevRules *udev_rules_free(UdevRules *rules);
 DEFINE_TRIVIAL_CLEANUP_FUNC(UdevRules*, udev_rules_free);
 
+void udev_rules_enable_stats(UdevRules *rules);
+int udev_rules_dump_stats(UdevRules *rules, unsigned top_n);
+
 bool udev_rules_check_timestamp(UdevRules *rules);
 int udev_rules_apply_to_event(UdevRules *rules, UdevEvent *event,
                               usec_t timeout_usec,
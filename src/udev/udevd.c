@@ -129,6 +129,16 @@ typedef struct Event {
         uint64_t seqnum;
         uint64_t blocker_seqnum;
 
+        /* Cached at queueing time, so that the blocked-by scan does not need to query the device object
+         * again for every pairwise comparison. The strings point into 'dev' and stay valid as long as we
+         * keep the reference. */
+        const char *devpath;
+        size_t devpath_len;
+        const char *devpath_old;
+        dev_t devnum;
+        int ifindex;
+        bool is_block;
+
         sd_event_source *timeout_warning_event;
         sd_event_source *timeout_event;
 
@@ -328,9 +338,20 @@ static void notify_ready(void) {
 }
 
 /* reload requested, HUP signal received, rules changed, builtin changed */
-static void manager_reload(Manager *manager) {
+static void manager_reload(Manager *manager, bool force) {
         assert(manager);
 
+        /* Unless we know the configuration changed (or the caller insists), check whether the rules or the
+         * builtin databases were actually modified on disk. Explicit reload requests often follow package
+         * or configuration transactions that didn't touch udev at all, and re-tokenizing a hundred rules
+         * files plus killing all workers for that is wasted work. */
+        if (!force &&
+            !udev_rules_check_timestamp(manager->rules) &&
+            !udev_builtin_validate()) {
+                log_debug("Reload requested, but no rules or builtin changes detected, skipping.");
+                return;
+        }
+
         sd_notify(false,
                   "RELOADING=1\n"
                   "STATUS=Flushing configuration...");
@@ -778,12 +799,7 @@ static int event_run(Event *event) {
 }
 
 static int event_is_blocked(Event *event) {
-        const char *subsystem, *devpath, *devpath_old = NULL;
-        dev_t devnum = makedev(0, 0);
         Event *loop_event;
-        size_t devpath_len;
-        int r, ifindex = 0;
-        bool is_block;
 
         /* lookup event for identical, parent, child device */
 
@@ -816,87 +832,45 @@ static int event_is_blocked(Event *event) {
         assert(loop_event->seqnum > event->blocker_seqnum &&
                loop_event->seqnum < event->seqnum);
 
-        r = sd_device_get_subsystem(event->dev, &subsystem);
-        if (r < 0)
-                return r;
-
-        is_block = streq(subsystem, "block");
-
-        r = sd_device_get_devpath(event->dev, &devpath);
-        if (r < 0)
-                return r;
-
-        devpath_len = strlen(devpath);
-
-        r = sd_device_get_property_value(event->dev, "DEVPATH_OLD", &devpath_old);
-        if (r < 0 && r != -ENOENT)
-                return r;
-
-        r = sd_device_get_devnum(event->dev, &devnum);
-        if (r < 0 && r != -ENOENT)
-                return r;
-
-        r = sd_device_get_ifindex(event->dev, &ifindex);
-        if (r < 0 && r != -ENOENT)
-                return r;
-
         /* check if queue contains events we depend on */
         LIST_FOREACH(event, loop_event, loop_event) {
-                size_t loop_devpath_len, common;
-                const char *loop_devpath;
+                size_t common;
 
                 /* found ourself, no later event can block us */
                 if (loop_event->seqnum >= event->seqnum)
                         goto no_blocker;
 
                 /* check major/minor */
-                if (major(devnum) != 0) {
-                        const char *s;
-                        dev_t d;
-
-                        if (sd_device_get_subsystem(loop_event->dev, &s) < 0)
-                                continue;
-
-                        if (sd_device_get_devnum(loop_event->dev, &d) >= 0 &&
-                            devnum == d && is_block == streq(s, "block"))
-                                break;
-                }
+                if (major(event->devnum) != 0 &&
+                    event->devnum == loop_event->devnum &&
+                    event->is_block == loop_event->is_block)
+                        break;
 
                 /* check network device ifindex */
-                if (ifindex > 0) {
-                        int i;
-
-                        if (sd_device_get_ifindex(loop_event->dev, &i) >= 0 &&
-                            ifindex == i)
-                                break;
-                }
-
-                if (sd_device_get_devpath(loop_event->dev, &loop_devpath) < 0)
-                        continue;
+                if (event->ifindex > 0 && event->ifindex == loop_event->ifindex)
+                        break;
 
                 /* check our old name */
-                if (devpath_old && streq(devpath_old, loop_devpath))
+                if (event->devpath_old && streq(event->devpath_old, loop_event->devpath))
                         break;
 
-                loop_devpath_len = strlen(loop_devpath);
-
                 /* compare devpath */
-                common = MIN(devpath_len, loop_devpath_len);
+                common = MIN(event->devpath_len, loop_event->devpath_len);
 
                 /* one devpath is contained in the other? */
-                if (!strneq(devpath, loop_devpath, common))
+                if (!strneq(event->devpath, loop_event->devpath, common))
                         continue;
 
                 /* identical device event found */
-                if (devpath_len == loop_devpath_len)
+                if (event->devpath_len == loop_event->devpath_len)
                         break;
 
                 /* parent device event found */
-                if (devpath[common] == '/')
+                if (event->devpath[common] == '/')
                         break;
 
                 /* child device event found */
-                if (loop_devpath[common] == '/')
+                if (loop_event->devpath[common] == '/')
                         break;
         }
 
@@ -930,7 +904,7 @@ static int event_queue_start(Manager *manager) {
             usec > usec_add(manager->last_usec, 3 * USEC_PER_SEC)) {
                 if (udev_rules_check_timestamp(manager->rules) ||
                     udev_builtin_validate())
-                        manager_reload(manager);
+                        manager_reload(manager, /* force = */ true);
 
                 manager->last_usec = usec;
         }
@@ -978,10 +952,12 @@ static int event_queue_start(Manager *manager) {
 }
 
 static int event_queue_insert(Manager *manager, sd_device *dev) {
+        const char *subsystem, *devpath, *devpath_old = NULL;
         _cleanup_(sd_device_unrefp) sd_device *clone = NULL;
-        Event *event;
+        dev_t devnum = makedev(0, 0);
+        int r, ifindex = 0;
         uint64_t seqnum;
-        int r;
+        Event *event;
 
         assert(manager);
         assert(dev);
@@ -994,6 +970,28 @@ static int event_queue_insert(Manager *manager, sd_device *dev) {
         if (r < 0)
                 return r;
 
+        /* Gather everything the blocked-by scan in event_is_blocked() needs, so that it doesn't have to
+         * query the device object again for every pairwise comparison. */
+        r = sd_device_get_subsystem(dev, &subsystem);
+        if (r < 0)
+                return r;
+
+        r = sd_device_get_devpath(dev, &devpath);
+        if (r < 0)
+                return r;
+
+        r = sd_device_get_property_value(dev, "DEVPATH_OLD", &devpath_old);
+        if (r < 0 && r != -ENOENT)
+                return r;
+
+        r = sd_device_get_devnum(dev, &devnum);
+        if (r < 0 && r != -ENOENT)
+                return r;
+
+        r = sd_device_get_ifindex(dev, &ifindex);
+        if (r < 0 && r != -ENOENT)
+                return r;
+
         /* Save original device to restore the state on failures. */
         r = device_shallow_clone(dev, &clone);
         if (r < 0)
@@ -1012,6 +1010,12 @@ static int event_queue_insert(Manager *manager, sd_device *dev) {
                 .dev = sd_device_ref(dev),
                 .dev_kernel = TAKE_PTR(clone),
                 .seqnum = seqnum,
+                .devpath = devpath,
+                .devpath_len = strlen(devpath),
+                .devpath_old = devpath_old,
+                .devnum = devnum,
+                .ifindex = ifindex,
+                .is_block = streq(subsystem, "block"),
                 .state = EVENT_QUEUED,
         };
 
@@ -1143,7 +1147,7 @@ static int on_ctrl_msg(UdevCtrl *uctrl, UdevCtrlMessageType type, const UdevCtrl
                 break;
         case UDEV_CTRL_RELOAD:
                 log_debug("Received udev control message (RELOAD)");
-                manager_reload(manager);
+                manager_reload(manager, /* force = */ false);
                 break;
         case UDEV_CTRL_SET_ENV: {
                 _unused_ _cleanup_free_ char *old_val = NULL;
@@ -1400,7 +1404,7 @@ static int on_sighup(sd_event_source *s, const struct signalfd_siginfo *si, void
 
         assert(manager);
 
-        manager_reload(manager);
+        manager_reload(manager, /* force = */ false);
 
         return 1;
 }
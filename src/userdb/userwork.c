@@ -424,7 +424,7 @@ static int vl_method_get_memberships(Varlink *link, JsonVariant *parameters, Var
                                               JSON_BUILD_PAIR("groupName", JSON_BUILD_STRING(last_group_name))));
 }
 
-static int process_connection(VarlinkServer *server, int fd) {
+static int process_connection(VarlinkServer *server, int listen_fd, int fd) {
         _cleanup_(varlink_close_unrefp) Varlink *vl = NULL;
         int r;
 
@@ -437,6 +437,8 @@ static int process_connection(VarlinkServer *server, int fd) {
         vl = varlink_ref(vl);
 
         for (;;) {
+                usec_t timeout = CONNECTION_IDLE_USEC;
+
                 r = varlink_process(vl);
                 if (r == -ENOTCONN) {
                         log_debug("Connection terminated.");
@@ -447,7 +449,16 @@ static int process_connection(VarlinkServer *server, int fd) {
                 if (r > 0)
                         continue;
 
-                r = varlink_wait(vl, CONNECTION_IDLE_USEC);
+                /* If other clients are already queuing up on the listening socket, don't sit on this idle
+                 * connection for the full timeout while their queries wait: give the client a brief moment
+                 * to pipeline another request, then recycle the worker for the pending connections. */
+                r = fd_wait_for_event(listen_fd, POLLIN, 0);
+                if (r < 0)
+                        log_debug_errno(r, "Failed to test for POLLIN on listening socket, ignoring: %m");
+                else if (FLAGS_SET(r, POLLIN))
+                        timeout = PRESSURE_SLEEP_TIME_USEC;
+
+                r = varlink_wait(vl, timeout);
                 if (r < 0)
                         return log_error_errno(r, "Failed to wait for connection events: %m");
                 if (r == 0)
@@ -560,7 +571,7 @@ static int run(int argc, char *argv[]) {
                         }
                 }
 
-                (void) process_connection(server, TAKE_FD(fd));
+                (void) process_connection(server, listen_fd, TAKE_FD(fd));
                 last_busy_usec = USEC_INFINITY;
         }
 